@@ -0,0 +1,58 @@
+# Copyright (c) 2026 Simons Foundation
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You may obtain a copy of the License at
+#     https:#www.gnu.org/licenses/gpl-3.0.txt
+#
+# Authors: Shasta Ramachandran
+
+# Overhead of calling C++ functions on small Green functions from Python.
+# The work done in C++ is negligible, so that the timings measure the conversion
+# of the Green function (mesh and data) from Python to C++ and back.
+#
+# Usage: python gf_call_overhead.py [n_calls]
+
+import sys
+import timeit
+
+import numpy as np
+from triqs.gf import Gf, MeshProduct, density, make_gf_dlr, make_gf_dlr_imtime, make_gf_from_fourier, is_gf_hermitian
+from triqs.gf.meshes import MeshImFreq, MeshDLRImTime, MeshBrZone, MeshCycLat
+from triqs.lattice import BravaisLattice, BrillouinZone
+
+n_calls = int(sys.argv[1]) if len(sys.argv) > 1 else 10000
+
+beta = 10.0
+bl = BravaisLattice(np.eye(2))
+bz = BrillouinZone(bl)
+
+g_iw = Gf(mesh=MeshImFreq(beta, 'Fermion', 4), target_shape=[1, 1])
+g_dlr_tau = Gf(mesh=MeshDLRImTime(beta, 'Fermion', 1.0, 1e-6), target_shape=[1, 1])
+g_dlr = make_gf_dlr(g_dlr_tau)
+g_k = Gf(mesh=MeshBrZone(bz, 2), target_shape=[1, 1])
+g_r = Gf(mesh=MeshCycLat(bl, 2), target_shape=[1, 1])
+g_tau_k = Gf(mesh=MeshProduct(MeshDLRImTime(beta, 'Fermion', 1.0, 1e-6), MeshBrZone(bz, 2)), target_shape=[1, 1])
+
+cases = [
+    ("density(imfreq)", lambda: density(g_iw)),
+    ("is_gf_hermitian(imfreq)", lambda: is_gf_hermitian(g_iw)),
+    ("make_gf_dlr(dlr_imtime)", lambda: make_gf_dlr(g_dlr_tau)),
+    ("make_gf_dlr_imtime(dlr)", lambda: make_gf_dlr_imtime(g_dlr)),
+    ("make_gf_from_fourier(brzone)", lambda: make_gf_from_fourier(g_k)),
+    ("make_gf_from_fourier(cyclat)", lambda: make_gf_from_fourier(g_r)),
+    ("make_gf_dlr(prod<dlr_imtime, brzone>)", lambda: make_gf_dlr(g_tau_k)),
+]
+
+print(f"{'function':<40} {'us / call':>10}")
+for name, f in cases:
+    t = min(timeit.repeat(f, number=n_calls, repeat=3))
+    print(f"{name:<40} {1e6 * t / n_calls:>10.2f}")
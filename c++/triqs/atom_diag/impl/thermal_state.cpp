@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "../thermal_state.hpp"
+#include <cmath>
+
+namespace triqs {
+  namespace atom_diag {
+
+    // Maximal number of temperatures and operators kept in the caches
+    constexpr long max_cached_weights   = 64;
+    constexpr long max_cached_operators = 256;
+
+    // -----------------------------------------------------------------
+    template <bool Complex> auto thermal_state<Complex>::weights(double beta) const -> std::shared_ptr<const weights_t> {
+      {
+        auto lock = std::lock_guard{_mutex};
+        if (auto it = _weights.find(beta); it != _weights.end()) return it->second;
+      }
+
+      auto res     = std::make_shared<weights_t>();
+      int n_blocks = _atom->n_subspaces();
+      res->w.resize(n_blocks);
+      for (int bl = 0; bl < n_blocks; ++bl) {
+        res->w[bl] = exp(-beta * _atom->get_eigensystems()[bl].eigenvalues);
+        res->z += sum(res->w[bl]);
+      }
+      for (auto &w : res->w) w /= res->z;
+
+      auto lock = std::lock_guard{_mutex};
+      if (long(_weights.size()) >= max_cached_weights) _weights.clear();
+      return _weights.emplace(beta, std::move(res)).first->second;
+    }
+
+    // -----------------------------------------------------------------
+    template <bool Complex> auto thermal_state<Complex>::density_matrix(double beta) const -> block_matrix_t {
+      auto W = weights(beta);
+      block_matrix_t dm(W->w.size());
+      for (int bl = 0; bl < long(W->w.size()); ++bl) {
+        long bl_size = W->w[bl].size();
+        dm[bl]       = typename atom_diag<Complex>::matrix_t::zeros(bl_size, bl_size);
+        for (long u = 0; u < bl_size; ++u) dm[bl](u, u) = W->w[bl](u);
+      }
+      return dm;
+    }
+
+    // -----------------------------------------------------------------
+    template <bool Complex>
+    auto thermal_state<Complex>::op_diagonal(many_body_op_t const &op, bool threaded) const -> std::shared_ptr<const op_diagonal_t> {
+      {
+        auto lock = std::lock_guard{_mutex};
+        for (auto const &[o, d] : _op_diagonals)
+          if (o == op) return d;
+      }
+
+      auto res       = std::make_shared<op_diagonal_t>();
+      res->hermitian = is_op_hermitian(op);
+      int n_blocks   = _atom->n_subspaces();
+      res->d.resize(n_blocks);
+
+#pragma omp parallel for schedule(dynamic) if (threaded)
+      for (int bl = 0; bl < n_blocks; ++bl) {
+        auto &d = res->d[bl];
+        d       = nda::zeros<scalar_t>(_atom->get_subspace_dim(bl));
+        for (auto const &x : op) {
+          auto b_m = _atom->get_matrix_element_of_monomial(x.monomial, bl);
+          if (b_m.first != bl) continue;
+          for (long u = 0; u < d.size(); ++u) d(u) += x.coef * b_m.second(u, u);
+        }
+      }
+
+      auto lock = std::lock_guard{_mutex};
+      if (long(_op_diagonals.size()) >= max_cached_operators) _op_diagonals.clear();
+      _op_diagonals.emplace_back(op, res);
+      return res;
+    }
+
+    // -----------------------------------------------------------------
+    template <bool Complex>
+    auto thermal_state<Complex>::expectation_values(std::vector<many_body_op_t> const &ops, double beta, bool threaded) const
+       -> std::vector<scalar_t> {
+      auto W       = weights(beta);
+      long n_ops   = ops.size();
+      int n_blocks = _atom->n_subspaces();
+
+      std::vector<std::shared_ptr<const op_diagonal_t>> diags(n_ops);
+      for (long i = 0; i < n_ops; ++i) diags[i] = op_diagonal(ops[i], threaded);
+
+      // Partial traces for each (operator, subspace), summed afterwards in a fixed order
+      auto partial = nda::zeros<scalar_t>(n_ops, n_blocks);
+#pragma omp parallel for schedule(dynamic) if (threaded)
+      for (int bl = 0; bl < n_blocks; ++bl) {
+        auto const &w = W->w[bl];
+        for (long i = 0; i < n_ops; ++i) {
+          auto const &d = diags[i]->d[bl];
+          scalar_t r    = 0;
+          for (long u = 0; u < w.size(); ++u) r += w(u) * d(u);
+          partial(i, bl) = r;
+        }
+      }
+
+      // As in trace_rho_op, drop the imaginary part due to the round-off in the eigenbasis for hermitian operators
+      std::vector<scalar_t> res(n_ops);
+      for (long i = 0; i < n_ops; ++i) {
+        res[i] = sum(partial(i, nda::range::all));
+        if (diags[i]->hermitian) res[i] = std::real(res[i]);
+      }
+      return res;
+    }
+
+    // -----------------------------------------------------------------
+    template <bool Complex> void thermal_state<Complex>::clear_cache() const {
+      auto lock = std::lock_guard{_mutex};
+      _weights.clear();
+      _op_diagonals.clear();
+    }
+
+    template class thermal_state<false>;
+    template class thermal_state<true>;
+
+  } // namespace atom_diag
+} // namespace triqs
@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "./atom_diag.hpp"
+
+namespace triqs {
+  namespace atom_diag {
+
+    /// Thermal averages over the eigenstates of a solved diagonalization problem
+    /**
+     * The Gibbs density matrix is diagonal in the eigenbasis, so that
+     * :math:`\langle O \rangle = \sum_{B,u} w_B(u) O_B(u,u)` only involves the Boltzmann weights
+     * and the diagonal of the blocks of :math:`O` that map an invariant subspace onto itself.
+     *
+     * The weights are cached per inverse temperature and the diagonals per operator,
+     * so that many observables at several temperatures are evaluated without recomputing
+     * exponentials or operator matrices. The caches are bounded and thread-safe.
+     *
+     * The solved problem must outlive the thermal_state.
+     *
+     * @tparam Complex Do we have a diagonalization problem with a complex-valued Hamiltonian?
+     * @include triqs/atom_diag/thermal_state.hpp
+     */
+    template <bool Complex> class thermal_state {
+      public:
+      using scalar_t       = typename atom_diag<Complex>::scalar_t;
+      using block_matrix_t = typename atom_diag<Complex>::block_matrix_t;
+      using many_body_op_t = typename atom_diag<Complex>::many_body_op_t;
+
+      /// The Boltzmann weights :math:`e^{-\beta E} / Z` for each invariant subspace, and the partition function :math:`Z`
+      struct weights_t {
+        double z = 0;
+        std::vector<nda::vector<double>> w;
+      };
+
+      /// Construct from a solved diagonalization problem
+      explicit thermal_state(atom_diag<Complex> const &atom) : _atom(&atom) {}
+
+      /// The solved diagonalization problem
+      [[nodiscard]] atom_diag<Complex> const &atom() const { return *_atom; }
+
+      /// The Boltzmann weights at inverse temperature beta (cached)
+      [[nodiscard]] std::shared_ptr<const weights_t> weights(double beta) const;
+
+      /// The partition function at inverse temperature beta
+      [[nodiscard]] double partition_function(double beta) const { return weights(beta)->z; }
+
+      /// The Gibbs density matrix at inverse temperature beta, as diagonal blocks
+      [[nodiscard]] block_matrix_t density_matrix(double beta) const;
+
+      /// The thermal average of op at inverse temperature beta. Same as trace_rho_op with the density matrix at beta.
+      [[nodiscard]] scalar_t expectation_value(many_body_op_t const &op, double beta) const {
+        return expectation_values(std::vector{op}, beta)[0];
+      }
+
+      /**
+       * The thermal averages of several operators at inverse temperature beta
+       *
+       * @param ops The operators
+       * @param beta Inverse temperature
+       * @param threaded Distribute the invariant subspaces over the threads
+       * @return The averages, real for hermitian operators
+       */
+      [[nodiscard]] std::vector<scalar_t> expectation_values(std::vector<many_body_op_t> const &ops, double beta, bool threaded = false) const;
+
+      /// Empty the caches
+      void clear_cache() const;
+
+      private:
+      // The diagonal of the blocks of an operator that map a subspace onto itself
+      struct op_diagonal_t {
+        bool hermitian = false;
+        std::vector<nda::vector<scalar_t>> d;
+      };
+
+      [[nodiscard]] std::shared_ptr<const op_diagonal_t> op_diagonal(many_body_op_t const &op, bool threaded) const;
+
+      atom_diag<Complex> const *_atom;
+      mutable std::mutex _mutex;
+      mutable std::map<double, std::shared_ptr<const weights_t>> _weights;
+      mutable std::vector<std::pair<many_body_op_t, std::shared_ptr<const op_diagonal_t>>> _op_diagonals;
+    };
+
+  } // namespace atom_diag
+} // namespace triqs
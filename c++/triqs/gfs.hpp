@@ -56,6 +56,7 @@ namespace triqs::gfs {
 
 // expression template
 #include "./gfs/gf/gf_expr.hpp"
+#include "./gfs/gf/expr_program.hpp"
 
 // evaluator
 #include "./gfs/evaluator.hpp"
@@ -80,9 +81,12 @@ namespace triqs::gfs {
 #include "./gfs/functions/legendre.hpp"
 #include "./gfs/functions/density.hpp"
 #include "./gfs/functions/dlr.hpp"
+#include "./gfs/functions/dlr_dyson.hpp"
+#include "./gfs/functions/bath_fit.hpp"
 
 // fourier
 #include "./gfs/transform/fourier.hpp"
+#include "./gfs/transform/bubble.hpp"
 #include "./gfs/transform/legendre_matsubara.hpp"
 
 #include "./gfs/transform/partial_transform.hpp"
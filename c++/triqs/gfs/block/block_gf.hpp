@@ -19,6 +19,7 @@
 
 #include "./../../utility/factory.hpp"
 #include "./gf_struct.hpp"
+#include "./exec_policy.hpp"
 
 namespace triqs::gfs {
 
@@ -97,6 +98,46 @@ namespace triqs::gfs {
       return r;
     }
     inline std::vector<std::vector<std::string>> _make_block_names2(int n, int p) { return {_make_block_names1(n), _make_block_names1(p)}; }
+
+    // Apply f to each block of a block_gf or block2_gf (or view), in storage order
+    template <typename BG, typename F> void for_each_block(BG &&g, F &&f) {
+      if constexpr (std::decay_t<BG>::arity == 1) {
+        for (auto &x : g.data()) f(x);
+      } else {
+        for (auto &x : g.data())
+          for (auto &y : x) f(y);
+      }
+    }
+
+    // Total number of data elements over all blocks
+    template <typename BG> long packed_data_size(BG const &g) {
+      long size = 0;
+      for_each_block(g, [&size](auto const &x) { size += x.data().size(); });
+      return size;
+    }
+
+    // Copy the data of all blocks into one contiguous buffer, e.g. for a single MPI message
+    template <typename BG> auto pack_block_data(BG const &g) {
+      using scalar_t = typename std::decay_t<BG>::g_t::scalar_t;
+      auto buf       = nda::array<std::remove_const_t<scalar_t>, 1>(packed_data_size(g));
+      long pos       = 0;
+      for_each_block(g, [&](auto const &x) {
+        auto buf_x = nda::reshape(buf(nda::range(pos, pos + x.data().size())), x.data().shape());
+        buf_x      = x.data();
+        pos += x.data().size();
+      });
+      return buf;
+    }
+
+    // Inverse of pack_block_data. The block structure of g must match the one of the packed block Green function
+    template <typename BG, typename A> void unpack_block_data(BG &&g, A const &buf) {
+      if (buf.size() != packed_data_size(g)) TRIQS_RUNTIME_ERROR << "unpack_block_data: buffer size incompatible with the block Green function";
+      long pos = 0;
+      for_each_block(g, [&](auto &x) {
+        x.data() = nda::reshape(buf(nda::range(pos, pos + x.data().size())), x.data().shape());
+        pos += x.data().size();
+      });
+    }
   } // namespace details
 
   /// ---------------------------  implementation  ---------------------------------
@@ -173,7 +214,7 @@ namespace triqs::gfs {
 
     /// Construct from the mpi lazy class of the implementation class, cf mpi section
     // NB : type must be the same, e.g. g2(reduce(g1)) will work only if mesh, Target, Singularity are the same...
-    template <typename Tag> block_gf(mpi::lazy<Tag, block_gf_const_view<Mesh, Target>> x) : block_gf() { operator=(x); }
+    template <typename Tag> block_gf(mpi::lazy<Tag, const_view_type> x) : block_gf() { operator=(x); }
 
     /// Construct from a vector of gf
     block_gf(data_t V)
@@ -251,11 +292,14 @@ namespace triqs::gfs {
      */
     block_gf &operator=(mpi::lazy<mpi::tag::reduce, block_gf::const_view_type> l) {
 
-      _block_names = l.rhs.block_names();
-      _glist       = mpi::reduce(l.rhs.data(), l.c, l.root, l.all, l.op);
+      // All blocks are reduced in a single message through a contiguous buffer
+      auto buf = details::pack_block_data(l.rhs);
+      mpi::reduce_in_place(buf, l.c, l.root, l.all, l.op);
 
+      _block_names = l.rhs.block_names();
+      _glist       = factory<data_t>(l.rhs.data());
+      details::unpack_block_data(*this, buf);
       return *this;
-      // reduce of vector produces a new vector of gf, so it is fine here
     }
 
     /**
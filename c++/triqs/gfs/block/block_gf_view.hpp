@@ -134,12 +134,13 @@ namespace triqs::gfs {
     block_gf_view &operator=(lazy_transform_t<L, G> const &rhs)
       requires(not IsConst)
     {
+      // The blocks are computed according to the block_exec_policy
+      auto p = get_block_exec_policy();
       if constexpr (Arity == 1) {
-        for (int i = 0; i < rhs.value.size(); ++i) (*this)[i] = rhs.lambda(rhs.value[i]);
+        details::for_each_block(rhs.value.size(), p, [&](long i) { (*this)[i] = rhs.lambda(rhs.value[i]); });
       } else {
-
-        for (int i = 0; i < rhs.value.size1(); ++i)
-          for (int j = 0; j < rhs.value.size2(); ++j) (*this)(i, j) = rhs.lambda(rhs.value(i, j));
+        long n2 = rhs.value.size2();
+        details::for_each_block(rhs.value.size1() * n2, p, [&](long k) { (*this)(k / n2, k % n2) = rhs.lambda(rhs.value(k / n2, k % n2)); });
       }
       return *this;
     }
@@ -154,15 +155,10 @@ namespace triqs::gfs {
       if (l.rhs.size() != this->size())
         TRIQS_RUNTIME_ERROR << "mpi reduction of block_gf : size of RHS is incompatible with the size of the view to be assigned to";
       _block_names = l.rhs.block_names();
-      if constexpr (Arity == 1) {
-        for (int i = 0; i < size(); ++i) _glist[i] = mpi::reduce(l.rhs.data()[i], l.c, l.root, l.all, l.op);
-      } else {
-
-        for (int i = 0; i < size1(); ++i)
-          for (int j = 0; j < size2(); ++j) _glist[i][j] = mpi::reduce(l.rhs.data()[i][j], l.c, l.root, l.all, l.op);
-      }
-      // here we need to enumerate the vector, the mpi::reduce produce a vector<gf>, NOT a gf_view,
-      // we can not overload the = of vector for better API.
+      // All blocks are reduced in a single message through a contiguous buffer
+      auto buf = details::pack_block_data(l.rhs);
+      mpi::reduce_in_place(buf, l.c, l.root, l.all, l.op);
+      details::unpack_block_data(*this, buf);
       return *this;
     }
 
@@ -0,0 +1,44 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "./exec_policy.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+namespace triqs::gfs {
+
+  namespace {
+
+    block_exec_policy policy_from_env() {
+      char const *env = std::getenv("TRIQS_BLOCK_PARALLEL");
+      return (env != nullptr and std::string{env} == "1") ? block_exec_policy::parallel : block_exec_policy::sequential;
+    }
+
+    std::atomic<block_exec_policy> &current_policy() {
+      static std::atomic<block_exec_policy> p = policy_from_env();
+      return p;
+    }
+
+  } // namespace
+
+  block_exec_policy get_block_exec_policy() { return current_policy().load(); }
+
+  block_exec_policy set_block_exec_policy(block_exec_policy p) { return current_policy().exchange(p); }
+
+} // namespace triqs::gfs
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace triqs::gfs {
+
+  /// Execution policy of the functions applied block by block to a block Green function
+  enum class block_exec_policy { sequential, parallel };
+
+  /**
+   * The process-wide execution policy of map_block_gf and of the block versions of
+   * fourier, inverse, fit_tail, total_density, make_gf_dlr, ...
+   *
+   * The default is sequential, unless the environment variable TRIQS_BLOCK_PARALLEL is set to 1.
+   * In parallel mode the blocks are distributed over the OpenMP threads. Every block is computed
+   * exactly as in the sequential mode, so the results do not depend on the number of threads.
+   */
+  block_exec_policy get_block_exec_policy();
+
+  /// Set the process-wide execution policy of the block functions. Returns the previous policy.
+  block_exec_policy set_block_exec_policy(block_exec_policy p);
+
+  namespace details {
+
+    // Call f(i) for i in [0, n), distributing i over the threads for the parallel policy.
+    // Exceptions are collected, and the one of the smallest i is rethrown after all calls.
+    template <typename F> void for_each_block(long n, block_exec_policy p, F &&f) {
+      if (p == block_exec_policy::sequential or n < 2) {
+        for (long i = 0; i < n; ++i) f(i);
+        return;
+      }
+      std::vector<std::exception_ptr> errors(n);
+#pragma omp parallel for schedule(dynamic)
+      for (long i = 0; i < n; ++i) {
+        try {
+          f(i);
+        } catch (...) { errors[i] = std::current_exception(); }
+      }
+      for (auto const &e : errors)
+        if (e) std::rethrow_exception(e);
+    }
+
+    // The vector of f(i) for i in [0, n), see for_each_block
+    template <typename F> auto map_blocks(long n, block_exec_policy p, F &&f) {
+      using r_t = std::invoke_result_t<F, long>;
+      std::vector<r_t> res;
+      res.reserve(n);
+      if (p == block_exec_policy::sequential or n < 2) {
+        for (long i = 0; i < n; ++i) res.emplace_back(f(i));
+        return res;
+      }
+      std::vector<std::optional<r_t>> tmp(n);
+      for_each_block(n, p, [&](long i) { tmp[i].emplace(f(i)); });
+      for (auto &x : tmp) res.emplace_back(std::move(*x));
+      return res;
+    }
+
+  } // namespace details
+
+} // namespace triqs::gfs
@@ -18,6 +18,8 @@
 // Authors: Michel Ferrero, Olivier Parcollet, Nils Wentzell
 
 #pragma once
+#include "./exec_policy.hpp"
+#include <itertools/itertools.hpp>
 
 namespace triqs {
   namespace gfs {
@@ -30,34 +32,40 @@ namespace triqs {
     //  * a gf_view        : then map returns a block_gf_view
     //  * a gf_const_view  : then map returns a block_gf_const_view
     //  * otherwise        : then map returns a std::vector<>
+    // The blocks are computed sequentially or in parallel according to the block_exec_policy
     namespace impl {
 
-      template <typename F, typename T> auto _map(F &&f, std::vector<T> const &V) {
-        std::vector<std::invoke_result_t<F, T>> res;
-        res.reserve(V.size());
-        for (auto &x : V) res.emplace_back(f(x));
-        return res;
+      template <typename F, typename T> auto _map(F &&f, std::vector<T> const &V, block_exec_policy p) {
+        using r_t = std::invoke_result_t<F, T>;
+        return details::map_blocks(V.size(), p, [&](long i) -> r_t { return f(V[i]); });
       }
 
-      template <typename F, typename T> auto _map(F &&f, std::vector<T> &V) {
-        std::vector<std::invoke_result_t<F, T>> res;
-        res.reserve(V.size());
-        for (auto &x : V) res.emplace_back(f(x));
-        return res;
+      template <typename F, typename T> auto _map(F &&f, std::vector<T> &V, block_exec_policy p) {
+        using r_t = std::invoke_result_t<F, T>;
+        return details::map_blocks(V.size(), p, [&](long i) -> r_t { return f(V[i]); });
       }
 
-      template <typename F, typename T> auto _map(F &&f, std::vector<std::vector<T>> const &V) {
-        std::vector<std::vector<std::invoke_result_t<F, T>>> res;
-        res.reserve(V.size());
-        for (auto &x : V) res.push_back(_map(f, x));
+      // For block2 Green functions, all blocks (i, j) are distributed together
+      template <typename F, typename W> auto _map2(F &&f, W &V, block_exec_policy p) {
+        std::vector<std::pair<long, long>> ij;
+        for (long i = 0; i < long(V.size()); ++i)
+          for (long j = 0; j < long(V[i].size()); ++j) ij.emplace_back(i, j);
+
+        auto flat = details::map_blocks(ij.size(), p, [&](long k) { return f(V[ij[k].first][ij[k].second]); });
+
+        std::vector<std::vector<typename decltype(flat)::value_type>> res(V.size());
+        for (auto [k, x] : itertools::enumerate(flat)) res[ij[k].first].push_back(std::move(x));
         return res;
       }
 
-      template <typename F, typename T> auto _map(F &&f, std::vector<std::vector<T>> &V) {
-        std::vector<std::vector<std::invoke_result_t<F, T>>> res;
-        res.reserve(V.size());
-        for (auto &x : V) res.push_back(_map(f, x));
-        return res;
+      template <typename F, typename T> auto _map(F &&f, std::vector<std::vector<T>> const &V, block_exec_policy p) {
+        using r_t = std::invoke_result_t<F, T>;
+        return _map2([&](auto const &x) -> r_t { return f(x); }, V, p);
+      }
+
+      template <typename F, typename T> auto _map(F &&f, std::vector<std::vector<T>> &V, block_exec_policy p) {
+        using r_t = std::invoke_result_t<F, T>;
+        return _map2([&](auto &x) -> r_t { return f(x); }, V, p);
       }
 
       // implementation is dispatched according to R
@@ -65,41 +73,48 @@ namespace triqs {
 
       // general case
       template <typename F, typename G, typename R> struct map {
-        static auto invoke(F &&f, G &&g) { return _map(std::forward<F>(f), std::forward<G>(g).data()); }
+        static auto invoke(F &&f, G &&g, block_exec_policy p) { return _map(std::forward<F>(f), std::forward<G>(g).data(), p); }
       };
 
       // now , when R is a gf, gf_view, a gf_const_view
       template <typename F, typename G, typename... T> struct map<F, G, gf<T...>> {
-        static auto invoke(F &&f, G &&g) {
+        static auto invoke(F &&f, G &&g, block_exec_policy p) {
           if constexpr (std::remove_reference_t<G>::arity == 1)
-            return make_block_gf(g.block_names(), _map(std::forward<F>(f), std::forward<G>(g).data()));
+            return make_block_gf(g.block_names(), _map(std::forward<F>(f), std::forward<G>(g).data(), p));
           else
-            return make_block2_gf(g.block_names()[0], g.block_names()[1], _map(std::forward<F>(f), std::forward<G>(g).data()));
+            return make_block2_gf(g.block_names()[0], g.block_names()[1], _map(std::forward<F>(f), std::forward<G>(g).data(), p));
         }
       };
 
       template <typename F, typename G, typename... T> struct map<F, G, gf_view<T...>> {
-        static auto invoke(F &&f, G &&g) {
+        static auto invoke(F &&f, G &&g, block_exec_policy p) {
           if constexpr (std::remove_reference_t<G>::arity == 1)
-            return make_block_gf_view(g.block_names(), _map(std::forward<F>(f), std::forward<G>(g).data()));
+            return make_block_gf_view(g.block_names(), _map(std::forward<F>(f), std::forward<G>(g).data(), p));
           else
-            return make_block2_gf_view(g.block_names()[0], g.block_names()[1], _map(std::forward<F>(f), std::forward<G>(g).data()));
+            return make_block2_gf_view(g.block_names()[0], g.block_names()[1], _map(std::forward<F>(f), std::forward<G>(g).data(), p));
         }
       };
 
       template <typename F, typename G, typename... T> struct map<F, G, gf_const_view<T...>> {
-        static auto invoke(F &&f, G &&g) {
+        static auto invoke(F &&f, G &&g, block_exec_policy p) {
           if constexpr (std::remove_reference_t<G>::arity == 1)
-            return make_block_gf_const_view(g.block_names(), _map(std::forward<F>(f), std::forward<G>(g).data()));
+            return make_block_gf_const_view(g.block_names(), _map(std::forward<F>(f), std::forward<G>(g).data(), p));
           else
-            return make_block2_gf_const_view(g.block_names()[0], g.block_names()[1], _map(std::forward<F>(f), std::forward<G>(g).data()));
+            return make_block2_gf_const_view(g.block_names()[0], g.block_names()[1], _map(std::forward<F>(f), std::forward<G>(g).data(), p));
         }
       };
     } // namespace impl
 
-    template <typename F, typename G> auto map_block_gf(F &&f, G &&g) {
+    /**
+     * Apply f to each block of the block Green function g
+     *
+     * @param f The function to apply to each block
+     * @param g The block Green function
+     * @param p The execution policy [default: the process-wide policy, see get_block_exec_policy]
+     */
+    template <typename F, typename G> auto map_block_gf(F &&f, G &&g, block_exec_policy p = get_block_exec_policy()) {
       static_assert(is_block_gf_v<std::decay_t<G>>, "map_block_gf requires a block gf");
-      return impl::map<F, G>::invoke(std::forward<F>(f), std::forward<G>(g));
+      return impl::map<F, G>::invoke(std::forward<F>(f), std::forward<G>(g), p);
     }
 
     // the map function itself...
@@ -107,7 +122,7 @@ namespace triqs {
     auto map(F &&f, G &&g)
       requires(is_block_gf_v<std::decay_t<G>>)
     {
-      return impl::map<F, G>::invoke(std::forward<F>(f), std::forward<G>(g));
+      return impl::map<F, G>::invoke(std::forward<F>(f), std::forward<G>(g), get_block_exec_policy());
     }
   } // namespace gfs
 } // namespace triqs
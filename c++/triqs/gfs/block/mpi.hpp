@@ -19,6 +19,18 @@
 
 namespace triqs::gfs {
 
+  namespace details {
+
+    // Broadcast the data of all blocks in a single message.
+    // The block structure on the other nodes must match the one of the root.
+    template <typename BG> void mpi_broadcast_packed(BG &g, mpi::communicator c, int root) {
+      auto buf = pack_block_data(g);
+      mpi::broadcast(buf, c, root);
+      if (c.rank() != root) unpack_block_data(g, buf);
+    }
+
+  } // namespace details
+
   /**
     * Initiate (lazy) MPI Bcast
     *
@@ -35,7 +47,7 @@ namespace triqs::gfs {
   // mako ${mpidoc("Bcast")}
   template <typename V, typename T, int Arity> void mpi_broadcast(block_gf<V, T, Arity> &g, mpi::communicator c = {}, int root = 0) {
     // Shall we bcast mesh ?
-    mpi::broadcast(g.data(), c, root);
+    details::mpi_broadcast_packed(g, c, root);
   }
 
   /**
@@ -55,7 +67,7 @@ namespace triqs::gfs {
   template <typename V, typename T, int Arity, bool IsConst>
   void mpi_broadcast(block_gf_view<V, T, Arity, IsConst> &g, mpi::communicator c = {}, int root = 0) {
     // Shall we bcast mesh ?
-    mpi::broadcast(g.data(), c, root);
+    details::mpi_broadcast_packed(g, c, root);
   }
 
   /**
@@ -94,4 +106,44 @@ namespace triqs::gfs {
     return {a, c, root, all, op};
   }
 
+  /**
+    * In place MPI Reduce
+    *
+    * The data of all blocks is reduced as one contiguous buffer, i.e. with a single MPI message
+    * using MPI_IN_PLACE, without any temporary block Green function.
+    *
+    * @group MPI
+    * @param g The Green function
+    * @param c The MPI communicator (default is world)
+    * @param root The root of the reduce communication in the MPI sense.
+    * @param all Reduce to all nodes (MPI_Allreduce) if true
+    * @param op The MPI reduction operation
+    */
+  template <typename V, typename T, int Arity>
+  void mpi_reduce_in_place(block_gf<V, T, Arity> &g, mpi::communicator c = {}, int root = 0, bool all = false, MPI_Op op = MPI_SUM) {
+    auto buf = details::pack_block_data(g);
+    mpi::reduce_in_place(buf, c, root, all, op);
+    details::unpack_block_data(g, buf);
+  }
+
+  /**
+    * In place MPI Reduce
+    *
+    * The data of all blocks is reduced as one contiguous buffer, i.e. with a single MPI message
+    * using MPI_IN_PLACE, without any temporary block Green function.
+    *
+    * @group MPI
+    * @param g The Green function
+    * @param c The MPI communicator (default is world)
+    * @param root The root of the reduce communication in the MPI sense.
+    * @param all Reduce to all nodes (MPI_Allreduce) if true
+    * @param op The MPI reduction operation
+    */
+  template <typename V, typename T, int Arity>
+  void mpi_reduce_in_place(block_gf_view<V, T, Arity, false> g, mpi::communicator c = {}, int root = 0, bool all = false, MPI_Op op = MPI_SUM) {
+    auto buf = details::pack_block_data(g);
+    mpi::reduce_in_place(buf, c, root, all, op);
+    details::unpack_block_data(g, buf);
+  }
+
 } // namespace triqs::gfs
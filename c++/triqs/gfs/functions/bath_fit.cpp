@@ -0,0 +1,398 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "../../gfs.hpp"
+#include "./bath_fit.hpp"
+#include <itertools/itertools.hpp>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <random>
+
+namespace triqs::gfs {
+
+  namespace {
+
+    using dvec = std::vector<double>;
+
+    double dot(dvec const &a, dvec const &b) { return std::inner_product(a.begin(), a.end(), b.begin(), 0.0); }
+
+    struct minimize_result {
+      dvec x;
+      double f = 0;
+      long n_iter = 0;
+      bool converged = false;
+    };
+
+    /*
+     * Minimize f(x) with lo <= x <= hi by a projected L-BFGS
+     *
+     * fg(x, g) returns f(x) and sets g to its gradient. The search direction of the L-BFGS two-loop recursion is restricted
+     * to the free variables (those not held at a bound by the gradient), and the backtracking line search
+     * projects on the box. It stops when the projected gradient is below tol, or when the relative decrease
+     * of sqrt(f) in an iteration is below tol (f is the square of a norm).
+     */
+    template <typename FG> minimize_result minimize_lbfgs_b(FG &&fg, dvec x, dvec const &lo, dvec const &hi, double tol, long max_iter) {
+      constexpr int memory = 10;
+      long n               = x.size();
+      auto project         = [&](dvec &z) {
+        for (long i = 0; i < n; ++i) z[i] = std::clamp(z[i], lo[i], hi[i]);
+      };
+
+      project(x);
+      dvec g(n), g_new(n), d(n), q(n), x_new(n);
+      double f = fg(x, g);
+      std::deque<dvec> S, Y;
+      std::deque<double> rho;
+      std::vector<double> alpha(memory);
+      std::vector<bool> is_free(n);
+
+      minimize_result res;
+      for (; res.n_iter < max_iter;) {
+        double pg = 0;
+        for (long i = 0; i < n; ++i) pg = std::max(pg, std::abs(std::clamp(x[i] - g[i], lo[i], hi[i]) - x[i]));
+        if (pg <= tol) {
+          res.converged = true;
+          break;
+        }
+
+        // Two-loop recursion on the free variables
+        for (long i = 0; i < n; ++i) {
+          is_free[i] = !((x[i] <= lo[i] and g[i] > 0) or (x[i] >= hi[i] and g[i] < 0));
+          q[i]       = is_free[i] ? g[i] : 0;
+        }
+        for (long k = long(S.size()) - 1; k >= 0; --k) {
+          alpha[k] = rho[k] * dot(S[k], q);
+          for (long i = 0; i < n; ++i) q[i] -= alpha[k] * Y[k][i];
+        }
+        double gamma = S.empty() ? 1.0 : dot(S.back(), Y.back()) / dot(Y.back(), Y.back());
+        for (auto &qi : q) qi *= gamma;
+        for (long k = 0; k < long(S.size()); ++k) {
+          double beta = rho[k] * dot(Y[k], q);
+          for (long i = 0; i < n; ++i) q[i] += S[k][i] * (alpha[k] - beta);
+        }
+        for (long i = 0; i < n; ++i) d[i] = is_free[i] ? -q[i] : 0;
+
+        // Not a descent direction: restart from the steepest descent
+        double dg = dot(d, g);
+        if (dg >= 0) {
+          S.clear(), Y.clear(), rho.clear();
+          for (long i = 0; i < n; ++i) d[i] = is_free[i] ? -g[i] : 0;
+          dg = dot(d, g);
+        }
+        if (dg >= 0) {
+          res.converged = true;
+          break;
+        }
+
+        // Backtracking line search with the Armijo condition on the projected step.
+        // Without curvature information, the first step moves each variable by at most 1.
+        double step = 1, d_max = 0;
+        for (auto di : d) d_max = std::max(d_max, std::abs(di));
+        if (S.empty()) step = std::min(1.0, 1.0 / d_max);
+        double f_new = f;
+        bool found   = false;
+        for (int ls = 0; ls < 60 and !found; ++ls, step *= 0.5) {
+          for (long i = 0; i < n; ++i) x_new[i] = x[i] + step * d[i];
+          project(x_new);
+          f_new        = fg(x_new, g_new);
+          double decay = 0;
+          for (long i = 0; i < n; ++i) decay += g[i] * (x_new[i] - x[i]);
+          found = (f_new <= f + 1e-4 * decay);
+        }
+        ++res.n_iter;
+        if (!found) {
+          if (S.empty()) break; // no progress along the steepest descent
+          S.clear(), Y.clear(), rho.clear();
+          continue;
+        }
+
+        dvec s(n), y(n);
+        for (long i = 0; i < n; ++i) {
+          s[i] = x_new[i] - x[i];
+          y[i] = g_new[i] - g[i];
+        }
+        double sy = dot(s, y);
+        if (sy > 1e-10 * dot(y, y)) {
+          S.push_back(std::move(s)), Y.push_back(std::move(y)), rho.push_back(1 / sy);
+          if (long(S.size()) > memory) S.pop_front(), Y.pop_front(), rho.pop_front();
+        }
+
+        double f_old = f;
+        std::swap(x, x_new), std::swap(g, g_new), f = f_new;
+        if (std::sqrt(f_old) - std::sqrt(f) <= tol * std::max(std::sqrt(f_old), 1.0)) {
+          res.converged = true;
+          break;
+        }
+      }
+      res.x = std::move(x);
+      res.f = f;
+      return res;
+    }
+
+    //-------------------------------------------------------
+
+    /*
+     * The squared norm of the residual of the bath fit, and its analytic gradient
+     *
+     * The kernel of the bath site j at the mesh point x is S_j(x) = 1 / (i w_n - eps_j) on Matsubara frequencies,
+     * or S_j(x) = -exp(-tau eps_j) / (1 + exp(-beta eps_j)) in imaginary time. With the residual R(x) = V S(x) V^+ - Delta(x),
+     *   dF/d eps_j      = 2/N sum_x Re[conj(S_j'(x)) v_j^+ R(x) v_j]
+     *   dF/d conj(V_mj) = 1/N sum_x S_j(x) (R^+ V)_mj + conj(S_j(x)) (R V)_mj
+     * and the gradient on the real (and imaginary) parts of V is twice the real (and imaginary) part of the latter.
+     * The parameters are packed as in the Python discretize_bath: V row major (as interleaved real and imaginary parts
+     * for complex hoppings), followed by eps.
+     */
+    struct bath_residual {
+      std::vector<dcomplex> mesh_values; // i w_n or tau
+      bool is_imtime = false;
+      double beta    = 0;
+      nda::array<dcomplex, 3> delta;
+      long n_orb = 0, n_bath = 0;
+      bool complex_hoppings = false;
+
+      [[nodiscard]] long n_params() const { return (complex_hoppings ? 2 : 1) * n_orb * n_bath + n_bath; }
+
+      void kernel(long w, double eps, dcomplex &S, dcomplex &dS) const {
+        if (!is_imtime) {
+          S  = 1.0 / (mesh_values[w] - eps);
+          dS = S * S;
+        } else {
+          double tau = mesh_values[w].real();
+          double s   = (eps >= 0 ? -std::exp(-tau * eps) / (1 + std::exp(-beta * eps)) : -std::exp((beta - tau) * eps) / (std::exp(beta * eps) + 1));
+          double nF  = (eps >= 0 ? std::exp(-beta * eps) / (1 + std::exp(-beta * eps)) : 1 / (1 + std::exp(beta * eps)));
+          S          = s;
+          dS         = s * (beta * nF - tau);
+        }
+      }
+
+      [[nodiscard]] nda::matrix<dcomplex> unpack_V(dvec const &x) const {
+        auto V = nda::matrix<dcomplex>(n_orb, n_bath);
+        for (long k = 0, p = 0; k < n_orb; ++k)
+          for (long j = 0; j < n_bath; ++j, ++p) V(k, j) = complex_hoppings ? dcomplex{x[2 * p], x[2 * p + 1]} : dcomplex{x[p], 0};
+        return V;
+      }
+
+      [[nodiscard]] dvec pack(nda::matrix_const_view<dcomplex> V, nda::vector_const_view<double> eps) const {
+        auto x = dvec(n_params());
+        for (long k = 0, p = 0; k < n_orb; ++k)
+          for (long j = 0; j < n_bath; ++j, ++p) {
+            if (complex_hoppings) {
+              x[2 * p]     = V(k, j).real();
+              x[2 * p + 1] = V(k, j).imag();
+            } else
+              x[p] = V(k, j).real();
+          }
+        long offset = n_params() - n_bath;
+        for (long j = 0; j < n_bath; ++j) x[offset + j] = eps(j);
+        return x;
+      }
+
+      // Contribution of the mesh points [w_begin, w_end) to N * F, N * dF/d eps and N * dF/d conj(V)
+      double accumulate(nda::matrix_const_view<dcomplex> V, double const *eps, long w_begin, long w_end, nda::matrix<dcomplex> &gV, dvec &geps) const {
+        auto S = std::vector<dcomplex>(n_bath), dS = std::vector<dcomplex>(n_bath);
+        auto R = nda::matrix<dcomplex>(n_orb, n_orb), RV = nda::matrix<dcomplex>(n_orb, n_bath), RhV = nda::matrix<dcomplex>(n_orb, n_bath);
+        double F = 0;
+        for (long w = w_begin; w < w_end; ++w) {
+          for (long j = 0; j < n_bath; ++j) kernel(w, eps[j], S[j], dS[j]);
+          for (long k = 0; k < n_orb; ++k)
+            for (long l = 0; l < n_orb; ++l) {
+              dcomplex r = -delta(w, k, l);
+              for (long j = 0; j < n_bath; ++j) r += V(k, j) * S[j] * std::conj(V(l, j));
+              R(k, l) = r;
+              F += std::norm(r);
+            }
+          for (long m = 0; m < n_orb; ++m)
+            for (long j = 0; j < n_bath; ++j) {
+              dcomplex rv = 0, rhv = 0;
+              for (long l = 0; l < n_orb; ++l) {
+                rv += R(m, l) * V(l, j);
+                rhv += std::conj(R(l, m)) * V(l, j);
+              }
+              RV(m, j)  = rv;
+              RhV(m, j) = rhv;
+            }
+          for (long j = 0; j < n_bath; ++j) {
+            dcomplex vRv = 0;
+            for (long m = 0; m < n_orb; ++m) {
+              vRv += std::conj(V(m, j)) * RV(m, j);
+              gV(m, j) += S[j] * RhV(m, j) + std::conj(S[j]) * RV(m, j);
+            }
+            geps[j] += 2 * (std::conj(dS[j]) * vRv).real();
+          }
+        }
+        return F;
+      }
+
+      // F(x) and its gradient. The mesh is split in a fixed number of chunks, summed in order, so that the result
+      // does not depend on the number of threads
+      double operator()(dvec const &x, dvec &grad, bool threaded) const {
+        long n_w          = mesh_values.size();
+        long n_chunks     = std::min(n_w, 64l);
+        auto V            = unpack_V(x);
+        double const *eps = x.data() + n_params() - n_bath;
+
+        auto F_c    = dvec(n_chunks, 0.0);
+        auto gV_c   = std::vector<nda::matrix<dcomplex>>(n_chunks, nda::zeros<dcomplex>(n_orb, n_bath));
+        auto geps_c = std::vector<dvec>(n_chunks, dvec(n_bath, 0.0));
+
+#pragma omp parallel for schedule(static) if (threaded)
+        for (long c = 0; c < n_chunks; ++c) {
+          auto [w_begin, w_end] = itertools::chunk_range(0, n_w, n_chunks, c);
+          F_c[c]                = accumulate(V, eps, w_begin, w_end, gV_c[c], geps_c[c]);
+        }
+
+        double F = 0;
+        auto gV  = nda::matrix<dcomplex>(nda::zeros<dcomplex>(n_orb, n_bath));
+        auto ge  = dvec(n_bath, 0.0);
+        for (long c = 0; c < n_chunks; ++c) {
+          F += F_c[c];
+          gV += gV_c[c];
+          for (long j = 0; j < n_bath; ++j) ge[j] += geps_c[c][j];
+        }
+
+        grad.resize(n_params());
+        for (long k = 0, p = 0; k < n_orb; ++k)
+          for (long j = 0; j < n_bath; ++j, ++p) {
+            if (complex_hoppings) {
+              grad[2 * p]     = 2 * gV(k, j).real() / n_w;
+              grad[2 * p + 1] = 2 * gV(k, j).imag() / n_w;
+            } else
+              grad[p] = 2 * gV(k, j).real() / n_w;
+          }
+        long offset = n_params() - n_bath;
+        for (long j = 0; j < n_bath; ++j) grad[offset + j] = ge[j] / n_w;
+        return F / n_w;
+      }
+    };
+
+    template <typename M>
+    bath_residual make_bath_residual(gf_const_view<M, matrix_valued> delta, nda::matrix_const_view<dcomplex> V0, nda::vector_const_view<double> eps0,
+                                     bath_fit_params const &p) {
+      auto [n1, n2] = delta.target_shape();
+      if (n1 != n2) TRIQS_RUNTIME_ERROR << "fit_bath: the hybridization function must be a square matrix, got " << n1 << " x " << n2;
+      if (V0.extent(0) != n1 or V0.extent(1) != eps0.size())
+        TRIQS_RUNTIME_ERROR << "fit_bath: the initial hoppings must have the shape (" << n1 << ", " << eps0.size() << "), got (" << V0.extent(0) << ", "
+                            << V0.extent(1) << ")";
+      if (eps0.size() == 0) TRIQS_RUNTIME_ERROR << "fit_bath: at least one bath site is required";
+      if (p.max_iter < 0 or p.n_starts < 1) TRIQS_RUNTIME_ERROR << "fit_bath: max_iter must be non-negative and n_starts positive";
+      if (p.eps_min > p.eps_max) TRIQS_RUNTIME_ERROR << "fit_bath: the bounds of the bath energies are inverted";
+
+      bath_residual r;
+      for (auto x : delta.mesh()) r.mesh_values.push_back(dcomplex(x.value()));
+      r.is_imtime        = std::is_same_v<M, imtime>;
+      r.beta             = delta.mesh().beta();
+      r.delta            = delta.data();
+      r.n_orb            = n1;
+      r.n_bath           = eps0.size();
+      r.complex_hoppings = p.complex_hoppings;
+      return r;
+    }
+
+    //-------------------------------------------------------
+
+    template <typename M>
+    bath_fit_result fit_bath_impl(gf_const_view<M, matrix_valued> delta, nda::matrix_const_view<dcomplex> V0, nda::vector_const_view<double> eps0,
+                                  bath_fit_params const &p, bool threaded) {
+      auto residual = make_bath_residual(delta, V0, eps0, p);
+      long n_params = residual.n_params(), n_bath = residual.n_bath;
+
+      auto lo = dvec(n_params, -std::numeric_limits<double>::infinity());
+      auto hi = dvec(n_params, std::numeric_limits<double>::infinity());
+      for (long j = n_params - n_bath; j < n_params; ++j) lo[j] = p.eps_min, hi[j] = p.eps_max;
+
+      // The initial guess, and its random perturbations for the other starts
+      auto x0    = residual.pack(V0, eps0);
+      double w   = std::max(1.0, nda::max_element(nda::abs(eps0)));
+      auto start = [&](long s) {
+        auto x = x0;
+        if (s == 0) return x;
+        auto rng = std::mt19937{p.seed + uint32_t(s)};
+        auto u   = std::uniform_real_distribution<double>{-0.5, 0.5};
+        for (long i = 0; i < n_params - n_bath; ++i) x[i] *= 1 + u(rng);
+        for (long i = n_params - n_bath; i < n_params; ++i) x[i] += w * u(rng);
+        return x;
+      };
+
+      bool parallel_starts = threaded and p.n_starts > 1;
+      auto results         = std::vector<minimize_result>(p.n_starts);
+#pragma omp parallel for schedule(dynamic) if (parallel_starts)
+      for (long s = 0; s < p.n_starts; ++s) {
+        auto fg    = [&](dvec const &x, dvec &g) { return residual(x, g, threaded and !parallel_starts); };
+        results[s] = minimize_lbfgs_b(fg, start(s), lo, hi, p.tol, p.max_iter);
+      }
+
+      // The best start, the first one in case of a tie
+      auto &best = *std::min_element(results.begin(), results.end(), [](auto const &a, auto const &b) { return a.f < b.f; });
+
+      // Sort the bath sites by energy
+      auto V   = residual.unpack_V(best.x);
+      auto eps = nda::vector<double>(n_bath);
+      for (long j = 0; j < n_bath; ++j) eps(j) = best.x[n_params - n_bath + j];
+      auto order = std::vector<long>(n_bath);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](long a, long b) { return eps(a) < eps(b); });
+
+      auto res = bath_fit_result{nda::matrix<dcomplex>(residual.n_orb, n_bath), nda::vector<double>(n_bath), std::sqrt(best.f), best.n_iter, best.converged};
+      for (long j = 0; j < n_bath; ++j) {
+        res.V(nda::range::all, j) = V(nda::range::all, order[j]);
+        res.eps(j)                = eps(order[j]);
+      }
+      return res;
+    }
+
+    template <typename M>
+    std::vector<bath_fit_result> fit_bath_blocks(block_gf_const_view<M, matrix_valued> delta, std::vector<nda::matrix<dcomplex>> const &V0,
+                                                 std::vector<nda::vector<double>> const &eps0, bath_fit_params const &p) {
+      long n_blocks = delta.size();
+      if (long(V0.size()) != n_blocks or long(eps0.size()) != n_blocks)
+        TRIQS_RUNTIME_ERROR << "fit_bath: one initial guess per block is required, got " << V0.size() << " and " << eps0.size() << " for " << n_blocks
+                            << " blocks";
+
+      // The blocks are fitted according to the block_exec_policy. The threads are used inside the fits
+      // unless they already run the blocks.
+      auto policy      = get_block_exec_policy();
+      bool use_threads = (policy == block_exec_policy::sequential or n_blocks == 1);
+      return details::map_blocks(n_blocks, policy, [&](long b) { return fit_bath_impl(delta[b], V0[b], eps0[b], p, use_threads); });
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  bath_fit_result fit_bath(gf_const_view<imfreq, matrix_valued> delta, nda::matrix_const_view<dcomplex> V0, nda::vector_const_view<double> eps0,
+                           bath_fit_params const &p) {
+    return fit_bath_impl(delta, V0, eps0, p, true);
+  }
+
+  bath_fit_result fit_bath(gf_const_view<imtime, matrix_valued> delta, nda::matrix_const_view<dcomplex> V0, nda::vector_const_view<double> eps0,
+                           bath_fit_params const &p) {
+    return fit_bath_impl(delta, V0, eps0, p, true);
+  }
+
+  std::vector<bath_fit_result> fit_bath(block_gf_const_view<imfreq, matrix_valued> delta, std::vector<nda::matrix<dcomplex>> const &V0,
+                                        std::vector<nda::vector<double>> const &eps0, bath_fit_params const &p) {
+    return fit_bath_blocks(delta, V0, eps0, p);
+  }
+
+  std::vector<bath_fit_result> fit_bath(block_gf_const_view<imtime, matrix_valued> delta, std::vector<nda::matrix<dcomplex>> const &V0,
+                                        std::vector<nda::vector<double>> const &eps0, bath_fit_params const &p) {
+    return fit_bath_blocks(delta, V0, eps0, p);
+  }
+
+} // namespace triqs::gfs
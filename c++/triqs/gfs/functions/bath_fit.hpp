@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include "../gf/gf_view.hpp"
+#include "../block/block_gf.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace triqs::gfs {
+
+  //-------------------------------------------------------
+  // Discretization of a hybridization function
+  // ------------------------------------------------------
+
+  /// The parameters of the fit of a hybridization function by bath sites
+  struct bath_fit_params {
+    /// Allow complex hoppings
+    bool complex_hoppings = false;
+
+    /// Tolerance on the relative decrease of the norm, and on the projected gradient
+    double tol = 1e-15;
+
+    /// Maximum number of L-BFGS iterations of each start
+    long max_iter = 10000;
+
+    /// Number of starts: the first one is the initial guess, the others are random perturbations of it
+    long n_starts = 1;
+
+    /// Bounds of the bath energies
+    double eps_min = -std::numeric_limits<double>::infinity();
+    double eps_max = std::numeric_limits<double>::infinity();
+
+    /// Seed of the perturbations of the initial guess
+    uint32_t seed = 0;
+  };
+
+  /// The result of the fit of a hybridization function by bath sites
+  struct bath_fit_result {
+    /// The hoppings, with shape (n_orb, n_bath)
+    nda::matrix<dcomplex> V;
+
+    /// The bath energies, in increasing order
+    nda::vector<double> eps;
+
+    /// The norm of the residual $$ [\frac{1}{N} \sum_x \| \Delta^{disc}(x) - \Delta(x) \|^2]^{1/2} $$
+    double norm = 0;
+
+    /// Number of L-BFGS iterations of the best start
+    long n_iter = 0;
+
+    /// Has the best start met the tolerance before max_iter
+    bool converged = false;
+  };
+
+  /**
+   * Fit a hybridization function by a finite number of bath sites
+   *
+   *   $$ \Delta^{disc}_{kl}(i\omega_n) = \sum_j V_{kj} \frac{1}{i\omega_n - \epsilon_j} V^*_{lj} $$
+   *   $$ \Delta^{disc}_{kl}(\tau) = - \sum_j V_{kj} \frac{e^{-\tau \epsilon_j}}{1 + e^{-\beta \epsilon_j}} V^*_{lj} $$
+   *
+   * The hoppings V and energies $\epsilon$ minimize the norm of the residual over all mesh points.
+   * The minimization is an L-BFGS with the bounds on the energies, with the analytic gradient of the pole sum.
+   * With several starts, the starts run in parallel threads and the best fit is returned,
+   * otherwise the evaluation of the residual is threaded over the mesh points.
+   *
+   * @param delta The hybridization function
+   * @param V0 The initial hoppings, with shape (n_orb, n_bath)
+   * @param eps0 The initial bath energies
+   * @param p The parameters of the fit
+   * @return The fitted hoppings and energies, sorted by energy, and the norm of the residual
+   */
+  bath_fit_result fit_bath(gf_const_view<imfreq, matrix_valued> delta, nda::matrix_const_view<dcomplex> V0, nda::vector_const_view<double> eps0,
+                           bath_fit_params const &p = {});
+
+  /// Fit of a hybridization function in imaginary time, cf. fit_bath on Matsubara frequencies
+  bath_fit_result fit_bath(gf_const_view<imtime, matrix_valued> delta, nda::matrix_const_view<dcomplex> V0, nda::vector_const_view<double> eps0,
+                           bath_fit_params const &p = {});
+
+  /// fit_bath for all blocks, in parallel over the blocks according to the block_exec_policy
+  std::vector<bath_fit_result> fit_bath(block_gf_const_view<imfreq, matrix_valued> delta, std::vector<nda::matrix<dcomplex>> const &V0,
+                                        std::vector<nda::vector<double>> const &eps0, bath_fit_params const &p = {});
+
+  /// fit_bath for all blocks, in parallel over the blocks according to the block_exec_policy
+  std::vector<bath_fit_result> fit_bath(block_gf_const_view<imtime, matrix_valued> delta, std::vector<nda::matrix<dcomplex>> const &V0,
+                                        std::vector<nda::vector<double>> const &eps0, bath_fit_params const &p = {});
+
+} // namespace triqs::gfs
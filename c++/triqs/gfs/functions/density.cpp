@@ -20,11 +20,74 @@
 
 #include "../../gfs.hpp"
 #include <triqs/utility/legendre.hpp>
+#include <triqs/utility/bounded_cache.hpp>
+
+#include <algorithm>
+#include <tuple>
 
 namespace triqs::gfs {
 
   using nda::array;
 
+  namespace {
+
+    // Size of the process-wide caches of the mesh-dependent weights of the density sums, keyed by mesh hash and parameters
+    constexpr long weight_cache_size = 64;
+
+    // The Fermi weights 1 / (1 + exp(beta * w)) on a real-frequency mesh
+    std::shared_ptr<nda::vector<double> const> fermi_weights(mesh::refreq const &m, double beta) {
+      static utility::bounded_cache<std::tuple<uint64_t, double>, nda::vector<double>> cache{weight_cache_size};
+      return cache.get({m.mesh_hash(), beta}, [&] {
+        auto f = nda::vector<double>(m.size());
+        for (auto w : m) f(w.data_index()) = 1. / (1. + std::exp(beta * w));
+        return f;
+      });
+    }
+
+    // The Matsubara sums sum_n 1 / (i omega_n - b_p) of the three tail poles b_p, which depend only on the mesh
+    std::shared_ptr<std::array<dcomplex, 3> const> pole_sums(mesh::imfreq const &m, std::array<double, 3> const &b) {
+      static utility::bounded_cache<uint64_t, std::array<dcomplex, 3>> cache{weight_cache_size};
+      return cache.get(m.mesh_hash(), [&] {
+        auto S = std::array<dcomplex, 3>{};
+        for (int p = 0; p < 3; ++p)
+          for (auto w : m) S[p] += 1. / (w - b[p]);
+        return S;
+      });
+    }
+
+    // Sum of the (weighted) data over the mesh index, threaded over fixed chunks of the mesh.
+    // The chunk results are added in order, making the result independent of the number of threads.
+    nda::matrix<dcomplex> mesh_sum(nda::array_const_view<dcomplex, 3> d, double const *weights = nullptr) {
+      constexpr long chunk_size = 256;
+      long n_mesh = d.extent(0), N1 = d.extent(1), N2 = d.extent(2);
+      long n_chunks = (n_mesh + chunk_size - 1) / chunk_size;
+
+      auto partial = nda::zeros<dcomplex>(n_chunks, N1, N2);
+#pragma omp parallel for schedule(static)
+      for (long c = 0; c < n_chunks; ++c) {
+        for (long n = c * chunk_size; n < std::min((c + 1) * chunk_size, n_mesh); ++n) {
+          double w = weights ? weights[n] : 1.0;
+          for (long n1 = 0; n1 < N1; ++n1)
+            for (long n2 = 0; n2 < N2; ++n2) partial(c, n1, n2) += w * d(n, n1, n2);
+        }
+      }
+
+      auto res = nda::matrix<dcomplex>::zeros(N1, N2);
+      for (long c = 0; c < n_chunks; ++c) res += partial(c, range::all, range::all);
+      return res;
+    }
+
+    void check_tail_fit(double error) {
+      TRIQS_ASSERT2((error < 1e-2),
+                    "ERROR: High frequency moments have an error greater than 1e-2.\n  Error = " + std::to_string(error)
+                       + "\n Please make sure you treat the constant offset analytically!\n");
+      if (error > 1e-4)
+        std::cerr << "WARNING: High frequency moments have an error greater than 1e-4.\n Error = " << error
+                  << "\n Please make sure you treat the constant offset analytically!\n";
+    }
+
+  } // namespace
+
   //-------------------------------------------------------
   // For Imaginary Matsubara Frequency functions
   // ------------------------------------------------------
@@ -45,12 +108,7 @@ namespace triqs::gfs {
 
     if (known_moments.shape()[0] < 4) {
       auto [tail, error] = fit_tail(g, known_moments);
-      TRIQS_ASSERT2((error < 1e-2),
-                    "ERROR: High frequency moments have an error greater than 1e-2.\n  Error = " + std::to_string(error)
-                       + "\n Please make sure you treat the constant offset analytically!\n");
-      if (error > 1e-4)
-        std::cerr << "WARNING: High frequency moments have an error greater than 1e-4.\n Error = " << error
-                  << "\n Please make sure you treat the constant offset analytically!\n";
+      check_tail_fit(error);
       TRIQS_ASSERT2((first_dim(tail) > 3), "ERROR: Density implementation requires at least a proper 3rd high-frequency moment\n");
       return density(g, tail);
     } else
@@ -82,6 +140,10 @@ namespace triqs::gfs {
     // located at b with amplitude a
     auto F = [&beta, &xi](dcomplex a, double b) { return xi * a / (-xi + exp(-beta * b)); };
 
+    // The sum of g over the mesh, and the sums of the pole terms of the tail model
+    auto g_sum    = mesh_sum(g.data());
+    auto pole_sum = pole_sums(g.mesh(), {b1, b2, b3});
+
     for (int n1 = 0; n1 < N1; n1++)
       for (int n2 = n1; n2 < N2; n2++) {
         dcomplex m1 = mom_123(0, n1, n2), m2 = mom_123(1, n1, n2), m3 = mom_123(2, n1, n2);
@@ -108,8 +170,7 @@ namespace triqs::gfs {
         } else
           TRIQS_RUNTIME_ERROR << "ERROR: Unknown statistic in density\n";
 
-        dcomplex r = 0;
-        for (auto w : g.mesh()) r += g[w](n1, n2) - (a1 / (w - b1) + a2 / (w - b2) + a3 / (w - b3));
+        dcomplex r  = g_sum(n1, n2) - (a1 * (*pole_sum)[0] + a2 * (*pole_sum)[1] + a3 * (*pole_sum)[2]);
         res(n1, n2) = r / beta + m1 + F(a1, b1) + F(a2, b2) + F(a3, b3);
         res(n1, n2) *= -xi;
 
@@ -169,8 +230,8 @@ namespace triqs::gfs {
     auto [N, M] = g.target_shape();
     EXPECTS(beta > 0 and N == M);
 
-    auto res = nda::matrix<dcomplex>::zeros(N, N);
-    for (auto w : g.mesh()) res += g[w] / (1. + exp(beta * w));
+    auto f   = fermi_weights(g.mesh(), beta);
+    auto res = mesh_sum(g.data(), f->data());
 
     // -- Required to filter out divergent real parts of g that are inf
     // -- eg flat dos at dos edge
@@ -189,6 +250,42 @@ namespace triqs::gfs {
 
   dcomplex density(gf_const_view<refreq, scalar_valued> g) { return density(reinterpret_scalar_valued_gf_as_matrix_valued(g))(0, 0); }
 
+  //-------------------------------------------------------
+  // Total density of Block Green functions
+  // ------------------------------------------------------
+
+  dcomplex total_density(block_gf_const_view<imfreq> g, std::vector<array<dcomplex, 3>> const &known_moments) {
+
+    auto km = known_moments.empty() ? make_zero_tail(g, 1) : known_moments;
+    TRIQS_ASSERT2(g.size() == km.size(), "total_density: Require equal number of blocks in block_gf and known_moments vector");
+
+    // Fit the tails of all blocks together if required
+    if (std::ranges::any_of(km, [](auto const &m) { return m.shape()[0] < 4; })) {
+      for (auto const &m : km) {
+        if (m.is_empty()) continue;
+        double _abs_tail0 = max_element(abs(m(0, range::all, range::all)));
+        TRIQS_ASSERT2((_abs_tail0 < 1e-8),
+                      "ERROR: Density implementation requires vanishing 0th moment\n  error is :" + std::to_string(_abs_tail0) + "\n");
+      }
+      auto [tails, error] = fit_tail(g, km);
+      check_tail_fit(error);
+      km = std::move(tails);
+    }
+
+    // The block densities are computed according to the block_exec_policy, and summed in the order of the blocks
+    auto traces  = details::map_blocks(g.size(), get_block_exec_policy(), [&](long i) { return trace(density(g[i], km[i])); });
+    dcomplex res = 0;
+    for (auto const &t : traces) res += t;
+    return res;
+  }
+
+  dcomplex total_density(block_gf_const_view<refreq> g, double beta) {
+    auto traces  = details::map_blocks(g.size(), get_block_exec_policy(), [&](long i) { return trace(density(g[i], beta)); });
+    dcomplex res = 0;
+    for (auto const &t : traces) res += t;
+    return res;
+  }
+
   //-------------------------------------------------------
   // For Legendre functions
   // ------------------------------------------------------
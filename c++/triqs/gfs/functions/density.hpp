@@ -19,6 +19,7 @@
 
 #pragma once
 #include "../gf/gf_view.hpp"
+#include "../block/block_gf.hpp"
 namespace triqs {
   namespace gfs {
 
@@ -97,6 +98,14 @@ namespace triqs {
       return dens_vec;
     }
 
+    /**
+     * Total density of a Block Green function, i.e. the sum of the traces of the block densities
+     *
+     * If some known moments are missing, the tails of all blocks are fitted together.
+     */
+    dcomplex total_density(block_gf_const_view<mesh::imfreq> g, std::vector<array<dcomplex, 3>> const &known_moments = {});
+    dcomplex total_density(block_gf_const_view<mesh::refreq> g, double beta);
+
   } // namespace gfs
 } // namespace triqs
 
@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "../../gfs.hpp"
+#include "./dlr_dyson.hpp"
+#include <triqs/utility/bounded_cache.hpp>
+
+namespace triqs::gfs {
+
+  namespace {
+
+    enum class dyson_for { G, Sigma };
+
+    // G = (a^{-1} - b)^{-1} or Sigma = a^{-1} - b^{-1} at each node
+    void dyson_nodes(array_const_view<dcomplex, 3> a, array_const_view<dcomplex, 3> b, array_view<dcomplex, 3> out, dyson_for what, bool threaded) {
+      long n_nodes = a.extent(0), N = a.extent(1);
+
+#pragma omp parallel if (threaded)
+      {
+        auto m1 = matrix<dcomplex>(N, N), m2 = matrix<dcomplex>(N, N);
+#pragma omp for schedule(static)
+        for (long n = 0; n < n_nodes; ++n) {
+          m1 = a(n, range::all, range::all);
+          nda::inverse_in_place(m1);
+          m2 = b(n, range::all, range::all);
+          if (what == dyson_for::G) {
+            m1 -= m2;
+            nda::inverse_in_place(m1);
+          } else {
+            nda::inverse_in_place(m2);
+            m1 -= m2;
+          }
+          out(n, range::all, range::all) = m1;
+        }
+      }
+    }
+
+    gf<dlr_imfreq, matrix_valued> dyson(gf_const_view<dlr_imfreq, matrix_valued> g0, gf_const_view<dlr_imfreq, matrix_valued> x, dyson_for what,
+                                        bool threaded) {
+      if (g0.mesh() != x.mesh() or g0.target_shape() != x.target_shape())
+        TRIQS_RUNTIME_ERROR << "DLR Dyson equation: the Green functions are incompatible";
+      auto res = gf<dlr_imfreq, matrix_valued>{g0.mesh(), g0.target_shape()};
+      dyson_nodes(g0.data(), x.data(), res.data(), what, threaded);
+      return res;
+    }
+
+    block_gf<dlr_imfreq, matrix_valued> dyson(block_gf_const_view<dlr_imfreq, matrix_valued> g0, block_gf_const_view<dlr_imfreq, matrix_valued> x,
+                                              dyson_for what) {
+      if (g0.block_names() != x.block_names()) TRIQS_RUNTIME_ERROR << "DLR Dyson equation: the block structures differ";
+      long n_blocks = g0.size();
+      auto blocks   = std::vector<gf<dlr_imfreq, matrix_valued>>(n_blocks);
+
+      // Check and allocate serially, then solve the blocks in parallel
+      for (long b = 0; b < n_blocks; ++b) {
+        if (g0[b].mesh() != x[b].mesh() or g0[b].target_shape() != x[b].target_shape())
+          TRIQS_RUNTIME_ERROR << "DLR Dyson equation: the Green functions of block " << g0.block_names()[b] << " are incompatible";
+        blocks[b] = gf<dlr_imfreq, matrix_valued>{g0[b].mesh(), g0[b].target_shape()};
+      }
+#pragma omp parallel for schedule(dynamic)
+      for (long b = 0; b < n_blocks; ++b) dyson_nodes(g0[b].data(), x[b].data(), blocks[b].data(), what, false);
+
+      return {g0.block_names(), std::move(blocks)};
+    }
+
+    // The imaginary time operations of each DLR mesh, with the convolution matrices initialized
+    std::shared_ptr<const cppdlr::imtime_ops> convolution_ops(dlr const &m) {
+      static utility::bounded_cache<uint64_t, cppdlr::imtime_ops> cache{32};
+      return cache.get(m.mesh_hash(), [&] {
+        auto ops = m.dlr_it();
+        ops.convolve_init();
+        return ops;
+      });
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  gf<dlr_imfreq, matrix_valued> dlr_dyson_g(gf_const_view<dlr_imfreq, matrix_valued> g0, gf_const_view<dlr_imfreq, matrix_valued> sigma) {
+    return dyson(g0, sigma, dyson_for::G, true);
+  }
+
+  gf<dlr_imfreq, matrix_valued> dlr_dyson_sigma(gf_const_view<dlr_imfreq, matrix_valued> g0, gf_const_view<dlr_imfreq, matrix_valued> g) {
+    return dyson(g0, g, dyson_for::Sigma, true);
+  }
+
+  block_gf<dlr_imfreq, matrix_valued> dlr_dyson_g(block_gf_const_view<dlr_imfreq, matrix_valued> g0,
+                                                  block_gf_const_view<dlr_imfreq, matrix_valued> sigma) {
+    return dyson(g0, sigma, dyson_for::G);
+  }
+
+  block_gf<dlr_imfreq, matrix_valued> dlr_dyson_sigma(block_gf_const_view<dlr_imfreq, matrix_valued> g0,
+                                                      block_gf_const_view<dlr_imfreq, matrix_valued> g) {
+    return dyson(g0, g, dyson_for::Sigma);
+  }
+
+  //-------------------------------------------------------
+
+  dlr_convolution::dlr_convolution(dlr const &m) : _mesh(m), _ops(convolution_ops(m)) {}
+
+  gf<dlr_imtime, matrix_valued> dlr_convolution::operator()(gf_const_view<dlr, matrix_valued> f, gf_const_view<dlr, matrix_valued> g,
+                                                            bool time_order) const {
+    if (f.mesh() != _mesh or g.mesh() != _mesh)
+      TRIQS_RUNTIME_ERROR << "dlr_convolution: the Green functions must be defined on the mesh of the operator";
+    auto res   = gf<dlr_imtime, matrix_valued>{dlr_imtime{_mesh}, {f.target_shape()[0], g.target_shape()[1]}};
+    res.data() = _ops->convolve(_mesh.beta(), static_cast<cppdlr::statistic_t>(_mesh.statistic()), f.data(), g.data(), time_order);
+    return res;
+  }
+
+  nda::matrix<dcomplex> dlr_convolution::matrix(gf_const_view<dlr, matrix_valued> f, bool time_order) const {
+    if (f.mesh() != _mesh) TRIQS_RUNTIME_ERROR << "dlr_convolution: the Green function must be defined on the mesh of the operator";
+    return _ops->convmat(_mesh.beta(), static_cast<cppdlr::statistic_t>(_mesh.statistic()), f.data(), time_order);
+  }
+
+  gf<dlr_imtime, matrix_valued> dlr_convolve(gf_const_view<dlr, matrix_valued> f, gf_const_view<dlr, matrix_valued> g, bool time_order) {
+    return dlr_convolution{f.mesh()}(f, g, time_order);
+  }
+
+} // namespace triqs::gfs
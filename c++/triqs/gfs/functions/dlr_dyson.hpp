@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include "./dlr.hpp"
+#include <memory>
+
+namespace triqs::gfs {
+
+  //-------------------------------------------------------
+  // Dyson equation on the DLR Matsubara nodes
+  // ------------------------------------------------------
+
+  /**
+   * Solve the Dyson equation $$ G = (G_0^{-1} - \Sigma)^{-1} $$ on the DLR Matsubara nodes
+   *
+   * The small matrix inversions are done node by node, in parallel over the nodes.
+   *
+   * @param g0 The non-interacting Green function
+   * @param sigma The self-energy, on the same mesh
+   * @return The interacting Green function
+   */
+  gf<dlr_imfreq, matrix_valued> dlr_dyson_g(gf_const_view<dlr_imfreq, matrix_valued> g0, gf_const_view<dlr_imfreq, matrix_valued> sigma);
+
+  /**
+   * Solve the Dyson equation for the self-energy $$ \Sigma = G_0^{-1} - G^{-1} $$ on the DLR Matsubara nodes
+   *
+   * @param g0 The non-interacting Green function
+   * @param g The interacting Green function, on the same mesh
+   * @return The self-energy
+   */
+  gf<dlr_imfreq, matrix_valued> dlr_dyson_sigma(gf_const_view<dlr_imfreq, matrix_valued> g0, gf_const_view<dlr_imfreq, matrix_valued> g);
+
+  /// dlr_dyson_g for all blocks, in parallel over the blocks
+  block_gf<dlr_imfreq, matrix_valued> dlr_dyson_g(block_gf_const_view<dlr_imfreq, matrix_valued> g0,
+                                                  block_gf_const_view<dlr_imfreq, matrix_valued> sigma);
+
+  /// dlr_dyson_sigma for all blocks, in parallel over the blocks
+  block_gf<dlr_imfreq, matrix_valued> dlr_dyson_sigma(block_gf_const_view<dlr_imfreq, matrix_valued> g0,
+                                                      block_gf_const_view<dlr_imfreq, matrix_valued> g);
+
+  //-------------------------------------------------------
+  // Convolution in imaginary time
+  // ------------------------------------------------------
+
+  /**
+   * Convolution of DLR Green functions in imaginary time
+   *
+   *   $$ (f * g)(\tau) = \int_0^\beta d\tau' f(\tau - \tau') g(\tau') $$
+   *
+   * or, with time_order, the time-ordered convolution $$ \int_0^\tau d\tau' f(\tau - \tau') g(\tau') $$.
+   * The convolution matrices of cppdlr are built once per mesh and shared by all operators on the same mesh.
+   */
+  class dlr_convolution {
+    dlr _mesh;
+    std::shared_ptr<const cppdlr::imtime_ops> _ops;
+
+    public:
+    /// The convolution operator on the DLR mesh m
+    explicit dlr_convolution(dlr const &m);
+
+    /// The DLR mesh of the operator
+    [[nodiscard]] dlr const &mesh() const { return _mesh; }
+
+    /// The values of f * g on the DLR imaginary time nodes, from the DLR coefficients of f and g
+    [[nodiscard]] gf<dlr_imtime, matrix_valued> operator()(gf_const_view<dlr, matrix_valued> f, gf_const_view<dlr, matrix_valued> g,
+                                                           bool time_order = false) const;
+
+    /**
+     * The matrix of the convolution by f
+     *
+     * It maps the values of g on the DLR imaginary time nodes, flattened over (node, orbital),
+     * to the values of f * g. Useful when f is fixed and g varies, e.g. in the iterations of a solver.
+     */
+    [[nodiscard]] nda::matrix<dcomplex> matrix(gf_const_view<dlr, matrix_valued> f, bool time_order = false) const;
+  };
+
+  /// The convolution f * g on the DLR imaginary time nodes, cf. dlr_convolution
+  gf<dlr_imtime, matrix_valued> dlr_convolve(gf_const_view<dlr, matrix_valued> f, gf_const_view<dlr, matrix_valued> g, bool time_order = false);
+
+} // namespace triqs::gfs
@@ -62,15 +62,39 @@ namespace triqs::gfs {
    * @tparam AG The type of the high-frequecy moments for Block Green functions (e.g. std::vector<array>)
    *
    * @param bg The Block Green function object to fit the tail for 
+   *
+   * If all blocks share the same mesh, the fit windows of all blocks are gathered
+   * into one matrix and fitted with a single call to the least-squares solver.
+   * Otherwise the blocks are fitted according to the block_exec_policy.
    */
   template <int N = 0, typename BG, typename BA = std::vector<typename BG::g_t::data_t::regular_type>>
   std::pair<std::vector<typename BG::g_t::data_t::regular_type>, double> fit_tail(BG const &bg, BA const &known_moments = {})
     requires(is_block_gf_v<BG, 1>)
   {
+    constexpr int R = BG::g_t::data_rank;
+    bool same_mesh  = bg.size() > 0;
+    for (auto const &g_bl : bg.data()) same_mesh = same_mesh and (get_mesh<N>(g_bl) == get_mesh<N>(bg.data()[0]));
+
+    if (same_mesh) {
+      std::vector<array_const_view<dcomplex, R>> data_vec, km_vec;
+      for (auto [i, g_bl] : itertools::enumerate(bg.data())) {
+        data_vec.emplace_back(g_bl.data());
+        km_vec.emplace_back(known_moments.empty() ? array_const_view<dcomplex, R>{} : array_const_view<dcomplex, R>{known_moments[i]});
+      }
+      auto const &m          = get_mesh<N>(bg.data()[0]);
+      auto [tail_vec, error] = m.get_tail_fitter().template fit_batched<N>(m, data_vec, true, km_vec);
+      return {std::move(tail_vec), error};
+    }
+
+    // Otherwise the blocks are fitted one by one, according to the block_exec_policy
+    auto fits = details::map_blocks(bg.size(), get_block_exec_policy(), [&](long i) {
+      auto const &g_bl = bg.data()[i];
+      return known_moments.empty() ? fit_tail<N, typename BG::g_t>(g_bl) : fit_tail<N, typename BG::g_t>(g_bl, known_moments[i]);
+    });
+
     double max_err = 0.0;
     std::vector<typename BG::g_t::data_t::regular_type> tail_vec;
-    for (auto [i, g_bl] : itertools::enumerate(bg)) {
-      auto [tail, err] = known_moments.empty() ? fit_tail<N, typename BG::g_t>(g_bl) : fit_tail<N, typename BG::g_t>(g_bl, known_moments[i]);
+    for (auto &[tail, err] : fits) {
       tail_vec.emplace_back(std::move(tail));
       max_err = std::max(err, max_err);
     }
@@ -0,0 +1,134 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "./expr_program.hpp"
+
+namespace triqs::gfs {
+
+  namespace {
+
+    // Check the program against the operands, and return the maximal depth of the stack
+    long check_program(array_view<dcomplex, 3> out, std::vector<long> const &program, std::vector<array_view<dcomplex, 3>> const &operands,
+                       array_view<dcomplex, 1> omega) {
+      long n_mesh = out.extent(0), N = out.extent(1);
+      long depth  = 0, max_depth = 0;
+      for (long i = 0; i < long(program.size()); ++i) {
+        auto op = expr_op(program[i]);
+        switch (op) {
+          case expr_op::push_data:
+          case expr_op::push_constant: {
+            if (++i == long(program.size())) TRIQS_RUNTIME_ERROR << "eval_expr_program: missing operand index";
+            long k = program[i];
+            if (k < 0 or k >= long(operands.size())) TRIQS_RUNTIME_ERROR << "eval_expr_program: invalid operand index " << k;
+            auto const &a = operands[k];
+            if (a.extent(0) != (op == expr_op::push_data ? n_mesh : 1) or a.extent(1) != N or a.extent(2) != N)
+              TRIQS_RUNTIME_ERROR << "eval_expr_program: operand " << k << " of shape " << a.shape() << " is incompatible with the result of shape "
+                                  << out.shape();
+            ++depth;
+            break;
+          }
+          case expr_op::push_omega:
+            if (omega.size() != n_mesh) TRIQS_RUNTIME_ERROR << "eval_expr_program: omega has " << omega.size() << " points, expected " << n_mesh;
+            ++depth;
+            break;
+          case expr_op::add:
+          case expr_op::sub:
+          case expr_op::mul:
+          case expr_op::div:
+            if (depth < 2) TRIQS_RUNTIME_ERROR << "eval_expr_program: binary operation on a stack of depth " << depth;
+            --depth;
+            break;
+          case expr_op::inverse:
+          case expr_op::transpose:
+          case expr_op::conjugate:
+            if (depth < 1) TRIQS_RUNTIME_ERROR << "eval_expr_program: unary operation on an empty stack";
+            break;
+          default: TRIQS_RUNTIME_ERROR << "eval_expr_program: unknown instruction " << program[i];
+        }
+        max_depth = std::max(max_depth, depth);
+      }
+      if (depth != 1) TRIQS_RUNTIME_ERROR << "eval_expr_program: the program leaves " << depth << " values on the stack";
+      return max_depth;
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  void eval_expr_program(array_view<dcomplex, 3> out, std::vector<long> const &program, std::vector<array_view<dcomplex, 3>> const &operands,
+                         array_view<dcomplex, 1> omega) {
+    EXPECTS(out.extent(1) == out.extent(2));
+    long n_mesh    = out.extent(0), N = out.extent(1), n_instr = program.size();
+    long max_depth = check_program(out, program, operands, omega);
+
+#pragma omp parallel
+    {
+      // The stack of matrices and a work matrix, allocated once per thread
+      auto stack = array<dcomplex, 3>(max_depth, N, N);
+      auto work  = matrix<dcomplex>(N, N);
+      auto s     = [&stack](long j) { return make_matrix_view(stack(j, range::all, range::all)); };
+
+#pragma omp for schedule(static)
+      for (long n = 0; n < n_mesh; ++n) {
+        long sp = 0;
+        for (long i = 0; i < n_instr; ++i) {
+          switch (expr_op(program[i])) {
+            case expr_op::push_data: s(sp++) = operands[program[++i]](n, range::all, range::all); break;
+            case expr_op::push_constant: s(sp++) = operands[program[++i]](0, range::all, range::all); break;
+            case expr_op::push_omega: s(sp++) = omega(n); break; // a scalar assigned to a matrix is a multiple of the identity
+            case expr_op::add:
+              s(sp - 2) += s(sp - 1);
+              --sp;
+              break;
+            case expr_op::sub:
+              s(sp - 2) -= s(sp - 1);
+              --sp;
+              break;
+            case expr_op::div:
+              if (N == 1)
+                s(sp - 1)(0, 0) = 1.0 / s(sp - 1)(0, 0);
+              else
+                nda::inverse_in_place(s(sp - 1));
+              [[fallthrough]];
+            case expr_op::mul:
+              if (N == 1)
+                s(sp - 2)(0, 0) *= s(sp - 1)(0, 0);
+              else {
+                nda::blas::gemm(1.0, s(sp - 2), s(sp - 1), 0.0, work);
+                s(sp - 2) = work;
+              }
+              --sp;
+              break;
+            case expr_op::inverse:
+              if (N == 1)
+                s(sp - 1)(0, 0) = 1.0 / s(sp - 1)(0, 0);
+              else
+                nda::inverse_in_place(s(sp - 1));
+              break;
+            case expr_op::transpose:
+              work      = transpose(s(sp - 1));
+              s(sp - 1) = work;
+              break;
+            case expr_op::conjugate: s(sp - 1) = conj(s(sp - 1)); break;
+          }
+        }
+        out(n, range::all, range::all) = stack(0, range::all, range::all);
+      }
+    }
+  }
+
+} // namespace triqs::gfs
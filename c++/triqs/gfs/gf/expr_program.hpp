@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include "./defs.hpp"
+#include <vector>
+
+namespace triqs::gfs {
+
+  /// The instructions of a program for eval_expr_program
+  enum class expr_op : long {
+    push_data     = 0,
+    push_constant = 1,
+    push_omega    = 2,
+    add           = 3,
+    sub           = 4,
+    mul           = 5,
+    div           = 6,
+    inverse       = 7,
+    transpose     = 8,
+    conjugate     = 9
+  };
+
+  /**
+   * Evaluates a postfix program of matrix operations at every point of a mesh
+   *
+   * This is the backend of the lazy expressions of the Python layer, e.g. G << inverse(iOmega_n + mu - Sigma),
+   * which are evaluated in a single pass over the mesh without temporary Green functions.
+   *
+   *   push_data k     : push operands[k](n, :, :) at the mesh point n
+   *   push_constant k : push operands[k](0, :, :)
+   *   push_omega      : push omega(n) times the identity
+   *   add, sub, mul   : pop b, a and push a + b, a - b or the matrix product a * b
+   *   div             : pop b, a and push a * b^{-1}
+   *   inverse         : replace the top of the stack by its inverse
+   *   transpose       : replace the top of the stack by its transpose
+   *   conjugate       : replace the top of the stack by its complex conjugate
+   *
+   * The mesh points are distributed over the threads.
+   *
+   * @param out The result of shape (n_mesh, N, N). It may alias one of the operands.
+   * @param program The instructions, push_data and push_constant being followed by the index of the operand
+   * @param operands The data of shape (n_mesh, N, N) or the constants of shape (1, N, N)
+   * @param omega The mesh values, only used by push_omega
+   */
+  void eval_expr_program(array_view<dcomplex, 3> out, std::vector<long> const &program, std::vector<array_view<dcomplex, 3>> const &operands,
+                         array_view<dcomplex, 1> omega);
+
+} // namespace triqs::gfs
@@ -19,6 +19,7 @@
 #include <triqs/gfs.hpp>
 #include <nda/nda.hpp>
 #include <nda/sym_grp.hpp>
+#include <atomic>
 
 namespace triqs {
   namespace gfs {
@@ -95,6 +96,63 @@ namespace triqs {
       return std::apply(fetch, tpl);
     }
 
+    /**
+     * The symmetry classes of the data array of a Green function, in a compact representation
+     *
+     * The members of class c are members(i) for i in [class_ptr(c), class_ptr(c + 1)), given as flat (C-order) indices
+     * of the data array. The first member is the representative, with the smallest flat index of the class.
+     * ops(i) encodes the operation relating the member to the representative (bit 0: sign flip, bit 1: complex conjugation).
+     *
+     * The table can be written to / read from HDF5 and reused to build a sym_grp for the same mesh and target shape.
+     */
+    struct sym_class_table {
+      /// Shape of the data array
+      std::vector<long> shape;
+
+      /// Hash of the mesh
+      uint64_t mesh_hash = 0;
+
+      /// Offsets of the classes in members and ops
+      nda::vector<long> class_ptr = nda::zeros<long>(1);
+
+      /// Flat data index of the members of all classes
+      nda::vector<long> members;
+
+      /// Operation relating each member to the representative of its class
+      nda::vector<uint8_t> ops;
+
+      /// Number of symmetry classes
+      [[nodiscard]] long num_classes() const { return class_ptr.size() - 1; }
+
+      /// Encode an operation
+      static uint8_t encode(nda::operation const &op) { return uint8_t(op.sgn) | (uint8_t(op.cc) << 1); }
+
+      /// Decode an operation
+      static nda::operation decode(uint8_t x) { return nda::operation{bool(x & 1), bool(x & 2)}; }
+
+      [[nodiscard]] static std::string hdf5_format() { return "SymClassTable"; }
+
+      friend void h5_write(h5::group fg, std::string const &name, sym_class_table const &t) {
+        auto gr = fg.create_group(name);
+        write_hdf5_format(gr, t);
+        h5::write(gr, "shape", t.shape);
+        h5::write(gr, "mesh_hash", static_cast<long>(t.mesh_hash));
+        h5::write(gr, "class_ptr", t.class_ptr);
+        h5::write(gr, "members", t.members);
+        h5::write(gr, "ops", t.ops);
+      }
+
+      friend void h5_read(h5::group fg, std::string const &name, sym_class_table &t) {
+        auto gr = fg.open_group(name);
+        assert_hdf5_format(gr, t, true);
+        h5::read(gr, "shape", t.shape);
+        t.mesh_hash = static_cast<uint64_t>(h5::read<long>(gr, "mesh_hash"));
+        h5::read(gr, "class_ptr", t.class_ptr);
+        h5::read(gr, "members", t.members);
+        h5::read(gr, "ops", t.ops);
+      }
+    };
+
     /**
      * The sym_grp class 
      * @tparam F Anything modeling either ScalarGfSymmetry or TensorGfSymmetry with G
@@ -121,7 +179,7 @@ namespace triqs {
       using target_index_t                = std::array<long, static_cast<std::size_t>(target_rank)>;
 
       // members
-      nda::sym_grp<data_sym_func_t, data_t> data_sym_grp; // symmetry group instance for the data array
+      sym_class_table table;
 
       // convert from gf to nda symmetry
       data_sym_func_t to_data_symmetry(F const &f, G const &g) const {
@@ -213,18 +271,153 @@ namespace triqs {
         return hp;
       }
 
+      // ---------------- class construction ----------------
+
+      // C-order flat index <-> data index
+      static long flatten(data_index_t const &x, std::vector<long> const &shape) {
+        long r = 0;
+        for (auto d : range(x.size())) r = r * shape[d] + x[d];
+        return r;
+      }
+
+      static data_index_t unflatten(long i, std::vector<long> const &shape) {
+        data_index_t x;
+        for (long d = x.size() - 1; d >= 0; --d) {
+          x[d] = i % shape[d];
+          i /= shape[d];
+        }
+        return x;
+      }
+
+      // Visit all data indices reached from x by one symmetry, following chains of
+      // out-of-bounds indices for at most max_length steps (out-of-bounds projection)
+      template <typename V>
+      static void for_each_neighbour(std::vector<data_sym_func_t> const &sym_list, std::vector<long> const &shape, long max_length,
+                                     data_index_t const &x, nda::operation const &op, long path_length, V &&visit) {
+        for (auto const &sym : sym_list) {
+          auto [xp, opp] = sym(x);
+          opp            = opp * op;
+          bool valid     = true;
+          for (auto d : range(xp.size())) valid = valid and xp[d] >= 0 and xp[d] < shape[d];
+          if (valid)
+            visit(xp, opp);
+          else if (path_length < max_length)
+            for_each_neighbour(sym_list, shape, max_length, xp, opp, path_length + 1, visit);
+        }
+      }
+
+      // Build the class table in three passes
+      //  1. The classes are the connected components of the graph of the symmetries, found with a concurrent union-find.
+      //     Roots are always linked to the smaller root, so that each class ends up represented by its smallest flat index.
+      //  2. The classes are numbered by increasing representative, and the member ranges are laid out.
+      //  3. Each class is traversed from its representative to compute the operation of each member, classes in parallel.
+      static sym_class_table make_table(G const &g, std::vector<data_sym_func_t> const &sym_list, long max_length, bool parallel) {
+        sym_class_table t;
+        auto const &data_shape = g.data().shape();
+        t.shape                = std::vector<long>(data_shape.begin(), data_shape.end());
+        t.mesh_hash            = g.mesh().mesh_hash();
+        long N                 = g.data().size();
+        auto const &shape      = t.shape;
+
+        // -- 1. Union-find
+        std::vector<std::atomic<long>> parent(N);
+        for (long i = 0; i < N; ++i) parent[i].store(i, std::memory_order_relaxed);
+
+        auto find = [&parent](long i) {
+          while (true) {
+            long p = parent[i].load();
+            if (p == i) return i;
+            long gp = parent[p].load();
+            if (gp != p) parent[i].compare_exchange_weak(p, gp); // path halving
+            i = gp;
+          }
+        };
+
+        auto unite = [&](long a, long b) {
+          while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            if (parent[a].compare_exchange_strong(a, b)) return;
+          }
+        };
+
+#pragma omp parallel for schedule(dynamic, 1024) if (parallel)
+        for (long i = 0; i < N; ++i) {
+          for_each_neighbour(sym_list, shape, max_length, unflatten(i, shape), nda::operation{}, 0,
+                             [&](data_index_t const &xp, nda::operation const &) { unite(i, flatten(xp, shape)); });
+        }
+
+        // -- 2. Number the classes and lay out their members
+        std::vector<long> class_of(N), roots;
+        for (long i = 0; i < N; ++i) {
+          long r = find(i);
+          if (r == i) roots.push_back(i);
+          class_of[i] = (r == i) ? long(roots.size()) - 1 : class_of[r];
+        }
+        long n_classes = roots.size();
+        t.class_ptr    = nda::zeros<long>(n_classes + 1);
+        for (long i = 0; i < N; ++i) ++t.class_ptr(class_of[i] + 1);
+        for (long c = 0; c < n_classes; ++c) t.class_ptr(c + 1) += t.class_ptr(c);
+        parent.clear();
+        class_of.clear();
+
+        // -- 3. Traverse each class from its representative, using its range of members as the queue
+        constexpr uint8_t unvisited = 0xFF;
+        t.members                   = nda::vector<long>(N);
+        auto state                  = nda::vector<uint8_t>(N);
+        state                       = unvisited;
+        for (long c = 0; c < n_classes; ++c) t.members(t.class_ptr(c)) = roots[c];
+
+        std::atomic<bool> incomplete = false;
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (long c = 0; c < n_classes; ++c) {
+          long head = t.class_ptr(c), tail = head + 1;
+          state(t.members(head)) = 0;
+          while (head < tail) {
+            long x = t.members(head++);
+            for_each_neighbour(sym_list, shape, max_length, unflatten(x, shape), sym_class_table::decode(state(x)), 0,
+                               [&](data_index_t const &xp, nda::operation const &op) {
+                                 long j = flatten(xp, shape);
+                                 if (state(j) != unvisited) return;
+                                 state(j)          = sym_class_table::encode(op);
+                                 t.members(tail++) = j;
+                               });
+          }
+          if (tail != t.class_ptr(c + 1)) incomplete = true;
+        }
+        if (incomplete) TRIQS_RUNTIME_ERROR << "sym_grp: the symmetries do not form a group on the data array";
+
+        t.ops = nda::vector<uint8_t>(N);
+        for (long i = 0; i < N; ++i) t.ops(i) = state(t.members(i));
+        return t;
+      }
+
+      // Apply f(c, m) for each class c, with m a view on the slice of members of c
+      template <typename Fn> void for_each_class(Fn &&f, bool parallel) const {
+        long n_classes = table.num_classes();
+#pragma omp parallel for schedule(dynamic, 64) if (parallel)
+        for (long c = 0; c < n_classes; ++c) f(c, range(table.class_ptr(c), table.class_ptr(c + 1)));
+      }
+
+      // The element of the data array at a flat index
+      template <typename A> static decltype(auto) at(A &&a, long i, std::vector<long> const &shape) {
+        return std::apply(a, unflatten(i, shape));
+      }
+
       public:
       /**
-       * Accessor for symmetry group of the data array
-       * @return Instance of type nda::sym_grp
+       * Accessor for the table of symmetry classes
+       * @return The class table, which can be stored in HDF5 and passed to the constructor
        */
-      [[nodiscard]] nda::sym_grp<data_sym_func_t, data_t> const &get_data_sym_grp() const { return data_sym_grp; }
+      [[nodiscard]] sym_class_table const &get_sym_class_table() const { return table; }
 
       /**
        * Accessor for number of symmetry classes
        * @return Number of deduced symmetry classes
        */
-      [[nodiscard]] long num_classes() const { return data_sym_grp.num_classes(); }
+      [[nodiscard]] long num_classes() const { return table.num_classes(); }
 
       /**
        * Reduce Green's function to its representative data using symmetries
@@ -232,7 +425,9 @@ namespace triqs {
        * @return Vector of data values for the representatives elements of each symmetry class
       */
       [[nodiscard]] std::vector<value_t> get_representative_data(G const &g) const {
-        return data_sym_grp.get_representative_data(g.data());
+        std::vector<value_t> vec(num_classes());
+        for_each_class([&](long c, range r) { vec[c] = at(g.data(), table.members(r.first()), table.shape); }, true);
+        return vec;
       }
 
       /**
@@ -240,9 +435,13 @@ namespace triqs {
        * @param g A Green's function
        * @param vec Vector or vector view of data values for the representatives elements of each symmetry class
       */
-      template <typename V>
-      void init_from_representative_data(G &g, V const &vec) const {
-        data_sym_grp.init_from_representative_data(g.data(), vec);
+      template <typename V> void init_from_representative_data(G &g, V const &vec) const {
+        if (long(vec.size()) != num_classes()) TRIQS_RUNTIME_ERROR << "sym_grp: expected one value per symmetry class";
+        for_each_class(
+           [&](long c, range r) {
+             for (auto i : r) at(g.data(), table.members(i), table.shape) = sym_class_table::decode(table.ops(i))(value_t(vec[c]));
+           },
+           true);
       };
 
       /**
@@ -255,9 +454,21 @@ namespace triqs {
        * @param g A Green's function
        * @param sym_list List of symmetries modeling one of gf symmetry concepts
        * @param max_length Maximum recursion depth for out-of-bounds projection. Default is 0.
+       * @param parallel Switch to enable OMP parallel evaluation of the symmetries. Default is false
+       */
+      sym_grp(G const &g, std::vector<F> const &sym_list, long const max_length = 0, bool parallel = false)
+         : table{make_table(g, to_data_symmetry_list(g, sym_list), max_length, parallel)} {};
+
+      /**
+       * Constructor for sym_grp class from a class table, e.g. read from HDF5
+       * @param g A Green's function with the mesh and the target shape the table was built for
+       * @param t The class table
        */
-      sym_grp(G const &g, std::vector<F> const &sym_list, long const max_length = 0)
-         : data_sym_grp{g.data(), to_data_symmetry_list(g, sym_list), max_length} {};
+      sym_grp(G const &g, sym_class_table t) : table{std::move(t)} {
+        auto const &data_shape = g.data().shape();
+        if (table.mesh_hash != g.mesh().mesh_hash() or table.shape != std::vector<long>(data_shape.begin(), data_shape.end()))
+          TRIQS_RUNTIME_ERROR << "sym_grp: the class table was built for another mesh or target shape";
+      }
 
       /**
        * Initializer method: Iterates over all classes and propagates result from evaluation of init function
@@ -270,17 +481,47 @@ namespace triqs {
       void init(G &g, H const &h, bool parallel = false) const
         requires(ScalarGfInitFunc<H, G> || TensorGfInitFunc<H, G>)
       {
-        data_sym_grp.init(g.data(), to_data_init_func(g, h), parallel);
+        auto hp = to_data_init_func(g, h);
+        for_each_class(
+           [&](long, range r) {
+             value_t val = hp(unflatten(table.members(r.first()), table.shape));
+             for (auto i : r) at(g.data(), table.members(i), table.shape) = sym_class_table::decode(table.ops(i))(val);
+           },
+           parallel);
       }
 
       /**
        * Symmetrization method: Symmetrizes a gf returning the maximum symmetry violation and its corresponding mesh & target index
+       *
+       * The classes are symmetrized in parallel. The maximum violation is the first one in the order of the classes.
+       *
        * @param g A Green's function
        * @return Maximum symmetry violation and corresponding mesh & target index
       */
       std::tuple<double, mesh_index_t, target_index_t> symmetrize(G &g) const {
-        auto const &[max_diff, max_index] = data_sym_grp.symmetrize(g.data());
-        auto const m                      = g.mesh();
+        // the maximum violation in each class, and its flat index
+        auto class_max = std::vector<std::pair<double, long>>(num_classes(), {0.0, 0});
+        for_each_class(
+           [&](long c, range r) {
+             value_t ref_val = 0.0;
+             for (auto i : r) ref_val += sym_class_table::decode(table.ops(i))(at(g.data(), table.members(i), table.shape));
+             ref_val /= double(r.size());
+             for (auto i : r) {
+               auto &x         = at(g.data(), table.members(i), table.shape);
+               auto mapped_val = sym_class_table::decode(table.ops(i))(ref_val);
+               auto diff       = std::abs(mapped_val - x);
+               if (diff > class_max[c].first) class_max[c] = {diff, table.members(i)};
+               x = mapped_val;
+             }
+           },
+           true);
+
+        double max_diff = 0.0;
+        long max_flat   = 0;
+        for (auto const &[diff, i] : class_max)
+          if (diff > max_diff) std::tie(max_diff, max_flat) = std::tie(diff, i);
+        auto const max_index = unflatten(max_flat, table.shape);
+        auto const m         = g.mesh();
 
         if constexpr (target_rank == 0) { // scalar valued gfs
 
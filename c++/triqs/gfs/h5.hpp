@@ -18,6 +18,7 @@
 // Authors: Michel Ferrero, Olivier Parcollet, Nils Wentzell
 
 #pragma once
+#include "../utility/h5_chunked.hpp"
 
 namespace triqs::gfs {
 
@@ -90,4 +91,55 @@ namespace triqs::gfs {
     }
   };
 
+  // ---------------------------
+
+  /**
+   * Write a Green function with its data in a chunked, compressed dataset
+   *
+   * The chunk extents of the parameters are given along the mesh axes, the target axes are not split,
+   * e.g. {1} for a gf on prod<brzone, imfreq> makes one chunk per momentum.
+   * The group has the layout of h5_write, so it is read back by h5_read.
+   *
+   * @param fg The HDF5 group
+   * @param subgroup_name The name of the subgroup of the Green function
+   * @param g The Green function
+   * @param p The chunk shape and the compression
+   */
+  template <MemoryGf G> void h5_write_chunked(h5::group fg, std::string const &subgroup_name, G const &g, utility::h5_chunk_params const &p = {}) {
+    if (long(p.chunk_shape.size()) > G::arity) TRIQS_RUNTIME_ERROR << "h5_write_chunked: the chunk shape has more axes than the mesh";
+    auto gr = fg.create_group(subgroup_name);
+    write_hdf5_format(gr, g);
+    utility::h5_write_chunked(gr, "data", g.data(), p);
+    h5_write(gr, "mesh", g.mesh());
+  }
+
+  /**
+   * Read a slice of the mesh of a Green function stored by h5_write or h5_write_chunked
+   *
+   * Only the chunks of the data which intersect the slice are read from the file. The other values of g are unchanged.
+   *
+   * @param fg The HDF5 group
+   * @param subgroup_name The name of the subgroup of the Green function
+   * @param g The Green function (or view) to read into. Its mesh must be the stored mesh.
+   * @param slice The ranges of data indices, for each mesh axis
+   */
+  template <typename G>
+    requires(MemoryGf<std::decay_t<G>>)
+  void h5_read_mesh_slice(h5::group fg, std::string const &subgroup_name, G &&g, std::array<nda::range, std::decay_t<G>::arity> const &slice) {
+    auto gr   = fg.open_group(subgroup_name);
+    auto mesh = typename std::decay_t<G>::mesh_t{};
+    h5_read(gr, "mesh", mesh);
+    if (mesh != g.mesh())
+      TRIQS_RUNTIME_ERROR << "h5_read_mesh_slice: the mesh of the Green function " << subgroup_name << " differs from the stored one";
+
+    auto offset = std::vector<long>(std::decay_t<G>::data_rank, 0);
+    for (auto [d, r] : itertools::enumerate(slice)) {
+      if (r.step() != 1 or r.first() < 0 or r.last() > g.data().extent(d))
+        TRIQS_RUNTIME_ERROR << "h5_read_mesh_slice: the range " << r << " is not a contiguous slice of the mesh axis " << d;
+      offset[d] = r.first();
+    }
+    auto data_slice = std::apply([&g](auto const &...r) { return g.data()(r..., nda::ellipsis{}); }, slice);
+    utility::h5_read_box(gr, "data", data_slice, offset);
+  }
+
 } // namespace triqs::gfs
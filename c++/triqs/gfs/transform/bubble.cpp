@@ -0,0 +1,147 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "../../gfs.hpp"
+#include "./bubble.hpp"
+#include "./fourier_common.hpp"
+#include <itertools/itertools.hpp>
+
+namespace triqs::gfs {
+
+  namespace {
+
+    // The data index of -r for every point r of the mesh
+    std::vector<long> minus_r_index(cyclat const &r_mesh) {
+      std::vector<long> res(r_mesh.size());
+      for (auto r : r_mesh) {
+        auto idx            = r.index();
+        res[r.data_index()] = r_mesh.to_data_index(r_mesh.index_modulo({-idx[0], -idx[1], -idx[2]}));
+      }
+      return res;
+    }
+
+    // chi(tau, r) for the imaginary time points [t_begin, t_end), threaded over (tau, r)
+    void bubble_product(array_const_view<dcomplex, 4> g, array_view<dcomplex, 6> chi, bubble_channel channel, cyclat const &r_mesh, long t_begin,
+                        long t_end) {
+      long n_tau = g.extent(0), n_r = g.extent(1), N = g.extent(2);
+
+      auto minus_r = minus_r_index(r_mesh);
+
+#pragma omp parallel for collapse(2) schedule(static)
+      for (long t = t_begin; t < t_end; ++t) {
+        for (long r = 0; r < n_r; ++r) {
+          for (long a = 0; a < N; ++a)
+            for (long b = 0; b < N; ++b)
+              for (long c = 0; c < N; ++c)
+                for (long d = 0; d < N; ++d) {
+                  if (channel == bubble_channel::PH)
+                    chi(t, r, a, b, c, d) = g(n_tau - 1 - t, minus_r[r], d, a) * g(t, r, b, c);
+                  else
+                    chi(t, r, a, b, c, d) = g(t, r, a, c) * g(t, r, b, d);
+                }
+        }
+      }
+    }
+
+    // In-place transform r -> q of chi(tau, r) for the imaginary time points [t_begin, t_end), threaded over tau
+    // The plan is created once, and executed on each time slice (fftw_execute_dft is thread-safe)
+    void fourier_r_to_q(array_view<dcomplex, 6> chi, cyclat const &r_mesh, long t_begin, long t_end) {
+      if (t_begin >= t_end) return;
+      long n_r = chi.extent(1), n_others = chi.size() / (chi.extent(0) * n_r);
+
+      auto dims  = stdutil::make_std_array<int>(r_mesh.dims());
+      auto slice = [&](long t) { return reinterpret_cast<fftw_complex *>(&chi(t, 0, 0, 0, 0, 0)); };
+      auto lock  = std::unique_lock{fftw_planner_mutex()};
+      auto p     = fftw_plan_many_dft(3, dims.data(), n_others, slice(t_begin), NULL, n_others, 1, slice(t_begin), NULL, n_others, 1, FFTW_BACKWARD,
+                                      FFTW_ESTIMATE);
+      lock.unlock();
+
+#pragma omp parallel for schedule(static)
+      for (long t = t_begin; t < t_end; ++t) fftw_execute_dft(p, slice(t), slice(t));
+
+      lock.lock();
+      fftw_destroy_plan(p);
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  gf<prod<imtime, cyclat>, tensor_valued<4>> make_bubble(gf_const_view<prod<imtime, cyclat>, matrix_valued> g_tr, bubble_channel channel,
+                                                        mpi::communicator c) {
+    auto const &tau_mesh = std::get<0>(g_tr.mesh());
+    auto const &r_mesh   = std::get<1>(g_tr.mesh());
+    EXPECTS(tau_mesh.statistic() == Fermion);
+
+    long N        = g_tr.target_shape()[0];
+    auto b_mesh   = imtime{tau_mesh.beta(), Boson, tau_mesh.size()};
+    auto chi_tr   = gf<prod<imtime, cyclat>, tensor_valued<4>>{{b_mesh, r_mesh}, {N, N, N, N}};
+    chi_tr.data() = 0;
+
+    auto [t_begin, t_end] = itertools::chunk_range(0, tau_mesh.size(), c.size(), c.rank());
+    bubble_product(g_tr.data(), chi_tr.data(), channel, r_mesh, t_begin, t_end);
+
+    if (c.size() > 1) mpi::all_reduce_in_place(chi_tr.data(), c);
+    return chi_tr;
+  }
+
+  //-------------------------------------------------------
+
+  gf<prod<imfreq, brzone>, tensor_valued<4>> make_bubble(gf_const_view<prod<imfreq, brzone>, matrix_valued> g_wk, bubble_channel channel, long n_iW,
+                                                        long n_tau, mpi::communicator c) {
+    auto const &iw_mesh = std::get<0>(g_wk.mesh());
+    auto const &k_mesh  = std::get<1>(g_wk.mesh());
+    EXPECTS(iw_mesh.statistic() == Fermion);
+
+    // G(iw, k) -> G(tau, r)
+    auto tau_mesh = make_adjoint_mesh(iw_mesh, n_tau);
+    auto r_mesh   = make_adjoint_mesh(k_mesh);
+    auto g_tk     = make_gf_from_fourier<0>(g_wk, tau_mesh);
+    auto g_tr     = make_gf_from_fourier<1>(g_tk(), r_mesh);
+
+    // chi(tau, r) -> chi(tau, q) on the local time slice
+    long N        = g_wk.target_shape()[0];
+    auto b_mesh   = imtime{tau_mesh.beta(), Boson, tau_mesh.size()};
+    auto chi_tq   = gf<prod<imtime, brzone>, tensor_valued<4>>{{b_mesh, k_mesh}, {N, N, N, N}};
+    chi_tq.data() = 0;
+
+    auto [t_begin, t_end] = itertools::chunk_range(0, tau_mesh.size(), c.size(), c.rank());
+    bubble_product(g_tr.data(), chi_tq.data(), channel, r_mesh, t_begin, t_end);
+    fourier_r_to_q(chi_tq.data(), r_mesh, t_begin, t_end);
+    if (c.size() > 1) mpi::all_reduce_in_place(chi_tq.data(), c);
+
+    // chi(tau, q) -> chi(iW, q), distributing the columns (q, abcd) of the flattened data
+    auto iW_mesh  = imfreq{tau_mesh.beta(), Boson, n_iW};
+    auto chi_wq   = gf<prod<imfreq, brzone>, tensor_valued<4>>{{iW_mesh, k_mesh}, {N, N, N, N}};
+    chi_wq.data() = 0;
+
+    long n_cols  = chi_tq.data().size() / b_mesh.size();
+    auto chi_tfl = nda::array_view<dcomplex, 2>{std::array{b_mesh.size(), n_cols}, chi_tq.data().data()};
+    auto chi_wfl = nda::array_view<dcomplex, 2>{std::array{iW_mesh.size(), n_cols}, chi_wq.data().data()};
+
+    auto [c_begin, c_end] = itertools::chunk_range(0, n_cols, c.size(), c.rank());
+    if (c_begin < c_end) {
+      auto cols                 = range(c_begin, c_end);
+      auto chi_w                = _fourier_impl(iW_mesh, gf_vec_cvt<imtime>{b_mesh, chi_tfl(range::all, cols)});
+      chi_wfl(range::all, cols) = chi_w.data();
+    }
+    if (c.size() > 1) mpi::all_reduce_in_place(chi_wq.data(), c);
+
+    return chi_wq;
+  }
+
+} // namespace triqs::gfs
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include "./fourier.hpp"
+#include <mpi/mpi.hpp>
+
+namespace triqs::gfs {
+
+  /// The channel of a two-particle bubble
+  enum class bubble_channel { PH, PP };
+
+  /**
+   * Bubble of a lattice Green function in imaginary time and real space
+   *
+   *   PH : $$ \chi_{abcd}(\tau, r) = G_{da}(\beta - \tau, -r) G_{bc}(\tau, r) $$
+   *   PP : $$ \chi_{abcd}(\tau, r) = G_{ac}(\tau, r) G_{bd}(\tau, r) $$
+   *
+   * The product is threaded, and the imaginary time points are distributed over the communicator.
+   *
+   * @param g_tr The fermionic Green function $G(\tau, r)$
+   * @param channel The particle-hole or particle-particle channel
+   * @param c The mpi communicator
+   * @return The bosonic bubble $\chi(\tau, r)$
+   */
+  gf<prod<imtime, cyclat>, tensor_valued<4>> make_bubble(gf_const_view<prod<imtime, cyclat>, matrix_valued> g_tr, bubble_channel channel,
+                                                        mpi::communicator c = {});
+
+  /**
+   * Bubble of a lattice Green function in Matsubara frequencies and momentum
+   *
+   *   PH : $$ \chi_{abcd}(i\nu, q) = -\frac{1}{N_k \beta} \sum_{k, i\omega} G_{da}(i\omega, k) G_{bc}(i\omega + i\nu, k + q) $$
+   *   PP : $$ \chi_{abcd}(i\nu, q) = \frac{1}{N_k \beta} \sum_{k, i\omega} G_{ac}(i\omega, k) G_{bd}(i\nu - i\omega, q - k) $$
+   *
+   * The sum is evaluated as a product in $(\tau, r)$ with cost $O(N \log N)$ in the number of mesh points.
+   * The product and the spatial transform are distributed over the imaginary time points,
+   * the transform to Matsubara frequencies is distributed over the momenta and orbitals.
+   *
+   * @param g_wk The fermionic Green function $G(i\omega, k)$ on a full Matsubara mesh
+   * @param channel The particle-hole or particle-particle channel
+   * @param n_iW The number of positive bosonic Matsubara frequencies of the result
+   * @param n_tau The number of imaginary time points used for the transforms (default: 6 * n_iw + 1)
+   * @param c The mpi communicator
+   * @return The bosonic bubble $\chi(i\nu, q)$
+   */
+  gf<prod<imfreq, brzone>, tensor_valued<4>> make_bubble(gf_const_view<prod<imfreq, brzone>, matrix_valued> g_wk, bubble_channel channel, long n_iW,
+                                                        long n_tau = -1, mpi::communicator c = {});
+
+} // namespace triqs::gfs
@@ -22,25 +22,35 @@
 
 namespace triqs::gfs {
 
+  std::mutex &fftw_planner_mutex() {
+    static std::mutex m;
+    return m;
+  }
+
   void _fourier_base(array_const_view<dcomplex, 2> in, array_view<dcomplex, 2> out, int rank, int *dims, int fftw_count, int fftw_backward_forward) {
 
     auto in_fft  = reinterpret_cast<fftw_complex *>(const_cast<dcomplex *>(in.data()));
     auto out_fft = reinterpret_cast<fftw_complex *>(out.data());
 
-    auto p = fftw_plan_many_dft(rank,                        // rank
-                                dims,                        // the dimension
-                                fftw_count,                  // how many FFT : here 1
-                                in_fft,                      // in data
-                                NULL,                        // embed : unused. Doc unclear ?
-                                in.indexmap().strides()[0],  // stride of the in data
-                                1,                           // in : shift for multi fft.
-                                out_fft,                     // out data
-                                NULL,                        // embed : unused. Doc unclear ?
-                                out.indexmap().strides()[0], // stride of the out data
-                                1,                           // out : shift for multi fft.
-                                fftw_backward_forward, FFTW_ESTIMATE);
+    auto lock = std::unique_lock{fftw_planner_mutex()};
+    auto p    = fftw_plan_many_dft(rank,                        // rank
+                                   dims,                        // the dimension
+                                   fftw_count,                  // how many FFT : here 1
+                                   in_fft,                      // in data
+                                   NULL,                        // embed : unused. Doc unclear ?
+                                   in.indexmap().strides()[0],  // stride of the in data
+                                   1,                           // in : shift for multi fft.
+                                   out_fft,                     // out data
+                                   NULL,                        // embed : unused. Doc unclear ?
+                                   out.indexmap().strides()[0], // stride of the out data
+                                   1,                           // out : shift for multi fft.
+                                   fftw_backward_forward, FFTW_ESTIMATE);
+
+    lock.unlock();
 
     fftw_execute(p);
+
+    lock.lock();
     fftw_destroy_plan(p);
   }
 
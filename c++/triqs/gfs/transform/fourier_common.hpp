@@ -21,10 +21,15 @@
 #include <triqs/arrays.hpp>
 // include only in cpp implementation
 #include <fftw3.h>
+#include <mutex>
 
 namespace triqs::gfs {
 
   using namespace triqs::arrays;
+
+  // The fftw planner is not thread-safe: plans must be created and destroyed holding this lock (fftw_execute is thread-safe)
+  std::mutex &fftw_planner_mutex();
+
   // call to fftw
   void _fourier_base(array_const_view<dcomplex, 2> in, array_view<dcomplex, 2> out, int rank, int *dims, int fftw_count, int fftw_backward_forward);
 
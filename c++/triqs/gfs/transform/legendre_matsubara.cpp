@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "../../gfs.hpp"
+#include "./legendre_matsubara.hpp"
+#include <triqs/utility/bounded_cache.hpp>
+
+#include <tuple>
+
+namespace triqs::gfs {
+
+  namespace {
+
+    // Size of the process-wide caches of transformation matrices, keyed by their defining parameters
+    constexpr long matrix_cache_size = 64;
+
+  } // namespace
+
+  std::shared_ptr<nda::matrix<dcomplex> const> legendre_T_matrix(long first_index, long n_w, long n_l) {
+    static utility::bounded_cache<std::tuple<long, long, long>, nda::matrix<dcomplex>> cache{matrix_cache_size};
+    return cache.get({first_index, n_w, n_l}, [&] {
+      auto T = nda::matrix<dcomplex>(n_w, n_l);
+      for (long n = 0; n < n_w; ++n)
+        for (long l = 0; l < n_l; ++l) T(n, l) = utility::legendre_T(first_index + n, l);
+      return T;
+    });
+  }
+
+  std::shared_ptr<nda::matrix<double> const> legendre_P_matrix(long n_tau, long n_l) {
+    static utility::bounded_cache<std::tuple<long, long>, nda::matrix<double>> cache{matrix_cache_size};
+    return cache.get({n_tau, n_l}, [&] {
+      auto P = nda::matrix<double>(n_tau, n_l);
+      utility::legendre_generator L;
+      for (long i = 0; i < n_tau; ++i) {
+        L.reset(n_tau > 1 ? 2.0 * i / (n_tau - 1) - 1 : -1.0);
+        for (long l = 0; l < n_l; ++l) P(i, l) = std::sqrt(2 * l + 1) * L.next();
+      }
+      return P;
+    });
+  }
+
+} // namespace triqs::gfs
@@ -21,11 +21,25 @@
 
 #include <triqs/utility/legendre.hpp>
 #include "../../gfs.hpp"
+#include "../gf/flatten.hpp"
 
 #include <cmath>
+#include <memory>
 
 namespace triqs::gfs {
 
+  /**
+   * Transformation matrix T_{nl} of Eq.(E2), for the Matsubara indices n in [first_index, first_index + n_w)
+   * and the Legendre indices l in [0, n_l). The matrix is kept in a bounded process-wide cache.
+   */
+  std::shared_ptr<nda::matrix<dcomplex> const> legendre_T_matrix(long first_index, long n_w, long n_l);
+
+  /**
+   * Matrix sqrt(2l + 1) P_l(x_i) on the n_tau equidistant points x_i of [-1, 1],
+   * for the Legendre indices l in [0, n_l). The matrix is kept in a bounded process-wide cache.
+   */
+  std::shared_ptr<nda::matrix<double> const> legendre_P_matrix(long n_tau, long n_l);
+
   // FIXME  REMOVE TAG AND gf_keeper
   namespace tags {
     struct legendre {};
@@ -41,12 +55,10 @@ namespace triqs::gfs {
     static_assert(std::is_same_v<typename std::decay_t<G1>::target_t, typename std::decay_t<G2>::target_t>,
                   "Arguments to legendre_matsubara_direct require same target_t");
 
-    gw() = 0.0;
-
-    // Use the transformation matrix
-    for (auto om : gw.mesh()) {
-      for (auto l : gl.mesh()) { gw[om] += triqs::utility::legendre_T(om.index(), l.index()) * gl[l]; }
-    }
+    // G(iw_n) = \sum_l T_{nl} G_l, as one matrix product over all target elements
+    auto T    = legendre_T_matrix(gw.mesh().first_index(), gw.mesh().size(), gl.mesh().size());
+    auto gl_2 = nda::matrix<dcomplex>{flatten_2d(gl.data())};
+    unflatten_2d(gw.data(), nda::matrix<dcomplex>{(*T) * gl_2});
   }
 
   // ----------------------------
@@ -59,13 +71,13 @@ namespace triqs::gfs {
     static_assert(std::is_same_v<typename std::decay_t<G1>::target_t, typename std::decay_t<G2>::target_t>,
                   "Arguments to legendre_matsubara_direct require same target_t");
 
-    gt() = 0.0;
-    utility::legendre_generator L;
-
-    for (auto t : gt.mesh()) {
-      L.reset(2 * t / gt.mesh().beta() - 1);
-      for (auto l : gl.mesh()) { gt[t] += std::sqrt(2 * l.index() + 1) / gt.mesh().beta() * gl[l] * L.next(); }
-    }
+    // G(tau_i) = 1/beta \sum_l sqrt(2l+1) P_l(x_i) G_l, as one matrix product over all target elements
+    using scalar_t = typename std::decay_t<G2>::scalar_t;
+    auto P         = legendre_P_matrix(gt.mesh().size(), gl.mesh().size());
+    auto gl_2      = nda::matrix<scalar_t>{flatten_2d(gl.data())};
+    auto gt_2      = nda::matrix<scalar_t>{nda::matrix<scalar_t>{*P} * gl_2};
+    gt_2 /= gt.mesh().beta();
+    unflatten_2d(gt.data(), gt_2);
   }
 
   // ----------------------------
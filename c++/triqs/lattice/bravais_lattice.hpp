@@ -57,10 +57,10 @@ namespace triqs::lattice {
     long n_orbitals() const { return long(atom_orb_name.size()); }
 
     /// Return the vector of orbital positions
-    std::vector<r_t> const &orbital_positions() { return atom_orb_pos; }
+    std::vector<r_t> const &orbital_positions() const { return atom_orb_pos; }
 
     /// Return the vector of orbital names
-    std::vector<std::string> const &orbital_names() { return atom_orb_name; }
+    std::vector<std::string> const &orbital_names() const { return atom_orb_name; }
 
     // -------------------- Point ---------------------
 
@@ -0,0 +1,276 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "./lattice_gf.hpp"
+#include <nda/linalg/eigenelements.hpp>
+#include <itertools/itertools.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace triqs::lattice {
+
+  using namespace gfs;
+  using nda::range;
+
+  namespace {
+
+    // Matrices up to this size are inverted by an inline Gauss-Jordan elimination, larger ones by lapack
+    constexpr long max_small_matrix = 16;
+
+    // Number of momenta for which h_k is evaluated at once
+    constexpr long batch_size = 64;
+
+    // In-place inverse of the n x n row-major matrix a, by Gauss-Jordan elimination with partial pivoting.
+    // piv is a workspace of size n.
+    void invert_small_in_place(dcomplex *a, long n, long *piv) {
+      for (long col = 0; col < n; ++col) {
+        long p      = col;
+        double best = std::norm(a[col * n + col]);
+        for (long r = col + 1; r < n; ++r)
+          if (std::norm(a[r * n + col]) > best) {
+            best = std::norm(a[r * n + col]);
+            p    = r;
+          }
+        piv[col] = p;
+        if (p != col)
+          for (long j = 0; j < n; ++j) std::swap(a[p * n + j], a[col * n + j]);
+
+        auto inv         = 1.0 / a[col * n + col];
+        a[col * n + col] = 1.0;
+        for (long j = 0; j < n; ++j) a[col * n + j] *= inv;
+        for (long r = 0; r < n; ++r) {
+          if (r == col) continue;
+          auto f         = a[r * n + col];
+          a[r * n + col] = 0.0;
+          for (long j = 0; j < n; ++j) a[r * n + j] -= f * a[col * n + j];
+        }
+      }
+      // The row swaps of the elimination become column swaps of the inverse, in reverse order
+      for (long col = n - 1; col >= 0; --col)
+        if (piv[col] != col)
+          for (long r = 0; r < n; ++r) std::swap(a[r * n + piv[col]], a[r * n + col]);
+    }
+
+    // The thread-local buffers of the evaluation of G(k, iw)
+    struct g_k_workspace {
+      nda::array<dcomplex, 3> g;
+      std::vector<long> piv;
+    };
+
+    // Evaluation of G(k, iw) for the momenta of the rank, in batches
+    struct g_k_evaluator {
+      tight_binding const &tb;
+      double mu;
+      nda::array_const_view<dcomplex, 3> sigma_data;
+      nda::vector<dcomplex> iw;
+      nda::matrix<double> kvecs; // in units of the reciprocal lattice vectors
+      long N, k_begin, k_end, n_batches;
+
+      g_k_evaluator(tight_binding const &tb, brzone const &k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma, mpi::communicator c)
+         : tb(tb), mu(mu), sigma_data(sigma.data()), iw(sigma.mesh().size()), N(tb.n_orbitals()) {
+        if (sigma.target_shape()[0] != N or sigma.target_shape()[1] != N)
+          TRIQS_RUNTIME_ERROR << "lattice Green function: the self-energy has the target shape " << sigma.target_shape() << " for " << N
+                              << " orbitals";
+        for (auto w : sigma.mesh()) iw(w.data_index()) = dcomplex(w);
+
+        auto k_abs = nda::matrix<double>(k_mesh.size(), 3);
+        for (auto [n, k] : itertools::enumerate(k_mesh)) k_abs(n, range::all) = k.value();
+        kvecs = k_abs * k_mesh.bz().reciprocal_matrix_inv();
+
+        std::tie(k_begin, k_end) = itertools::chunk_range(0, k_mesh.size(), c.size(), c.rank());
+        n_batches                = (k_end - k_begin + batch_size - 1) / batch_size;
+      }
+
+      [[nodiscard]] g_k_workspace workspace() const { return {nda::array<dcomplex, 3>(iw.size(), N, N), std::vector<long>(N)}; }
+
+      // Calls f(ik, h_k, g_k) for each momentum of the batch b, with g_k(w, a, b) = G(k, iw) in the workspace
+      template <typename F> void operator()(long b, g_k_workspace &ws, F &&f) const {
+        auto k_range = range(k_begin + b * batch_size, std::min(k_begin + (b + 1) * batch_size, k_end));
+        auto h       = tb.fourier(kvecs(k_range, range::all));
+        for (auto [n, ik] : itertools::enumerate(k_range)) {
+          auto h_k = h(n, range::all, range::all);
+          for (long w = 0; w < iw.size(); ++w) {
+            auto *g = &ws.g(w, 0, 0);
+            for (long a = 0; a < N; ++a)
+              for (long c = 0; c < N; ++c) g[a * N + c] = -h_k(a, c) - sigma_data(w, a, c);
+            for (long a = 0; a < N; ++a) g[a * N + a] += iw(w) + mu;
+            if (N <= max_small_matrix)
+              invert_small_in_place(g, N, ws.piv.data());
+            else
+              ws.g(w, range::all, range::all) = nda::inverse(nda::matrix<dcomplex>{ws.g(w, range::all, range::all)});
+          }
+          f(ik, h_k, ws.g);
+        }
+      }
+    };
+
+    // The number of chunks of the batches [0, n_batches), one per thread
+    long n_chunks(long n_batches) {
+#ifdef _OPENMP
+      return std::min<long>(n_batches, omp_get_max_threads());
+#else
+      return std::min<long>(n_batches, 1);
+#endif
+    }
+
+    // Calls f(i, batches) for the contiguous chunks i of the batches [0, n_batches), in parallel.
+    // The exception of the first failing chunk is rethrown after all chunks, cf. gfs::details::for_each_block.
+    template <typename F> void for_each_chunk(long n_batches, F &&f) {
+      long n = n_chunks(n_batches);
+      gfs::details::for_each_block(n, gfs::block_exec_policy::parallel, [&](long i) {
+        auto [b_begin, b_end] = itertools::chunk_range(0, n_batches, n, i);
+        f(i, range(b_begin, b_end));
+      });
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  gf<prod<brzone, imfreq>, matrix_valued> make_lattice_gf(tight_binding const &tb, brzone const &k_mesh, double mu,
+                                                          gf_const_view<imfreq, matrix_valued> sigma, mpi::communicator c) {
+    auto ev    = g_k_evaluator{tb, k_mesh, mu, sigma, c};
+    auto res   = gf<prod<brzone, imfreq>, matrix_valued>{{k_mesh, sigma.mesh()}, {ev.N, ev.N}};
+    res.data() = 0;
+
+    for_each_chunk(ev.n_batches, [&](long, range batches) {
+      auto ws = ev.workspace();
+      for (long b : batches) ev(b, ws, [&](long ik, auto const &, auto const &g_k) { res.data()(ik, nda::ellipsis()) = g_k; });
+    });
+
+    if (c.size() > 1) mpi::all_reduce_in_place(res.data(), c);
+    return res;
+  }
+
+  //-------------------------------------------------------
+
+  gf<imfreq, matrix_valued> make_lattice_gf_local(tight_binding const &tb, brzone const &k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma,
+                                                  mpi::communicator c) {
+    auto ev    = g_k_evaluator{tb, k_mesh, mu, sigma, c};
+    auto res   = gf<imfreq, matrix_valued>{sigma.mesh(), {ev.N, ev.N}};
+    res.data() = 0;
+
+    // Each chunk accumulates into its own sum, the sums are added in the order of the chunks
+    auto g_locs = std::vector<nda::array<dcomplex, 3>>(n_chunks(ev.n_batches));
+    for_each_chunk(ev.n_batches, [&](long i, range batches) {
+      auto ws   = ev.workspace();
+      g_locs[i] = nda::array<dcomplex, 3>::zeros(ws.g.shape());
+      for (long b : batches) ev(b, ws, [&](long, auto const &, auto const &g_k) { g_locs[i] += g_k; });
+    });
+    for (auto const &g_loc : g_locs) res.data() += g_loc;
+
+    if (c.size() > 1) mpi::all_reduce_in_place(res.data(), c);
+    res.data() /= double(k_mesh.size());
+    return res;
+  }
+
+  //-------------------------------------------------------
+
+  std::vector<gf<imfreq, matrix_valued>> make_lattice_gf_real_space(tight_binding const &tb, brzone const &k_mesh, double mu,
+                                                                    gf_const_view<imfreq, matrix_valued> sigma,
+                                                                    std::vector<nda::vector<long>> const &R_vec, mpi::communicator c) {
+    auto ev  = g_k_evaluator{tb, k_mesh, mu, sigma, c};
+    long n_R = R_vec.size();
+    int ndim = tb.lattice().ndim();
+    for (auto const &R : R_vec)
+      if (R.size() != ndim) TRIQS_RUNTIME_ERROR << "make_lattice_gf_real_space: displacement " << R << " of incorrect size, instead of " << ndim;
+
+    auto g_R = nda::array<dcomplex, 4>::zeros(n_R, sigma.mesh().size(), ev.N, ev.N);
+
+    // Each chunk accumulates into its own sum, the sums are added in the order of the chunks
+    auto g_R_locs = std::vector<nda::array<dcomplex, 4>>(n_chunks(ev.n_batches));
+    for_each_chunk(ev.n_batches, [&](long i, range batches) {
+      auto ws     = ev.workspace();
+      g_R_locs[i] = nda::array<dcomplex, 4>::zeros(g_R.shape());
+      for (long b : batches)
+        ev(b, ws, [&](long ik, auto const &, auto const &g_k) {
+          for (long r = 0; r < n_R; ++r) {
+            double k_R = 0;
+            for (int d = 0; d < ndim; ++d) k_R += ev.kvecs(ik, d) * R_vec[r](d);
+            g_R_locs[i](r, nda::ellipsis()) += std::exp(-2i * M_PI * k_R) * g_k;
+          }
+        });
+    });
+    for (auto const &g_R_loc : g_R_locs) g_R += g_R_loc;
+
+    if (c.size() > 1) mpi::all_reduce_in_place(g_R, c);
+    g_R /= double(k_mesh.size());
+
+    auto res = std::vector<gf<imfreq, matrix_valued>>{};
+    res.reserve(n_R);
+    for (long r = 0; r < n_R; ++r) {
+      auto g   = gf<imfreq, matrix_valued>{sigma.mesh(), {ev.N, ev.N}};
+      g.data() = g_R(r, nda::ellipsis());
+      res.push_back(std::move(g));
+    }
+    return res;
+  }
+
+  //-------------------------------------------------------
+
+  gf<brzone, matrix_valued> lattice_density(tight_binding const &tb, brzone const &k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma,
+                                            mpi::communicator c) {
+    if (sigma.mesh().positive_only()) TRIQS_RUNTIME_ERROR << "lattice_density: the self-energy must be given on a full Matsubara mesh";
+
+    auto ev     = g_k_evaluator{tb, k_mesh, mu, sigma, c};
+    long N      = ev.N;
+    long n_w    = sigma.mesh().size();
+    double beta = sigma.mesh().beta();
+    auto res    = gf<brzone, matrix_valued>{k_mesh, {N, N}};
+    res.data()  = 0;
+
+    // The hermitian part of the self-energy at the largest frequency, minus mu
+    auto s_last = nda::matrix<dcomplex>{sigma.data()(n_w - 1, range::all, range::all)};
+    auto shift  = nda::matrix<dcomplex>{0.5 * (s_last + dagger(s_last)) - mu * nda::eye<dcomplex>(N)};
+
+    for_each_chunk(ev.n_batches, [&](long, range batches) {
+      auto ws = ev.workspace();
+      for (long b : batches)
+        ev(b, ws, [&](long ik, auto const &h_k, auto const &g_k) {
+          // Free Green function U (iw - eps)^{-1} U^+ of h_k + sigma_inf - mu
+          auto [eps, U] = nda::linalg::eigenelements(nda::matrix<dcomplex>{nda::make_matrix_view(h_k) + shift});
+
+          // Its exact density minus its Matsubara sum, for each eigenvalue
+          auto coef = nda::vector<dcomplex>(N);
+          for (long l = 0; l < N; ++l) {
+            dcomplex sum = 0;
+            for (long w = 0; w < n_w; ++w) sum += 1.0 / (ev.iw(w) - eps(l));
+            coef(l) = 1.0 / (1.0 + std::exp(beta * eps(l))) - sum / beta;
+          }
+
+          auto n_k = res.data()(ik, range::all, range::all);
+          for (long a = 0; a < N; ++a)
+            for (long d = 0; d < N; ++d) {
+              dcomplex n = 0;
+              for (long w = 0; w < n_w; ++w) n += g_k(w, a, d) / beta;
+              for (long l = 0; l < N; ++l) n += U(a, l) * coef(l) * std::conj(U(d, l));
+              n_k(a, d) = n;
+            }
+        });
+    });
+
+    if (c.size() > 1) mpi::all_reduce_in_place(res.data(), c);
+    return res;
+  }
+
+} // namespace triqs::lattice
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include "./tight_binding.hpp"
+#include <mpi/mpi.hpp>
+#include <vector>
+
+namespace triqs::lattice {
+
+  /**
+   * The lattice Green function of a tight-binding Hamiltonian with a local self-energy
+   *
+   *   $$ G_{ab}(k, i\omega_n) = [(i\omega_n + \mu - h_k - \Sigma(i\omega_n))^{-1}]_{ab} $$
+   *
+   * The momenta are distributed over the communicator, and streamed in batches over the threads:
+   * h_k is evaluated for a batch of momenta, and the small matrices are inverted for each (k, iw)
+   * without allocation. The reductions below use the same evaluation without storing G(k, iw).
+   *
+   * @param tb The tight-binding Hamiltonian
+   * @param k_mesh The Brillouin-zone mesh
+   * @param mu The chemical potential
+   * @param sigma The local self-energy, which defines the Matsubara mesh (zero for the free Green function)
+   * @param c The mpi communicator
+   * @return The Green function $G(k, i\omega_n)$ on all ranks
+   */
+  gfs::gf<mesh::prod<mesh::brzone, mesh::imfreq>, gfs::matrix_valued> make_lattice_gf(tight_binding const &tb, mesh::brzone const &k_mesh, double mu,
+                                                                                      gfs::gf_const_view<mesh::imfreq, gfs::matrix_valued> sigma,
+                                                                                      mpi::communicator c = {});
+
+  /**
+   * The local lattice Green function $G(i\omega_n) = \frac{1}{N_k} \sum_k G(k, i\omega_n)$, cf. make_lattice_gf
+   *
+   * @param tb The tight-binding Hamiltonian
+   * @param k_mesh The Brillouin-zone mesh
+   * @param mu The chemical potential
+   * @param sigma The local self-energy, which defines the Matsubara mesh
+   * @param c The mpi communicator
+   * @return The local Green function on all ranks
+   */
+  gfs::gf<mesh::imfreq, gfs::matrix_valued> make_lattice_gf_local(tight_binding const &tb, mesh::brzone const &k_mesh, double mu,
+                                                                  gfs::gf_const_view<mesh::imfreq, gfs::matrix_valued> sigma, mpi::communicator c = {});
+
+  /**
+   * The Green function in real space $G(R, i\omega_n) = \frac{1}{N_k} \sum_k e^{-2 \pi i k \cdot R} G(k, i\omega_n)$, cf. make_lattice_gf
+   *
+   * Only the given displacements are accumulated, which keeps the memory independent of the number of momenta.
+   * The sign of the phase is the one of the Fourier transform from a brzone to a cyclat mesh.
+   *
+   * @param tb The tight-binding Hamiltonian
+   * @param k_mesh The Brillouin-zone mesh
+   * @param mu The chemical potential
+   * @param sigma The local self-energy, which defines the Matsubara mesh
+   * @param R_vec The displacements R in units of the lattice basis vectors
+   * @param c The mpi communicator
+   * @return The Green functions $G(R, i\omega_n)$ for all displacements, on all ranks
+   */
+  std::vector<gfs::gf<mesh::imfreq, gfs::matrix_valued>> make_lattice_gf_real_space(tight_binding const &tb, mesh::brzone const &k_mesh, double mu,
+                                                                                     gfs::gf_const_view<mesh::imfreq, gfs::matrix_valued> sigma,
+                                                                                     std::vector<nda::vector<long>> const &R_vec,
+                                                                                     mpi::communicator c = {});
+
+  /**
+   * The density matrix $n_{ab}(k) = \langle c^\dagger_{kb} c_{ka} \rangle$ of the lattice Green function, cf. make_lattice_gf
+   *
+   * The Matsubara sum is done on the difference with the free Green function of $h_k + \Sigma_\infty$,
+   * whose density is known analytically. $\Sigma_\infty$ is the hermitian part of the self-energy
+   * at the largest Matsubara frequency.
+   *
+   * @param tb The tight-binding Hamiltonian
+   * @param k_mesh The Brillouin-zone mesh
+   * @param mu The chemical potential
+   * @param sigma The local self-energy on a full Matsubara mesh
+   * @param c The mpi communicator
+   * @return The density matrix for all momenta, on all ranks
+   */
+  gfs::gf<mesh::brzone, gfs::matrix_valued> lattice_density(tight_binding const &tb, mesh::brzone const &k_mesh, double mu,
+                                                            gfs::gf_const_view<mesh::imfreq, gfs::matrix_valued> sigma, mpi::communicator c = {});
+
+} // namespace triqs::lattice
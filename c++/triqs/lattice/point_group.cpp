@@ -0,0 +1,208 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "./point_group.hpp"
+#include <itertools/itertools.hpp>
+
+#include <cmath>
+
+namespace triqs::lattice {
+
+  using nda::range;
+
+  namespace {
+
+    // The matrix W without the row i and the column j
+    nda::matrix<long> minor_matrix(nda::matrix<long> const &W, long i, long j) {
+      long n   = W.extent(0);
+      auto res = nda::matrix<long>(n - 1, n - 1);
+      for (long r = 0, r2 = 0; r < n; ++r) {
+        if (r == i) continue;
+        for (long c = 0, c2 = 0; c < n; ++c) {
+          if (c == j) continue;
+          res(r2, c2++) = W(r, c);
+        }
+        ++r2;
+      }
+      return res;
+    }
+
+    // The determinant of a small integer matrix, by the expansion along its first row
+    long int_determinant(nda::matrix<long> const &W) {
+      long n = W.extent(0);
+      if (n == 0) return 1;
+      long res = 0;
+      for (long j = 0; j < n; ++j) res += (j % 2 == 0 ? 1 : -1) * W(0, j) * int_determinant(minor_matrix(W, 0, j));
+      return res;
+    }
+
+    // The matrix W^{-T} of an integer matrix with determinant +-1, from its cofactors
+    nda::matrix<long> inverse_transpose(nda::matrix<long> const &W) {
+      long n   = W.extent(0);
+      long det = int_determinant(W);
+      auto res = nda::matrix<long>(n, n);
+      for (long i = 0; i < n; ++i)
+        for (long j = 0; j < n; ++j) res(i, j) = det * ((i + j) % 2 == 0 ? 1 : -1) * int_determinant(minor_matrix(W, i, j));
+      return res;
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  std::vector<point_group_op> point_group(bravais_lattice const &bl, double tol) {
+    int ndim          = bl.ndim();
+    long n_orb        = bl.n_orbitals();
+    auto r            = range(ndim);
+    auto const &names = bl.orbital_names();
+
+    // The metric of the lattice vectors
+    auto A       = nda::matrix<double>{bl.units()(r, r)};
+    auto G       = nda::matrix<double>{A * transpose(A)};
+    double g_max = max_element(abs(G));
+
+    // The orbital positions in lattice coordinates
+    auto x = std::vector<nda::vector<double>>{};
+    for (auto const &p : bl.orbital_positions()) {
+      if (p.size() < ndim) TRIQS_RUNTIME_ERROR << "point_group: the orbital position " << p << " has less than " << ndim << " components";
+      x.emplace_back(bl.real_to_lattice_coordinates(p)(r));
+    }
+
+    // Orbitals with the same name at the same position are mapped onto each other in their order
+    auto is_integer = [tol](nda::vector<double> const &v) {
+      for (double y : v)
+        if (std::abs(y - std::round(y)) >= tol) return false;
+      return true;
+    };
+    auto rank = std::vector<long>(n_orb, 0);
+    for (long a = 0; a < n_orb; ++a)
+      for (long b = 0; b < a; ++b)
+        if (names[a] == names[b] and max_element(abs(x[a] - x[b])) < tol) ++rank[a];
+
+    // Enumerate the integer matrices with entries -1, 0, 1
+    auto res = std::vector<point_group_op>{};
+    long n_W = std::lround(std::pow(3, ndim * ndim));
+    for (long code = 0; code < n_W; ++code) {
+      auto W  = nda::matrix<long>(ndim, ndim);
+      auto Wd = nda::matrix<double>(ndim, ndim);
+      for (long c = code, i = 0; i < ndim * ndim; ++i, c /= 3) W(i / ndim, i % ndim) = c % 3 - 1;
+      if (std::abs(int_determinant(W)) != 1) continue;
+      for (long i = 0; i < ndim; ++i)
+        for (long j = 0; j < ndim; ++j) Wd(i, j) = W(i, j);
+      if (max_element(abs(transpose(Wd) * G * Wd - G)) > tol * g_max) continue;
+
+      // Map the orbitals
+      auto op  = point_group_op{W, std::vector<long>(n_orb), std::vector<nda::vector<long>>(n_orb)};
+      auto hit = std::vector<bool>(n_orb, false);
+      bool ok  = true;
+      for (long a = 0; a < n_orb and ok; ++a) {
+        auto y    = nda::vector<double>{Wd * x[a]};
+        long seen = 0;
+        ok        = false;
+        for (long b = 0; b < n_orb; ++b) {
+          auto dx = nda::vector<double>{y - x[b]};
+          if (names[b] != names[a] or not is_integer(dx)) continue;
+          if (seen++ < rank[a]) continue;
+          if (hit[b]) break;
+          hit[b]      = true;
+          op.perm[a]  = b;
+          op.shift[a] = nda::vector<long>(ndim);
+          for (int d = 0; d < ndim; ++d) op.shift[a](d) = std::lround(dx(d));
+          ok = true;
+          break;
+        }
+      }
+      if (not ok) continue;
+
+      if (W == nda::matrix<long>{nda::eye<long>(ndim)})
+        res.insert(res.begin(), std::move(op));
+      else
+        res.push_back(std::move(op));
+    }
+    return res;
+  }
+
+  //-------------------------------------------------------
+
+  irreducible_kgrid::irreducible_kgrid(mesh::brzone k_mesh, std::vector<point_group_op> const &ops) : k_mesh_(std::move(k_mesh)) {
+    int ndim = k_mesh_.bz().lattice().ndim();
+    auto N   = k_mesh_.dims();
+
+    // The action of the operations on the mesh indices, m'_i = sum_j N_i V_ij / N_j m_j with V = W^{-T},
+    // for the operations which map the mesh onto itself
+    auto actions = std::vector<nda::matrix<long>>{};
+    for (auto const &op : ops) {
+      if (op.W.extent(0) != ndim or op.W.extent(1) != ndim)
+        TRIQS_RUNTIME_ERROR << "irreducible_kgrid: the rotation " << op.W << " is not a " << ndim << " x " << ndim << " matrix";
+      if (std::abs(int_determinant(op.W)) != 1)
+        TRIQS_RUNTIME_ERROR << "irreducible_kgrid: the rotation " << op.W << " is not invertible on the lattice";
+      auto V       = inverse_transpose(op.W);
+      auto M       = nda::matrix<long>(ndim, ndim);
+      bool on_mesh = true;
+      for (long i = 0; i < ndim; ++i)
+        for (long j = 0; j < ndim; ++j) {
+          on_mesh = on_mesh and (N[i] * V(i, j)) % N[j] == 0;
+          M(i, j) = (op.time_reversal ? -1 : 1) * N[i] * V(i, j) / N[j];
+        }
+      if (not on_mesh) continue;
+      ops_.push_back(op);
+      actions.push_back(std::move(M));
+    }
+    if (ops_.empty() or ops_[0].time_reversal or ops_[0].W != nda::matrix<long>{nda::eye<long>(ndim)})
+      TRIQS_RUNTIME_ERROR << "irreducible_kgrid: the first operation must be the identity";
+
+    // The stars of the points, in the order of the mesh
+    long n_k = k_mesh_.size();
+    irr_index_.assign(n_k, -1);
+    op_index_.assign(n_k, -1);
+    auto star_size = std::vector<long>{};
+    for (long k = 0; k < n_k; ++k) {
+      if (irr_index_[k] >= 0) continue;
+      long i = size();
+      irr_points_.push_back(k);
+      star_size.push_back(0);
+      auto m = k_mesh_.to_index(k);
+      for (auto const &[o, M] : itertools::enumerate(actions)) {
+        auto m_img = std::array<long, 3>{0, 0, 0};
+        for (long a = 0; a < ndim; ++a)
+          for (long b = 0; b < ndim; ++b) m_img[a] += M(a, b) * m[b];
+        long k_img = k_mesh_.to_data_index(k_mesh_.index_modulo(m_img));
+        if (irr_index_[k_img] >= 0) continue;
+        irr_index_[k_img] = i;
+        op_index_[k_img]  = o;
+        ++star_size[i];
+      }
+    }
+
+    weights_ = nda::vector<double>(size());
+    for (long i = 0; i < size(); ++i) weights_(i) = double(star_size[i]) / n_k;
+  }
+
+  //-------------------------------------------------------
+
+  nda::matrix<double> irreducible_kgrid::kvecs() const {
+    int ndim = k_mesh_.bz().lattice().ndim();
+    auto N   = k_mesh_.dims();
+    auto res = nda::matrix<double>(size(), ndim);
+    for (auto [i, k] : itertools::enumerate(irr_points_)) {
+      auto m = k_mesh_.to_index(k);
+      for (int d = 0; d < ndim; ++d) res(i, d) = double(m[d]) / N[d];
+    }
+    return res;
+  }
+
+} // namespace triqs::lattice
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include "./bravais_lattice.hpp"
+#include "../mesh/brzone.hpp"
+#include <vector>
+
+namespace triqs::lattice {
+
+  /**
+   * An operation of the point group of a crystal, in lattice coordinates
+   *
+   * The lattice vector R is mapped onto W R. The orbital a of the unit cell at the origin
+   * is mapped onto the orbital perm[a] of the unit cell at shift[a].
+   * With time_reversal, the operation is combined with the complex conjugation.
+   */
+  struct point_group_op {
+    /// The rotation, as an integer ndim x ndim matrix acting on the lattice coordinates
+    nda::matrix<long> W;
+
+    /// The permutation of the orbitals
+    std::vector<long> perm;
+
+    /// The lattice vectors by which the images of the orbitals are shifted
+    std::vector<nda::vector<long>> shift;
+
+    /// Is the operation combined with time reversal
+    bool time_reversal = false;
+  };
+
+  /**
+   * The point group of a Bravais lattice with its orbitals
+   *
+   * The rotations are the integer matrices W with $W^T G W = G$, where G is the metric of the lattice vectors.
+   * Only those that map each orbital onto an orbital with the same name, up to a lattice vector, are kept.
+   * The identity is the first operation.
+   *
+   * @param bl The bravais lattice
+   * @param tol The tolerance on the metric and on the orbital positions in lattice coordinates
+   * @return The operations of the point group
+   */
+  std::vector<point_group_op> point_group(bravais_lattice const &bl, double tol = 1e-6);
+
+  /**
+   * A Brillouin-zone mesh reduced to its irreducible wedge by a group of symmetry operations
+   *
+   * A rotation W maps the momentum k, in units of the reciprocal lattice vectors, onto $W^{-T} k$,
+   * and time reversal maps it onto -k. The operations that do not map the mesh onto itself are dropped.
+   * Each point of the mesh is the image of exactly one irreducible point, by a recorded operation,
+   * so quantities computed on the irreducible points can be unfolded back onto the full mesh.
+   */
+  class irreducible_kgrid {
+
+    mesh::brzone k_mesh_;
+    std::vector<point_group_op> ops_;
+    std::vector<long> irr_points_, irr_index_, op_index_;
+    nda::vector<double> weights_;
+
+    public:
+    /**
+     * Reduce a Brillouin-zone mesh with a group of operations
+     *
+     * @param k_mesh The Brillouin-zone mesh
+     * @param ops The operations, starting with the identity. They must form a group.
+     */
+    irreducible_kgrid(mesh::brzone k_mesh, std::vector<point_group_op> const &ops);
+
+    /// Reduce a Brillouin-zone mesh with the point group of its lattice
+    explicit irreducible_kgrid(mesh::brzone const &k_mesh) : irreducible_kgrid(k_mesh, point_group(k_mesh.bz().lattice())) {}
+
+    /// The full Brillouin-zone mesh
+    mesh::brzone const &k_mesh() const { return k_mesh_; }
+
+    /// The operations which map the mesh onto itself
+    std::vector<point_group_op> const &ops() const { return ops_; }
+
+    /// Number of irreducible points
+    long size() const { return long(irr_points_.size()); }
+
+    /// The data indices in k_mesh of the irreducible points
+    std::vector<long> const &irr_points() const { return irr_points_; }
+
+    /// The weights of the irreducible points, i.e. the fractions of the mesh in their stars. They sum to 1.
+    nda::vector<double> const &weights() const { return weights_; }
+
+    /// For each data index of k_mesh, the index of its irreducible point
+    std::vector<long> const &irr_index() const { return irr_index_; }
+
+    /// For each data index of k_mesh, the index of the operation which maps its irreducible point onto it
+    std::vector<long> const &op_index() const { return op_index_; }
+
+    /// The irreducible points in units of the reciprocal lattice vectors, as the rows of a (size, ndim) matrix
+    nda::matrix<double> kvecs() const;
+
+    /**
+     * Unfold an invariant quantity, e.g. the eigenvalues, from the irreducible points onto the full mesh
+     *
+     * @param x The values x(i, ...) for the irreducible points i
+     * @return The values for all data indices of k_mesh
+     */
+    template <typename A>
+      requires(nda::MemoryArray<A>)
+    auto unfold(A const &x) const {
+      EXPECTS(x.extent(0) == size());
+      auto shape = x.shape();
+      shape[0]   = k_mesh_.size();
+      auto res   = nda::array<nda::get_value_t<A>, nda::get_rank<A>>(shape);
+      for (long k = 0; k < k_mesh_.size(); ++k) res(k, nda::ellipsis()) = x(irr_index_[k], nda::ellipsis());
+      return res;
+    }
+  };
+
+} // namespace triqs::lattice
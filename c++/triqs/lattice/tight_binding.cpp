@@ -21,6 +21,22 @@
 #include <nda/algorithms.hpp>
 #include <nda/linalg/eigenelements.hpp>
 #include "grid_generator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace triqs {
   namespace lattice {
 
@@ -56,29 +72,58 @@ namespace triqs {
 
     //------------------------------------------------------
 
+    namespace {
+
+      // Calls f(k_range) for batches of the momenta [0, n_k), in parallel.
+      // The exception of the first failing batch is rethrown after all batches, cf. gfs::details::for_each_block
+      template <typename F> void foreach_batch(long n_k, F f) {
+        constexpr long batch_size = 256;
+        long n_batches            = (n_k + batch_size - 1) / batch_size;
+        gfs::details::for_each_block(n_batches, gfs::block_exec_policy::parallel,
+                                     [&](long b) { f(range(b * batch_size, std::min((b + 1) * batch_size, n_k))); });
+      }
+
+      // The number of threads of the parallel regions
+      long n_threads() {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+      }
+
+      // The points of a grid_generator, as rows
+      nda::matrix<double> grid_points(int ndim, int nkpts) {
+        grid_generator grid(ndim, nkpts);
+        auto res = nda::matrix<double>(grid.size(), ndim);
+        for (; grid; ++grid) res(grid.index(), range::all) = (*grid)(range(ndim));
+        return res;
+      }
+
+    } // namespace
+
+    //------------------------------------------------------
+
     std::pair<array<double, 1>, array<double, 2>> dos(tight_binding const &TB, int nkpts, int neps) {
 
       // loop on the BZ
-      int ndim = TB.lattice().ndim();
-      int norb = TB.lattice().n_orbitals();
-      grid_generator grid(ndim, nkpts);
-      array<double, 1> tempeval(norb);
-      array<dcomplex, 3> evec(norb, norb, grid.size());
-      array<double, 2> eval(norb, grid.size());
-      if (norb == 1)
-        for (; grid; ++grid) {
-          double ee                = real(TB.fourier((*grid)(range(ndim)))(0, 0));
-          eval(0, grid.index())    = ee;
-          evec(0, 0, grid.index()) = 1;
-        }
-      else
-        for (; grid; ++grid) {
-          // cerr<<" index = "<<grid.index()<<endl;
-          array_view<double, 1> eval_sl   = eval(range::all, grid.index());
-          array_view<dcomplex, 2> evec_sl = evec(range::all, range::all, grid.index());
-          std::tie(eval_sl, evec_sl)      = linalg::eigenelements(TB.fourier((*grid)(range(ndim))));
-          // cerr<< " point "<< *grid <<  " value "<< eval_sl<< endl; //" "<< (*grid) (range(ndim)) << endl;
+      int norb   = TB.lattice().n_orbitals();
+      auto kvecs = grid_points(TB.lattice().ndim(), nkpts);
+      long n_k   = kvecs.extent(0);
+      array<dcomplex, 3> evec(norb, norb, n_k);
+      array<double, 2> eval(norb, n_k);
+      foreach_batch(n_k, [&](range k_range) {
+        for (long ik : k_range) {
+          if (norb == 1) {
+            eval(0, ik)    = real(TB.fourier(kvecs(ik, range::all))(0, 0));
+            evec(0, 0, ik) = 1;
+          } else {
+            auto [ev, U]                     = linalg::eigenelements(TB.fourier(kvecs(ik, range::all)));
+            eval(range::all, ik)             = ev;
+            evec(range::all, range::all, ik) = U;
+          }
         }
+      });
 
       // define the epsilon mesh, etc.
       array<double, 1> epsilon(neps);
@@ -94,13 +139,208 @@ namespace triqs {
       array<double, 2> rho(neps, norb);
       rho() = 0;
       for (int l = 0; l < norb; l++) {
-        for (int j = 0; j < grid.size(); j++) {
+        for (int j = 0; j < n_k; j++) {
           int a = int((eval(l, j) - epsmin) / deps);
           if (a == int(neps)) a = a - 1;
           for (int k = 0; k < norb; k++) { rho(a, k) += real(conj(evec(k, l, j)) * evec(k, l, j)); }
         }
       }
-      rho /= grid.size() * deps;
+      rho /= n_k * deps;
+      return std::make_pair(epsilon, rho);
+    }
+
+    //----------------------------------------------------------------------------------
+
+    namespace {
+
+      // Vertex weights of a linear simplex (segment, triangle or tetrahedron for D = 1, 2, 3) with volume fraction v
+      // and sorted vertex energies e, integrated over the part of the simplex with energy below E.
+      // For D = 3 these are the weights of Bloechl, Jepsen, Andersen, PRB 49, 16223 (1994), Eqs. (B1-B7) and (22),
+      // including the optional correction for the curvature of the bands.
+      template <int D> std::array<double, D + 1> simplex_weights(std::array<double, D + 1> const &e, double v, double E, bool bloechl_correction) {
+
+        std::array<double, D + 1> w{};
+        if (E <= e[0]) return w;
+        if (E >= e[D]) {
+          w.fill(v / (D + 1));
+          return w;
+        }
+
+        if constexpr (D == 1) {
+          double t = (E - e[0]) / (e[1] - e[0]);
+          w        = {v * t * (2 - t) / 2, v * t * t / 2};
+
+        } else if constexpr (D == 2) {
+          if (E < e[1]) { // Occupied triangle around vertex 0
+            double t = (E - e[0]) / (e[1] - e[0]), s = (E - e[0]) / (e[2] - e[0]);
+            double c = v * t * s / 3;
+            w        = {c * (3 - t - s), c * t, c * s};
+          } else { // Unoccupied triangle around vertex 2
+            double t = (e[2] - E) / (e[2] - e[0]), s = (e[2] - E) / (e[2] - e[1]);
+            double c = v * t * s / 3;
+            w        = {v / 3 - c * t, v / 3 - c * s, v / 3 - c * (3 - t - s)};
+          }
+
+        } else { // D == 3
+          double e10 = e[1] - e[0], e20 = e[2] - e[0], e30 = e[3] - e[0], e21 = e[2] - e[1], e31 = e[3] - e[1], e32 = e[3] - e[2];
+          double dos = 0;
+          if (E < e[1]) {
+            double x = E - e[0];
+            double c = v / 4 * x * x * x / (e10 * e20 * e30);
+            w        = {c * (4 - x * (1 / e10 + 1 / e20 + 1 / e30)), c * x / e10, c * x / e20, c * x / e30};
+            dos      = 3 * v * x * x / (e10 * e20 * e30);
+          } else if (E < e[2]) {
+            double x0 = E - e[0], x1 = E - e[1], x2 = e[2] - E, x3 = e[3] - E;
+            double c1 = v / 4 * x0 * x0 / (e30 * e20);
+            double c2 = v / 4 * x0 * x1 * x2 / (e30 * e21 * e20);
+            double c3 = v / 4 * x1 * x1 * x3 / (e31 * e21 * e30);
+            w         = {c1 + (c1 + c2) * x2 / e20 + (c1 + c2 + c3) * x3 / e30, c1 + c2 + c3 + (c2 + c3) * x2 / e21 + c3 * x3 / e31,
+                         (c1 + c2) * x0 / e20 + (c2 + c3) * x1 / e21, (c1 + c2 + c3) * x0 / e30 + c3 * x1 / e31};
+            dos       = v / (e20 * e30) * (3 * e10 + 6 * x1 - 3 * (e20 + e31) * x1 * x1 / (e21 * e31));
+          } else {
+            double x = e[3] - E;
+            double c = v / 4 * x * x * x / (e30 * e31 * e32);
+            w        = {v / 4 - c * x / e30, v / 4 - c * x / e31, v / 4 - c * x / e32, v / 4 - c * (4 - x * (1 / e30 + 1 / e31 + 1 / e32))};
+            dos      = 3 * v * x * x / (e30 * e31 * e32);
+          }
+          if (bloechl_correction) {
+            double e_sum = e[0] + e[1] + e[2] + e[3];
+            for (int i = 0; i < 4; ++i) w[i] += dos / 40 * (e_sum - 4 * e[i]);
+          }
+        }
+        return w;
+      }
+
+      // Decomposition of the cell spanned by a k-point and its neighbours into simplices sharing the main diagonal.
+      // The corners of the cell are labeled by c = x + 2y + 4z with x, y, z in {0, 1}.
+      template <int D> auto const &cell_simplices() {
+        static const auto simplices = [] {
+          if constexpr (D == 1)
+            return std::vector<std::array<int, 2>>{{0, 1}};
+          else if constexpr (D == 2)
+            return std::vector<std::array<int, 3>>{{0, 1, 3}, {0, 2, 3}};
+          else
+            return std::vector<std::array<int, 4>>{{0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7}, {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}};
+        }();
+        return simplices;
+      }
+
+      // Accumulate the orbital-resolved DOS histogram of all simplices of the cells [cell_begin, cell_end)
+      template <int D>
+      void accumulate_simplices(array<double, 2> &rho, array<double, 2> const &eval, array<double, 3> const &proj, std::array<long, 3> const &n_k,
+                                long cell_begin, long cell_end, double epsmin, double epsmax, bool bloechl_correction) {
+
+        long n_kpts = n_k[0] * n_k[1] * n_k[2];
+        long neps = rho.extent(0), norb = rho.extent(1), nbands = eval.extent(1);
+        double deps = (epsmax - epsmin) / neps;
+        double v    = 1.0 / (n_kpts * double(cell_simplices<D>().size()));
+        auto edge   = [&](long j) { return j == neps ? epsmax : epsmin + j * deps; };
+
+        for (long ik = cell_begin; ik < cell_end; ++ik) {
+
+          // k-point indices of the corners of the cell
+          long i = ik % n_k[0], j = (ik / n_k[0]) % n_k[1], l = ik / (n_k[0] * n_k[1]);
+          std::array<long, 8> corners{};
+          for (int c = 0; c < (1 << D); ++c)
+            corners[c] = (i + (c & 1)) % n_k[0] + n_k[0] * ((j + ((c >> 1) & 1)) % n_k[1] + n_k[1] * ((l + ((c >> 2) & 1)) % n_k[2]));
+
+          for (auto const &simplex : cell_simplices<D>()) {
+            for (long n = 0; n < nbands; ++n) {
+
+              // Sort the vertices according to their energy
+              std::array<long, D + 1> ks;
+              for (int a = 0; a <= D; ++a) ks[a] = corners[simplex[a]];
+              std::ranges::sort(ks, [&](long k1, long k2) { return eval(k1, n) < eval(k2, n); });
+              std::array<double, D + 1> e;
+              for (int a = 0; a <= D; ++a) e[a] = eval(ks[a], n);
+
+              // Difference of the integrated weights between the edges of the energy bins
+              long j_min = std::clamp(long(std::floor((e[0] - epsmin) / deps)), 0l, neps);
+              long j_max = std::clamp(long(std::ceil((e[D] - epsmin) / deps)), 0l, neps);
+
+              // A flat simplex on the edge of a bin, e.g. a flat band at epsmin or epsmax, lies entirely in one bin
+              if (j_max == j_min) {
+                auto w  = simplex_weights<D>(e, v, e[D], bloechl_correction);
+                long jj = std::min(j_min, neps - 1);
+                for (int a = 0; a <= D; ++a)
+                  for (long o = 0; o < norb; ++o) rho(jj, o) += w[a] * proj(ks[a], n, o);
+                continue;
+              }
+
+              auto w_lo  = simplex_weights<D>(e, v, edge(j_min), bloechl_correction);
+              for (long jj = j_min + 1; jj <= j_max; ++jj) {
+                auto w_hi = simplex_weights<D>(e, v, edge(jj), bloechl_correction);
+                for (int a = 0; a <= D; ++a)
+                  for (long o = 0; o < norb; ++o) rho(jj - 1, o) += (w_hi[a] - w_lo[a]) * proj(ks[a], n, o);
+                w_lo = w_hi;
+              }
+            }
+          }
+        }
+      }
+
+    } // namespace
+
+    std::pair<array<double, 1>, array<double, 2>> dos_tetrahedron(tight_binding const &TB, int nkpts, int neps, bool bloechl_correction) {
+
+      int ndim  = TB.lattice().ndim();
+      long norb = TB.lattice().n_orbitals();
+      if (nkpts < 1 or neps < 1) TRIQS_RUNTIME_ERROR << "dos_tetrahedron : nkpts and neps must be positive";
+
+      // Periodic grid with nkpts points in each reciprocal direction, including the Gamma point
+      std::array<long, 3> n_k{nkpts, ndim > 1 ? nkpts : 1, ndim > 2 ? nkpts : 1};
+      long n_kpts = n_k[0] * n_k[1] * n_k[2];
+
+      // Eigenvalues eval(k, band) and orbital projections proj(k, band, orbital) = |U_{orbital, band}(k)|^2
+      array<double, 2> eval(n_kpts, norb);
+      array<double, 3> proj(n_kpts, norb, norb);
+
+      // Evaluate h_k in batches of k-points and diagonalize, in parallel
+      foreach_batch(n_kpts, [&](range k_range) {
+        auto kvecs = nda::matrix<double>(k_range.size(), ndim);
+        for (auto [n, ik] : itertools::enumerate(k_range)) {
+          auto idx = std::array<long, 3>{ik % n_k[0], (ik / n_k[0]) % n_k[1], ik / (n_k[0] * n_k[1])};
+          for (int d = 0; d < ndim; ++d) kvecs(n, d) = double(idx[d]) / n_k[d];
+        }
+        auto h_k = TB.fourier(kvecs);
+        for (auto [n, ik] : itertools::enumerate(k_range)) {
+          auto [ev, evec]      = linalg::eigenelements(nda::matrix<dcomplex>{h_k(n, range::all, range::all)});
+          eval(ik, range::all) = ev;
+          for (long band = 0; band < norb; ++band)
+            for (long orb = 0; orb < norb; ++orb) proj(ik, band, orb) = std::norm(evec(orb, band));
+        }
+      });
+
+      // define the epsilon mesh
+      double epsmin = min_element(eval);
+      double epsmax = max_element(eval);
+      if (epsmax - epsmin < 1e-10) { // flat bands
+        epsmin -= 0.5;
+        epsmax += 0.5;
+      }
+      double deps = (epsmax - epsmin) / neps;
+      array<double, 1> epsilon(neps);
+      for (int i = 0; i < neps; ++i) epsilon(i) = epsmin + (i + 0.5) * deps;
+
+      // Histogram of the analytic simplex DOS, i.e. its exact average over each energy bin.
+      // The k-points are split into one contiguous chunk per thread, each chunk accumulates into its own histogram.
+      long n_chunks = std::min<long>(n_kpts, n_threads());
+      auto rho_locs = std::vector<array<double, 2>>(n_chunks);
+      gfs::details::for_each_block(n_chunks, gfs::block_exec_policy::parallel, [&](long i) {
+        auto [k_begin, k_end] = itertools::chunk_range(0, n_kpts, n_chunks, i);
+        rho_locs[i]           = array<double, 2>::zeros(neps, norb);
+        switch (ndim) {
+          case 1: accumulate_simplices<1>(rho_locs[i], eval, proj, n_k, k_begin, k_end, epsmin, epsmax, bloechl_correction); break;
+          case 2: accumulate_simplices<2>(rho_locs[i], eval, proj, n_k, k_begin, k_end, epsmin, epsmax, bloechl_correction); break;
+          default: accumulate_simplices<3>(rho_locs[i], eval, proj, n_k, k_begin, k_end, epsmin, epsmax, bloechl_correction);
+        }
+      });
+
+      // The histograms are added in the order of the chunks
+      array<double, 2> rho(neps, norb);
+      rho() = 0;
+      for (auto const &rho_loc : rho_locs) rho += rho_loc;
+      rho /= deps;
       return std::make_pair(epsilon, rho);
     }
 
@@ -222,13 +462,241 @@ namespace triqs {
     //------------------------------------------------------
     array<double, 2> energies_on_bz_grid(tight_binding const &TB, int n_pts) {
 
-      int norb = TB.lattice().n_orbitals();
-      int ndim = TB.lattice().ndim();
-      grid_generator grid(ndim, n_pts);
-      array<double, 2> eval(norb, grid.size());
-      for (; grid; ++grid) { eval(range::all, grid.index()) = linalg::eigenvalues(TB.fourier((*grid)(range(ndim)))()); }
+      int norb   = TB.lattice().n_orbitals();
+      auto kvecs = grid_points(TB.lattice().ndim(), n_pts);
+      array<double, 2> eval(norb, kvecs.extent(0));
+      foreach_batch(kvecs.extent(0), [&](range k_range) {
+        for (long ik : k_range) eval(range::all, ik) = linalg::eigenvalues(TB.fourier(kvecs(ik, range::all))());
+      });
       return eval;
     }
 
+    //------------------------------------------------------
+
+    // Is t_{W R + shift[b] - shift[a]}(perm[a], perm[b]) = t_R(a, b) for all hoppings, with t_R(a, b)^* for time reversal
+    bool tight_binding::is_invariant(point_group_op const &op, double tol) const {
+      int ndim  = bl_.ndim();
+      long norb = n_orbitals();
+      if (long(op.perm.size()) != norb or long(op.shift.size()) != norb) return false;
+
+      // The index of each displacement
+      auto displ_index = std::map<std::array<long, 3>, long>{};
+      for (auto [i, R] : itertools::enumerate(displ_vec_)) {
+        auto key = std::array<long, 3>{0, 0, 0};
+        for (int d = 0; d < ndim; ++d) key[d] = R(d);
+        displ_index[key] = i;
+      }
+
+      for (auto const &[R, t] : itertools::zip(displ_vec_, overlap_mat_vec_)) {
+        auto WR = std::array<long, 3>{0, 0, 0};
+        for (int d = 0; d < ndim; ++d)
+          for (int e = 0; e < ndim; ++e) WR[d] += op.W(d, e) * R(e);
+        for (long a = 0; a < norb; ++a)
+          for (long b = 0; b < norb; ++b) {
+            auto key = WR;
+            for (int d = 0; d < ndim; ++d) key[d] += op.shift[b](d) - op.shift[a](d);
+            auto it     = displ_index.find(key);
+            dcomplex t2 = (it == displ_index.end()) ? 0 : overlap_mat_vec_[it->second](op.perm[a], op.perm[b]);
+            if (std::abs(t2 - (op.time_reversal ? std::conj(t(a, b)) : t(a, b))) > tol) return false;
+          }
+      }
+      return true;
+    }
+
+    //------------------------------------------------------
+
+    std::vector<point_group_op> tight_binding::symmetries(double tol) const {
+      auto res = std::vector<point_group_op>{};
+      for (auto &op : point_group(bl_))
+        if (is_invariant(op, tol)) res.push_back(std::move(op));
+
+      // Time reversal maps h_k onto h_{-k}^*, i.e. onto itself for real hoppings
+      bool is_real = std::all_of(overlap_mat_vec_.begin(), overlap_mat_vec_.end(), [tol](auto const &t) { return max_element(abs(imag(t))) <= tol; });
+      if (is_real) {
+        long n_ops = res.size();
+        for (long i = 0; i < n_ops; ++i) {
+          auto op          = res[i];
+          op.time_reversal = true;
+          res.push_back(std::move(op));
+        }
+      }
+      return res;
+    }
+
+    //------------------------------------------------------
+
+    std::pair<array<double, 2>, array<dcomplex, 3>> tight_binding::eigenelements(nda::matrix_const_view<double> k) const {
+      long n_k  = k.extent(0);
+      long norb = n_orbitals();
+      auto eval = array<double, 2>(n_k, norb);
+      auto evec = array<dcomplex, 3>(n_k, norb, norb);
+      foreach_batch(n_k, [&](range k_range) {
+        auto h_k = fourier(k(k_range, range::all));
+        for (auto [n, ik] : itertools::enumerate(k_range)) {
+          auto [ev, U]                     = linalg::eigenelements(nda::matrix<dcomplex>{h_k(n, range::all, range::all)});
+          eval(ik, range::all)             = ev;
+          evec(ik, range::all, range::all) = U;
+        }
+      });
+      return {std::move(eval), std::move(evec)};
+    }
+
+    //------------------------------------------------------
+
+    gfs::gf<mesh::brzone, gfs::tensor_real_valued<1>> tight_binding::dispersion(irreducible_kgrid const &grid) const {
+      if (grid.k_mesh().bz().lattice() != bl_) TRIQS_RUNTIME_ERROR << "dispersion: the k-grid is not defined on the lattice " << bl_;
+      for (auto const &op : grid.ops())
+        if (not is_invariant(op, 1e-8)) TRIQS_RUNTIME_ERROR << "dispersion: an operation of the k-grid does not leave the hoppings invariant";
+      auto kvecs = grid.kvecs();
+      auto eval  = array<double, 2>(grid.size(), n_orbitals());
+      foreach_batch(grid.size(), [&](range k_range) {
+        auto h_k = fourier(kvecs(k_range, range::all));
+        for (auto [n, ik] : itertools::enumerate(k_range)) eval(ik, range::all) = linalg::eigenvalues(h_k(n, range::all, range::all));
+      });
+      auto e_k   = gfs::gf<mesh::brzone, gfs::tensor_real_valued<1>>(grid.k_mesh(), {n_orbitals()});
+      e_k.data() = grid.unfold(eval);
+      return e_k;
+    }
+
+    //------------------------------------------------------
+
+    std::pair<gfs::gf<mesh::brzone, gfs::tensor_real_valued<1>>, gfs::gf<mesh::brzone, gfs::matrix_valued>>
+    tight_binding::eigenelements(irreducible_kgrid const &grid) const {
+      if (grid.k_mesh().bz().lattice() != bl_) TRIQS_RUNTIME_ERROR << "eigenelements: the k-grid is not defined on the lattice " << bl_;
+      for (auto const &op : grid.ops())
+        if (not is_invariant(op, 1e-8)) TRIQS_RUNTIME_ERROR << "eigenelements: an operation of the k-grid does not leave the hoppings invariant";
+      int ndim           = bl_.ndim();
+      long norb          = n_orbitals();
+      auto const &k_mesh = grid.k_mesh();
+      auto N             = k_mesh.dims();
+      auto eig           = eigenelements(grid.kvecs());
+
+      auto e_k   = gfs::gf<mesh::brzone, gfs::tensor_real_valued<1>>(k_mesh, {norb});
+      e_k.data() = grid.unfold(eig.first);
+
+      // U(k', perm[a], band) = exp(-2 pi i k' shift[a]) U(k, a, band), with k' the image of k by the rotation
+      auto U_k = gfs::gf<mesh::brzone, gfs::matrix_valued>(k_mesh, {norb, norb});
+      foreach_batch(k_mesh.size(), [&](range k_range) {
+        for (long ik : k_range) {
+          auto const &op = grid.ops()[grid.op_index()[ik]];
+          auto U         = eig.second(grid.irr_index()[ik], range::all, range::all);
+          auto m         = k_mesh.to_index(ik);
+          for (long a = 0; a < norb; ++a) {
+            double k_shift = 0;
+            for (int d = 0; d < ndim; ++d) k_shift += double(m[d]) / N[d] * op.shift[a](d);
+            auto phase = std::exp((op.time_reversal ? 2i : -2i) * M_PI * k_shift);
+            for (long l = 0; l < norb; ++l) {
+              auto u                        = phase * U(a, l);
+              U_k.data()(ik, op.perm[a], l) = op.time_reversal ? std::conj(u) : u;
+            }
+          }
+        }
+      });
+      return {std::move(e_k), std::move(U_k)};
+    }
+
+    //----------------------------------------------------------------------------------
+
+    namespace {
+
+      // Parse the next integer of [p, end), skipping the leading whitespace
+      template <typename T> bool parse_next(char const *&p, char const *end, T &x) {
+        while (p != end and std::isspace(static_cast<unsigned char>(*p))) ++p;
+        auto [q, ec] = std::from_chars(p, end, x);
+        p            = q;
+        return ec == std::errc{};
+      }
+
+      // The floating-point std::from_chars is missing in some standard libraries (e.g. libc++ before LLVM 20).
+      // The doubles are parsed by std::strtod, which requires the range to be followed by a null character.
+      bool parse_next(char const *&p, char const *end, double &x) {
+        char *q = nullptr;
+        x       = std::strtod(p, &q);
+        if (q == p or q > end) return false;
+        p = q;
+        return true;
+      }
+
+      // The size and modification time of a file, which identify its version for the cache
+      std::pair<long, long> file_stamp(std::string const &filename) {
+        namespace fs = std::filesystem;
+        return {long(fs::file_size(filename)), long(fs::last_write_time(filename).time_since_epoch().count())};
+      }
+
+    } // namespace
+
+    std::pair<std::vector<nda::vector<long>>, std::vector<nda::matrix<dcomplex>>> parse_wannier90_hr(std::string const &filename) {
+      std::ifstream f(filename);
+      if (!f) TRIQS_RUNTIME_ERROR << "parse_wannier90_hr: cannot open " << filename;
+
+      // Header: date, number of Wannier functions, number of Wigner-Seitz points, their degeneracies
+      std::string line;
+      std::getline(f, line);
+      long num_wann = 0, nrpts = 0;
+      f >> num_wann >> nrpts;
+      if (!f or num_wann < 1 or nrpts < 1) TRIQS_RUNTIME_ERROR << "parse_wannier90_hr: invalid header in " << filename;
+      auto deg = std::vector<long>(nrpts);
+      for (auto &d : deg) f >> d;
+      if (!f) TRIQS_RUNTIME_ERROR << "parse_wannier90_hr: cannot read the " << nrpts << " degeneracies in " << filename;
+      std::getline(f, line);
+
+      // Lines R1 R2 R3 m n Re Im, with m running fastest, for each R
+      auto displ_vec       = std::vector<nda::vector<long>>(nrpts, nda::vector<long>(3));
+      auto overlap_mat_vec = std::vector<nda::matrix<dcomplex>>(nrpts, nda::matrix<dcomplex>(num_wann, num_wann));
+      long R[3], m = 0, n = 0;
+      double re = 0, im = 0;
+      for (long r = 0; r < nrpts; ++r) {
+        auto &mat = overlap_mat_vec[r];
+        for (long l = 0; l < num_wann * num_wann; ++l) {
+          if (!std::getline(f, line))
+            TRIQS_RUNTIME_ERROR << "parse_wannier90_hr: " << filename << " ends after " << r << " of the " << nrpts << " displacements";
+          char const *p = line.c_str(), *end = p + line.size();
+          bool ok = parse_next(p, end, R[0]) and parse_next(p, end, R[1]) and parse_next(p, end, R[2]) and parse_next(p, end, m)
+             and parse_next(p, end, n) and parse_next(p, end, re) and parse_next(p, end, im);
+          if (!ok or m != l % num_wann + 1 or n != l / num_wann + 1)
+            TRIQS_RUNTIME_ERROR << "parse_wannier90_hr: invalid line in " << filename << " :\n" << line;
+          if (l == 0)
+            for (int i = 0; i < 3; ++i) displ_vec[r](i) = R[i];
+          else if (R[0] != displ_vec[r](0) or R[1] != displ_vec[r](1) or R[2] != displ_vec[r](2))
+            TRIQS_RUNTIME_ERROR << "parse_wannier90_hr: displacement changes within the block of " << displ_vec[r] << " in " << filename;
+          mat(n - 1, m - 1) = dcomplex{re, im} / double(deg[r]);
+        }
+      }
+      return {std::move(displ_vec), std::move(overlap_mat_vec)};
+    }
+
+    //----------------------------------------------------------------------------------
+
+    tight_binding tight_binding_from_wannier90_hr(bravais_lattice const &bl, std::string const &filename, std::string const &cache_file) {
+      if (!std::filesystem::exists(filename)) TRIQS_RUNTIME_ERROR << "tight_binding_from_wannier90_hr: no file " << filename;
+      auto [size, mtime] = file_stamp(filename);
+
+      if (!cache_file.empty() and std::filesystem::exists(cache_file)) {
+        try {
+          auto grp = h5::group(h5::file(cache_file, 'r'));
+          if (h5::h5_read<long>(grp, "source_size") == size and h5::h5_read<long>(grp, "source_mtime") == mtime) {
+            auto tb = tight_binding::h5_read_construct(grp, "tight_binding");
+            if (tb.lattice() == bl) return tb;
+          }
+        } catch (std::exception const &) {} // an unreadable or outdated cache is rewritten
+      }
+
+      auto [displ_vec, overlap_mat_vec] = parse_wannier90_hr(filename);
+      auto tb                           = tight_binding(bl, std::move(displ_vec), std::move(overlap_mat_vec));
+
+      if (!cache_file.empty()) {
+        // Write to a temporary file and rename it, so that concurrent processes never read a partial cache
+        auto tmp = cache_file + ".tmp" + std::to_string(std::random_device{}());
+        {
+          auto grp = h5::group(h5::file(tmp, 'w'));
+          h5_write(grp, "source_size", size);
+          h5_write(grp, "source_mtime", mtime);
+          h5_write(grp, "tight_binding", tb);
+        }
+        std::filesystem::rename(tmp, cache_file);
+      }
+      return tb;
+    }
+
   } // namespace lattice
 } // namespace triqs
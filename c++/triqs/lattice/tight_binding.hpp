@@ -20,6 +20,7 @@
 
 #pragma once
 #include "brillouin_zone.hpp"
+#include "point_group.hpp"
 #include "../mesh/brzone.hpp"
 #include "../gfs.hpp"
 #include <itertools/itertools.hpp>
@@ -40,6 +41,9 @@ namespace triqs {
       std::vector<nda::vector<long>> displ_vec_;
       std::vector<nda::matrix<dcomplex>> overlap_mat_vec_;
 
+      // Does op leave the hoppings invariant within tol, cf. symmetries
+      bool is_invariant(point_group_op const &op, double tol) const;
+
       public:
       /**
        * Construct a tight_binding Hamiltonian on a given bravais_lattice,
@@ -184,6 +188,53 @@ namespace triqs {
         return dispersion(k_mesh);
       }
 
+      /**
+       * The operations of the point group of the lattice which leave the hoppings invariant, cf. point_group
+       *
+       * The orbitals are treated as s-like: an operation is kept if it maps each hopping $t_R(a, b)$ onto
+       * $t_{R'}(perm[a], perm[b])$ with $R' = W R + shift[b] - shift[a]$.
+       * If all hoppings are real, each operation is also combined with time reversal.
+       *
+       * @param tol The tolerance on the hoppings
+       * @return The symmetry operations, starting with the identity
+       */
+      std::vector<point_group_op> symmetries(double tol = 1e-8) const;
+
+      /**
+       * Calculate the eigenvalues and eigenvectors of $h_k$ for an array of momentum vectors.
+       * h_k is evaluated in batches of momenta, which are diagonalized in parallel.
+       *
+       * @param k The momentum vectors in units of the reciprocal lattice vectors, as rows
+       * @return The eigenvalues eps(k, band) and the eigenvectors U(k, orbital, band)
+       */
+      std::pair<nda::array<double, 2>, nda::array<dcomplex, 3>> eigenelements(nda::matrix_const_view<double> k) const;
+
+      /**
+       * Calculate the dispersion on the full mesh of an irreducible k-grid,
+       * diagonalizing $h_k$ on the irreducible points only.
+       * Throws if an operation of the grid does not leave the hoppings invariant.
+       *
+       * @param grid The irreducible k-grid, e.g. irreducible_kgrid(k_mesh, tb.symmetries())
+       * @return Green function on the k_mesh of the grid initialized with the dispersion values
+       */
+      gfs::gf<mesh::brzone, gfs::tensor_real_valued<1>> dispersion(irreducible_kgrid const &grid) const;
+
+      /**
+       * Calculate the eigenvalues and eigenvectors on the full mesh of an irreducible k-grid,
+       * diagonalizing $h_k$ on the irreducible points only.
+       * Throws if an operation of the grid does not leave the hoppings invariant.
+       *
+       * The eigenvectors at the image k' of an irreducible point k are $U(k') = Q U(k)$, with
+       * $Q_{perm[a], a} = e^{-2 \pi i k' \cdot shift[a]}$, complex conjugated for time reversal.
+       * They can thus differ from those of a direct diagonalization by phases, or by a rotation
+       * within degenerate bands.
+       *
+       * @param grid The irreducible k-grid, e.g. irreducible_kgrid(k_mesh, tb.symmetries())
+       * @return The eigenvalues eps(k, band) and the eigenvectors U(k, orbital, band) on the k_mesh of the grid
+       */
+      std::pair<gfs::gf<mesh::brzone, gfs::tensor_real_valued<1>>, gfs::gf<mesh::brzone, gfs::matrix_valued>>
+      eigenelements(irreducible_kgrid const &grid) const;
+
       // ------------------- Comparison -------------------
 
       bool operator==(tight_binding const &tb) const {
@@ -227,7 +278,51 @@ namespace triqs {
     }; // tight_binding
 
     std::pair<nda::array<double, 1>, nda::array<double, 2>> dos(tight_binding const &TB, int nkpts, int neps);
+
+    /**
+     * Density of states and orbital-resolved partial DOS, using the linear tetrahedron method
+     *
+     * The Brillouin zone is sampled on a periodic grid with nkpts points in each reciprocal direction,
+     * where h_k is evaluated and diagonalized in parallel. The cells of the grid are decomposed into
+     * tetrahedra (triangles in 2d, segments in 1d), in which the bands are linearly interpolated.
+     * The returned DOS is the exact average of the interpolated DOS over each energy bin.
+     *
+     * @param TB The tight-binding Hamiltonian
+     * @param nkpts The number of k-points in each reciprocal direction
+     * @param neps The number of energy bins
+     * @param bloechl_correction Apply the Bloechl correction for the curvature of the bands (3d only)
+     * @return The energy bin centers and the partial DOS rho(eps, orbital)
+     */
+    std::pair<nda::array<double, 1>, nda::array<double, 2>> dos_tetrahedron(tight_binding const &TB, int nkpts, int neps,
+                                                                            bool bloechl_correction = true);
+
     std::pair<nda::array<double, 1>, nda::array<double, 1>> dos_patch(tight_binding const &TB, const nda::array<double, 2> &triangles, int neps,
                                                                       int ndiv);
+
+    /**
+     * Read the real-space hoppings of a Wannier90 ``*_hr.dat`` file
+     *
+     * The file is streamed line by line into the hopping matrices, which are divided
+     * by the degeneracies of the Wigner-Seitz points. The matrix of the displacement R
+     * has the element (n, m) of the line ``R m n``, as parse_hopping_from_wannier90_hr_dat.
+     *
+     * @param filename The ``*_hr.dat`` file
+     * @return The displacements and the associated hopping matrices
+     */
+    std::pair<std::vector<nda::vector<long>>, std::vector<nda::matrix<dcomplex>>> parse_wannier90_hr(std::string const &filename);
+
+    /**
+     * Construct the tight_binding Hamiltonian of a Wannier90 ``*_hr.dat`` file, cf. parse_wannier90_hr
+     *
+     * If a cache file is given, the tight_binding is read from it when it was written for the same
+     * bravais lattice and for the current size and modification time of the ``*_hr.dat`` file.
+     * Otherwise the ``*_hr.dat`` file is parsed, and the cache file is (re)written.
+     *
+     * @param bl The bravais lattice, with one orbital per Wannier function
+     * @param filename The ``*_hr.dat`` file
+     * @param cache_file The HDF5 cache file, or an empty string for no cache
+     * @return The tight_binding Hamiltonian
+     */
+    tight_binding tight_binding_from_wannier90_hr(bravais_lattice const &bl, std::string const &filename, std::string const &cache_file = "");
   } // namespace lattice
 } // namespace triqs
@@ -216,6 +216,21 @@ namespace triqs {
 
         double operator()() { return DBL_EPSILON + eval() * (1 - 2 * DBL_EPSILON); }
 
+        // Write the full state of the generator, as for the boost engines
+        friend std::ostream &operator<<(std::ostream &os, RandMT const &R) {
+          for (int i = 0; i < N; ++i) os << R.state[i] << ' ';
+          return os << (R.left > 0 ? R.next - R.state : 0) << ' ' << R.left << ' ' << R.initseed << ' ' << R.seed_save;
+        }
+
+        // Read the full state of the generator
+        friend std::istream &operator>>(std::istream &is, RandMT &R) {
+          long offset = 0;
+          for (int i = 0; i < N; ++i) is >> R.state[i];
+          is >> offset >> R.left >> R.initseed >> R.seed_save;
+          R.next = R.state + offset;
+          return is;
+        }
+
         double eval();
         // inline of this causes a BIG pb with g++ 4.1.2. WHY ?????
         //  inline double operator()() {
@@ -20,6 +20,7 @@
 
 #pragma once
 #include <triqs/utility/first_include.hpp>
+#include <chrono>
 #include <cmath>
 #include <memory>
 #include <triqs/utility/timer.hpp>
@@ -30,6 +31,7 @@
 #include <h5/h5.hpp>
 #include <mpi/mpi.hpp>
 #include <mpi/monitor.hpp>
+#include "./mc_length_cycle.hpp"
 #include "./mc_measure_aux_set.hpp"
 #include "./mc_measure_set.hpp"
 #include "./mc_move_set.hpp"
@@ -126,10 +128,83 @@ namespace triqs::mc_tools {
    */
     void set_after_cycle_duty(std::function<void()> f) { after_cycle_duty = f; }
 
+    /**
+     * Accumulate the measures on worker threads
+     *
+     * Only the measures providing a type snapshot_t and the methods take_snapshot(snapshot_t &, MCSignType)
+     * and accumulate_snapshot(snapshot_t const &) are concerned, the others are accumulated on the Monte-Carlo thread.
+     * At each measurement, the Monte-Carlo thread only copies a snapshot into a ring buffer,
+     * and waits only if the buffer is full. Each measure has its own worker thread, which accumulates the snapshots in order,
+     * so that the results are identical to the synchronous ones. run returns after all snapshots are accumulated.
+     *
+     * @param async Switch the asynchronous accumulation on or off
+     * @param buffer_size Number of snapshots in the ring buffer of each measure
+     */
+    void set_async_measures(bool async, size_t buffer_size = 16) { AllMeasures.set_async(async, buffer_size); }
+
+    /**
+     * Sets a checkpoint function, called by run at the end of a cycle
+     *
+     * The function is called each time the given wall-clock interval has passed since the start of the run
+     * or the last checkpoint, and before returning when the run is interrupted by a signal (e.g. on preemption).
+     * It is called on the Monte-Carlo thread between two cycles, when the configuration is consistent.
+     * When a checkpoint function is set, a signal does not interrupt the current cycle: the cycle and its measures
+     * are completed before the checkpoint, so that a restart continues the chain exactly.
+     * Writing the mc_generic to HDF5 in this function, together with the configuration,
+     * allows to restart the run as a continuation of the same Markov chain.
+     *
+     * @param f The checkpoint function
+     * @param interval Wall-clock time between two checkpoints in seconds. If not positive, only on signal.
+     */
+    void set_checkpoint(std::function<void()> f, double interval = -1) {
+      checkpoint          = std::move(f);
+      checkpoint_interval = interval;
+    }
+
+    /**
+     * Choose the length of the cycle during the warmup from the autocorrelation time of an observable
+     *
+     * During the second half of the next warmups (all of it if the number of cycles is not fixed), the observable is sampled
+     * after each move, and its autocorrelation time tau (in moves) is estimated by logarithmic binning.
+     * At the end of the warmup, the length of the cycle is set to target_fraction * tau, and is reported together with
+     * the evidence behind it (cf get_length_cycle_estimate). warmup_and_accumulate uses it for the accumulation,
+     * and it should be passed to accumulate when calling warmup and accumulate separately.
+     * If the observable does not fluctuate, the length of the cycle given to warmup is kept.
+     *
+     * @param observable The observable, evaluated on the current configuration
+     * @param target_fraction The length of the cycle as a fraction of the autocorrelation time
+     * @param min_length_cycle Lower bound of the length of the cycle
+     * @param max_length_cycle Upper bound of the length of the cycle
+     */
+    void set_length_cycle_tuning(std::function<double()> observable, double target_fraction = 1.0, int64_t min_length_cycle = 1,
+                                 int64_t max_length_cycle = int64_t(1) << 20) {
+      tuner = std::make_unique<length_cycle_tuner>(std::move(observable), target_fraction, min_length_cycle, max_length_cycle);
+    }
+
+    /// Switch off the choice of the length of the cycle during the warmup
+    void clear_length_cycle_tuning() { tuner.reset(); }
+
+    /// The length of the cycle chosen during the last warmup, and the evidence behind it, cf set_length_cycle_tuning
+    length_cycle_estimate const &get_length_cycle_estimate() const { return length_cycle_est; }
+
     int warmup(int64_t n_warmup_cycles, int64_t length_cycle, std::function<bool()> stop_callback, mpi::communicator c = mpi::communicator{}) {
       report(3) << "\nWarming up ..." << std::endl;
+      if (tuner) tuner->reset();
       auto status  = run(n_warmup_cycles, length_cycle, stop_callback, false, c);
       timer_warmup = timer_run;
+      if (tuner) {
+        length_cycle_est = tuner->estimate(length_cycle, c);
+        auto const &e    = length_cycle_est;
+        if (c.rank() == 0) {
+          if (e.binning_level < 0)
+            report(2) << "Length of the cycle kept at " << e.length_cycle << ": the observable does not fluctuate over " << e.n_samples << " samples"
+                      << std::endl;
+          else
+            report(2) << "Length of the cycle set to " << e.length_cycle << ": autocorrelation time " << e.tau << " moves from " << e.n_samples
+                      << " samples, in bins of " << (long(1) << e.binning_level) << " samples"
+                      << (e.converged ? "" : " [NOT CONVERGED: the autocorrelation time may be underestimated, increase the warmup]") << std::endl;
+        }
+      }
       return status;
     }
 
@@ -187,9 +262,59 @@ namespace triqs::mc_tools {
       return status;
     }
 
+    /**
+     * Accumulate/Measure for a wall-clock time budget common to all ranks
+     *
+     * The ranks agree on a common deadline, the earliest of their local deadlines (now + time_budget),
+     * with a non-blocking reduction which completes while the first cycles are running.
+     * Each rank then accumulates as many cycles as it can before the deadline, so that no rank idles
+     * in collect_results waiting for slower ones. The number of measures then differs between ranks:
+     * the measures should normalize their results with the totals over all ranks (e.g. the sum of the signs),
+     * not average per-rank results. The wall clocks of the nodes are assumed to be synchronized.
+     *
+     * @param time_budget             Wall-clock time of the accumulation in seconds
+     * @param length_cycle            Number of QMC move attempts in one cycle
+     * @param c                       The mpi communicator [optional]
+     *
+     * @return
+     *    =  =============================================
+     *    0  if the computation has run until the deadline
+     *    2  if it has been stopped by receiving a signal
+     *    =  =============================================
+     */
+    int accumulate_for(double time_budget, int64_t length_cycle, mpi::communicator c = mpi::communicator{}) {
+      EXPECTS(time_budget >= 0);
+      auto wall_time = [] { return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count(); };
+
+      double local_deadline = wall_time() + time_budget, deadline = local_deadline;
+      bool agreed           = true;
+      MPI_Request request   = MPI_REQUEST_NULL;
+      if (mpi::has_env and c.size() > 1) {
+        MPI_Iallreduce(&local_deadline, &deadline, 1, MPI_DOUBLE, MPI_MIN, c.get(), &request);
+        agreed = false;
+      }
+
+      // Until the reduction has completed, the local deadline is used, which is never earlier than the common one
+      auto stop_callback = [&]() {
+        if (!agreed) {
+          int flag = 0;
+          MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+          agreed = flag;
+        }
+        return wall_time() >= (agreed ? deadline : local_deadline);
+      };
+
+      report(3) << "\nAccumulating for " << time_budget << " seconds ..." << std::endl;
+      auto status = run(-1, length_cycle, stop_callback, true, c);
+      if (!agreed) MPI_Wait(&request, MPI_STATUS_IGNORE);
+      timer_accumulation = timer_run;
+      return (status == 1 ? 0 : status);
+    }
+
     int warmup_and_accumulate(int64_t n_warmup_cycles, int64_t n_accumulation_cycles, int64_t length_cycle, std::function<bool()> stop_callback,
                               mpi::communicator c = mpi::communicator{}) {
       int status = warmup(n_warmup_cycles, length_cycle, stop_callback, c);
+      if (tuner) length_cycle = length_cycle_est.length_cycle;
       if (status == 0) status = accumulate(n_accumulation_cycles, length_cycle, stop_callback, c);
       return status;
     }
@@ -200,7 +325,8 @@ namespace triqs::mc_tools {
      * @param n_warmup_cycles         Number of QMC cycles in the warmup
      * @param n_accumulation_cycles   Number of QMC cycles in the accumulation (measures are done after each cycle).
      *                                If negative, the accumulation is done until the stop_callback returns true or signal is received.
-     * @param length_cycle            Number of QMC move attempts in one cycle
+     * @param length_cycle            Number of QMC move attempts in one cycle.
+     *                                With set_length_cycle_tuning, only for the warmup, the accumulation uses the chosen one.
      * @param stop_callback           A callback function () -> bool. It is called after each cycle
      *                                to and the computation stops when it returns true.
      *                                Typically used to set up the time limit, cf doc.
@@ -244,6 +370,9 @@ namespace triqs::mc_tools {
       EXPECTS(length_cycle > 0);
 
       AllMoves.clear_statistics();
+      timing_signal_check.clear();
+      timing_stop_callback.clear();
+      timing_after_cycle_duty.clear();
 
       timer_run = {};
       timer_run.start();
@@ -252,17 +381,28 @@ namespace triqs::mc_tools {
       done_percent = 0;
       nmeasures    = 0;
       bool stop_it = false, finished = false, infinite = (n_cycles < 0);
-      int NC                = 0;
-      double next_info_time = 0.1;
+      int NC                      = 0;
+      double next_info_time       = 0.1;
+      double next_checkpoint_time = checkpoint_interval;
 
       std::unique_ptr<mpi::monitor> node_monitor;
       if (rethrow_exception and mpi::has_env) node_monitor = std::make_unique<mpi::monitor>(c);
 
+      // During the warmup, sample the observable for the choice of the length of the cycle, after equilibration
+      bool tune         = tuner and !do_measure;
+      int64_t NC_sample = infinite ? 0 : n_cycles / 2;
+
       for (; !stop_it; ++NC) { // do NOT reinit NC to 0
         try {
           // Metropolis loop. Switch here for HeatBath, etc...
           for (int64_t k = 1; (k <= length_cycle); k++) {
-            if (triqs::signal_handler::received()) throw triqs::signal_handler::exception{};
+            bool signal_received;
+            if constexpr (timing_enabled)
+              signal_received = timing_signal_check([] { return triqs::signal_handler::received(); });
+            else
+              signal_received = triqs::signal_handler::received();
+            // With a checkpoint, the cycle is completed and the run stops after it, cf. set_checkpoint
+            if (signal_received and !checkpoint) throw triqs::signal_handler::exception{};
             double r = AllMoves.attempt();
             if (RandomGenerator() < std::min(1.0, r)) {
               if (debug) std::cerr << " Move accepted " << std::endl;
@@ -273,8 +413,14 @@ namespace triqs::mc_tools {
               AllMoves.reject();
             }
             ++config_id;
+            if (tune and NC >= NC_sample) tuner->sample();
+          }
+          if (after_cycle_duty) {
+            if constexpr (timing_enabled)
+              timing_after_cycle_duty(after_cycle_duty);
+            else
+              after_cycle_duty();
           }
-          if (after_cycle_duty) { after_cycle_duty(); }
           if (do_measure) {
             nmeasures++;
             for (auto &x : AllMeasuresAux) x();
@@ -286,12 +432,16 @@ namespace triqs::mc_tools {
         } catch (std::exception const &err) {
           // log the error and node number
           std::cerr << "mc_generic: Exception occurs on node " << c.rank() << "\n" << err.what() << std::endl;
-          if (rethrow_exception)
+          if (!rethrow_exception)
+            c.abort(2);
+          else if (node_monitor)
             node_monitor->request_emergency_stop();
           else
-            c.abort(2);
+            throw; // no mpi environment
         }
 
+        ++current_cycle_number;
+
         // recompute fraction done
         done_percent = int64_t(floor(((NC + 1) * 100.0) / n_cycles));
         if (timer_run > next_info_time || done_percent == 100) {
@@ -305,19 +455,46 @@ namespace triqs::mc_tools {
           next_info_time = 1.25 * timer_run + 2.0; // Increase time interval non-linearly
         }
         finished = NC + 1 >= n_cycles and not infinite;
-        stop_it  = (stop_callback() || triqs::signal_handler::received() || finished);
+        bool stop_requested;
+        if constexpr (timing_enabled)
+          stop_requested = timing_stop_callback(stop_callback);
+        else
+          stop_requested = stop_callback();
+        stop_it = (stop_requested || triqs::signal_handler::received() || finished);
 
         // Stop if an emergeny occured on any node
         if (node_monitor) stop_it |= node_monitor->emergency_occured();
 
+        // Periodic checkpoint
+        if (checkpoint and checkpoint_interval > 0 and !stop_it and timer_run > next_checkpoint_time) {
+          checkpoint();
+          next_checkpoint_time = double(timer_run) + checkpoint_interval;
+        }
+
       } // end main NC loop
 
-      current_cycle_number += NC;
+      // Wait for the asynchronous measures, so that the results are complete when run returns
+      try {
+        AllMeasures.drain();
+      } catch (std::exception const &err) {
+        std::cerr << "mc_generic: Exception occurs in an asynchronous measure on node " << c.rank() << "\n" << err.what() << std::endl;
+        if (!rethrow_exception)
+          c.abort(2);
+        else if (node_monitor)
+          node_monitor->request_emergency_stop();
+        else
+          throw; // no mpi environment
+      }
+
       timer_run.stop();
 
       int status = (finished ? 0 : (triqs::signal_handler::received() ? 2 : 1));
       triqs::signal_handler::stop();
 
+      // Checkpoint before leaving on a signal, unless an exception occured
+      bool emergency = node_monitor and node_monitor->emergency_occured();
+      if (checkpoint and status == 2 and !emergency) checkpoint();
+
       if (node_monitor) {
         node_monitor->finalize_communications();
         if (node_monitor->emergency_occured()) TRIQS_RUNTIME_ERROR << "mc_generic stops because the calculation raised an exception on one node";
@@ -341,11 +518,65 @@ namespace triqs::mc_tools {
 
       report(3) << "[Rank " << c.rank() << "] Timings for all measures:\n" << AllMeasures.get_timings();
       report(3) << "[Rank " << c.rank() << "] Acceptance rate for all moves:\n" << AllMoves.get_statistics();
+      if constexpr (timing_enabled) {
+        report(3) << "[Rank " << c.rank() << "] Estimated time in all moves:\n" << AllMoves.get_timings();
+        report(3) << "[Rank " << c.rank() << "] Estimated time in the stop callback: " << timing_stop_callback.estimated_time()
+                  << " seconds, in the signal check: " << timing_signal_check.estimated_time() << " seconds\n";
+      }
       report(3) << "[Rank " << c.rank() << "] Warmup lasted: " << get_warmup_time() << " seconds [" << get_warmup_time_HHMMSS() << "]\n";
       report(3) << "[Rank " << c.rank() << "] Simulation lasted: " << get_accumulation_time() << " seconds [" << get_accumulation_time_HHMMSS()
                 << "]\n";
       report(3) << "[Rank " << c.rank() << "] Number of measures: " << nmeasures << std::endl;
       if (c.rank() == 0) report(2) << "Total number of measures: " << nmeasures_tot << std::endl;
+
+      // load balance between the ranks
+      int64_t nmeasures_min = mpi::reduce(nmeasures, c, 0, false, MPI_MIN);
+      int64_t nmeasures_max = mpi::reduce(nmeasures, c, 0, false, MPI_MAX);
+      if (c.rank() == 0 and c.size() > 1)
+        report(2) << "Number of measures per rank: min " << nmeasures_min << ", max " << nmeasures_max << ", mean " << double(nmeasures_tot) / c.size()
+                  << std::endl;
+    }
+
+    /**
+     * Performance report of the last run on this rank, as a JSON object
+     *
+     * It contains the statistics of the moves, the number of calls and time of the measures,
+     * the warmup and accumulation times and, with TRIQS_MCTOOLS_TIMING, the sampled timing of the
+     * attempt/accept/reject calls of the moves, of the stop callback, of the signal check and of the after cycle duty.
+     * The acceptance rates are available after collect_results.
+     */
+    std::string get_performance_report() const {
+      std::ostringstream s;
+      s << R"({"timing_enabled": )" << (timing_enabled ? "true" : "false") << R"(, "warmup_time": )" << details::json_number(get_warmup_time())
+        << R"(, "accumulation_time": )" << details::json_number(get_accumulation_time()) << R"(, "n_measures": )" << nmeasures
+        << R"(, "moves": )" << AllMoves.get_statistics_json() << R"(, "measures": )" << AllMeasures.get_timings_json();
+      if (tuner) s << R"(, "length_cycle_estimate": )" << length_cycle_est.to_json();
+      if constexpr (timing_enabled)
+        s << R"(, "stop_callback": )" << timing_stop_callback.to_json() << R"(, "signal_check": )" << timing_signal_check.to_json()
+          << R"(, "after_cycle_duty": )" << timing_after_cycle_duty.to_json();
+      s << "}";
+      return s.str();
+    }
+
+    /**
+     * Write the performance report of the last run on this rank to HDF5, cf get_performance_report
+     *
+     * @param g The HDF5 group
+     * @param name The name of the subgroup with the report
+     */
+    void write_performance_report(h5::group g, std::string const &name) const {
+      auto gr = g.create_group(name);
+      h5::write(gr, "warmup_time", get_warmup_time());
+      h5::write(gr, "accumulation_time", get_accumulation_time());
+      h5::write(gr, "n_measures", nmeasures);
+      AllMoves.write_statistics(gr, "moves");
+      AllMeasures.write_timings(gr, "measures");
+      if (tuner) h5_write(gr, "length_cycle_estimate", length_cycle_est);
+      if constexpr (timing_enabled) {
+        h5_write(gr, "stop_callback", timing_stop_callback);
+        h5_write(gr, "signal_check", timing_signal_check);
+        h5_write(gr, "after_cycle_duty", timing_after_cycle_duty);
+      }
     }
 
     /**
@@ -355,6 +586,11 @@ namespace triqs::mc_tools {
    */
     std::map<std::string, double> get_acceptance_rates() const { return AllMoves.get_acceptance_rates(); }
 
+    /**
+   *  The number of measures of the last accumulation on this rank
+   */
+    int64_t get_nmeasures() const { return nmeasures; }
+
     /**
    *  The current percents done
    */
@@ -405,7 +641,7 @@ namespace triqs::mc_tools {
    */
     auto get_accumulation_time_HHMMSS() const { return hours_minutes_seconds_from_seconds(timer_accumulation); }
 
-    /// HDF5 interface
+    /// HDF5 interface. The state of the random generator is included, so that a run continues the same Markov chain after h5_read.
     friend void h5_write(h5::group g, std::string const &name, mc_generic const &mc) {
       auto gr = g.create_group(name);
       h5_write(gr, "moves", mc.AllMoves);
@@ -413,6 +649,8 @@ namespace triqs::mc_tools {
       h5_write(gr, "number_cycle_done", mc.current_cycle_number);
       h5_write(gr, "number_measure_done", mc.nmeasures);
       h5_write(gr, "sign", mc.sign);
+      h5_write(gr, "config_id", mc.config_id);
+      h5_write(gr, "rng", mc.RandomGenerator);
     }
 
     /// HDF5 interface
@@ -423,6 +661,8 @@ namespace triqs::mc_tools {
       h5_read(gr, "number_cycle_done", mc.current_cycle_number);
       h5_read(gr, "number_measure_done", mc.nmeasures);
       h5_read(gr, "sign", mc.sign);
+      if (gr.has_key("config_id")) h5_read(gr, "config_id", mc.config_id); // Backward Compat
+      if (gr.has_key("rng")) h5_read(gr, "rng", mc.RandomGenerator);
     }
 
     private:
@@ -431,9 +671,14 @@ namespace triqs::mc_tools {
     measure_set<MCSignType> AllMeasures;
     std::vector<measure_aux> AllMeasuresAux;
     utility::report_stream report;
-    int64_t nmeasures, current_cycle_number = 0;
+    int64_t nmeasures = 0, current_cycle_number = 0;
     utility::timer timer_run, timer_accumulation, timer_warmup;
     std::function<void()> after_cycle_duty;
+    std::function<void()> checkpoint;
+    double checkpoint_interval = -1;
+    std::unique_ptr<length_cycle_tuner> tuner;
+    length_cycle_estimate length_cycle_est;
+    call_timing timing_signal_check, timing_stop_callback, timing_after_cycle_duty; // only used if timing_enabled
     MCSignType sign        = 1;
     int64_t done_percent   = 0;
     int64_t config_id      = 0;
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include <triqs/stat/accumulator.hpp>
+#include <triqs/utility/exceptions.hpp>
+#include <h5/h5.hpp>
+#include <mpi/mpi.hpp>
+#include "./mc_timing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace triqs::mc_tools {
+
+  /// The length of the cycle chosen from the autocorrelation time of an observable, and the evidence behind it
+  struct length_cycle_estimate {
+    /// The chosen length of the cycle
+    int64_t length_cycle = 0;
+
+    /// Estimate of the autocorrelation time of the observable, in number of moves
+    double tau = 0;
+
+    /// The logarithmic binning level used for the estimate (bins of 2^level samples), -1 if none could be used
+    int binning_level = -1;
+
+    /// Number of samples of the observable
+    long n_samples = 0;
+
+    /// Has the estimate of tau reached a plateau as a function of the binning level
+    bool converged = false;
+
+    /// Standard errors of the mean for the logarithmic binning levels, and the number of bins per level
+    std::vector<double> log_bin_errors;
+    std::vector<long> log_bin_counts;
+
+    /// The estimate as a JSON object
+    [[nodiscard]] std::string to_json() const {
+      std::ostringstream s;
+      s << R"({"length_cycle": )" << length_cycle << R"(, "tau": )" << details::json_number(tau) << R"(, "binning_level": )" << binning_level
+        << R"(, "n_samples": )" << n_samples << R"(, "converged": )" << (converged ? "true" : "false") << R"(, "log_bin_errors": [)";
+      for (size_t n = 0; n < log_bin_errors.size(); ++n) s << (n ? ", " : "") << details::json_number(log_bin_errors[n]);
+      s << R"(], "log_bin_counts": [)";
+      for (size_t n = 0; n < log_bin_counts.size(); ++n) s << (n ? ", " : "") << log_bin_counts[n];
+      s << "]}";
+      return s.str();
+    }
+
+    /// MPI-broadcast the estimate
+    friend void mpi_broadcast(length_cycle_estimate &e, mpi::communicator c = {}, int root = 0) {
+      int converged = e.converged;
+      mpi::broadcast(e.length_cycle, c, root);
+      mpi::broadcast(e.tau, c, root);
+      mpi::broadcast(e.binning_level, c, root);
+      mpi::broadcast(e.n_samples, c, root);
+      mpi::broadcast(converged, c, root);
+      mpi::broadcast(e.log_bin_errors, c, root);
+      mpi::broadcast(e.log_bin_counts, c, root);
+      e.converged = converged;
+    }
+
+    friend void h5_write(h5::group g, std::string const &name, length_cycle_estimate const &e) {
+      auto gr = g.create_group(name);
+      h5::write(gr, "length_cycle", long(e.length_cycle));
+      h5::write(gr, "tau", e.tau);
+      h5::write(gr, "binning_level", e.binning_level);
+      h5::write(gr, "n_samples", e.n_samples);
+      h5::write(gr, "converged", int(e.converged));
+      h5::write(gr, "log_bin_errors", e.log_bin_errors);
+      h5::write(gr, "log_bin_counts", e.log_bin_counts);
+    }
+  };
+
+  /**
+   * Choice of the length of the cycle from the autocorrelation time of an observable
+   *
+   * The observable is sampled after each move, and fed into a logarithmic binning accumulator.
+   * The autocorrelation time is estimated from the ratio of the binned and unbinned errors
+   * at the largest binning level with at least min_bins bins, cf stat::tau_estimate_from_errors.
+   * The estimate is considered converged if it does not grow by more than 20% from the previous level.
+   * The length of the cycle is then target_fraction * tau, in [min_length_cycle, max_length_cycle].
+   */
+  class length_cycle_tuner {
+    std::function<double()> observable;
+    double target_fraction;
+    int64_t min_length_cycle, max_length_cycle;
+    stat::accumulator<double> acc{0.0, -1};
+
+    public:
+    /// Minimal number of bins of the binning level used for the estimate
+    static constexpr long min_bins = 64;
+
+    /**
+     * @param observable The observable, evaluated on the current configuration
+     * @param target_fraction The length of the cycle as a fraction of the autocorrelation time
+     * @param min_length_cycle Lower bound of the length of the cycle
+     * @param max_length_cycle Upper bound of the length of the cycle
+     */
+    length_cycle_tuner(std::function<double()> observable, double target_fraction, int64_t min_length_cycle, int64_t max_length_cycle)
+       : observable(std::move(observable)), target_fraction(target_fraction), min_length_cycle(min_length_cycle), max_length_cycle(max_length_cycle) {
+      if (target_fraction <= 0) TRIQS_RUNTIME_ERROR << "length_cycle_tuner: the target fraction must be positive";
+      if (min_length_cycle < 1 or max_length_cycle < min_length_cycle)
+        TRIQS_RUNTIME_ERROR << "length_cycle_tuner: invalid bounds [" << min_length_cycle << ", " << max_length_cycle << "] for the length of the cycle";
+    }
+
+    /// Discard all samples
+    void reset() { acc = stat::accumulator<double>{0.0, -1}; }
+
+    /// Sample the observable on the current configuration
+    void sample() { acc << observable(); }
+
+    /**
+     * Estimate the autocorrelation time from the samples of all ranks, and choose the length of the cycle
+     *
+     * The errors are reduced onto the rank with the most binning levels. The estimate is made there
+     * and broadcast, so that all ranks get the same length of the cycle.
+     *
+     * @param current_length_cycle The length of the cycle kept if the observable has no fluctuation
+     * @param c The mpi communicator. Collective call.
+     */
+    [[nodiscard]] length_cycle_estimate estimate(int64_t current_length_cycle, mpi::communicator c) const {
+      if (not mpi::has_env or c.size() == 1) return estimate_from(acc.log_bin_errors(), current_length_cycle);
+
+      // The reducing rank of log_bin_errors_all_reduce
+      auto n_levels = mpi::all_gather(std::vector<long>{acc.n_log_bins()}, c);
+      int root      = std::distance(n_levels.begin(), std::max_element(n_levels.begin(), n_levels.end()));
+
+      auto errors = acc.log_bin_errors_all_reduce(c);
+      auto res    = length_cycle_estimate{};
+      if (c.rank() == root) res = estimate_from(std::move(errors), current_length_cycle);
+      mpi::broadcast(res, c, root);
+      return res;
+    }
+
+    private:
+    // The estimate from the errors and counts of the logarithmic binning levels
+    length_cycle_estimate estimate_from(std::pair<std::vector<double>, std::vector<long>> errors_counts, int64_t current_length_cycle) const {
+      auto &[errors, counts] = errors_counts;
+
+      length_cycle_estimate res;
+      res.length_cycle   = current_length_cycle;
+      res.n_samples      = counts.empty() ? 0 : counts[0];
+      res.log_bin_errors = errors;
+      res.log_bin_counts = counts;
+      if (res.n_samples < 2 or errors[0] <= 0) return res; // no fluctuation: nothing to estimate
+
+      auto tau_at = [&](int n) { return std::max(0.0, stat::tau_estimate_from_errors(errors[n], errors[0])); };
+
+      int level = 0;
+      while (level + 1 < int(counts.size()) and counts[level + 1] >= min_bins) ++level;
+      res.binning_level = level;
+      res.tau           = tau_at(level);
+      res.converged     = (level >= 1) and (res.tau <= 1.2 * tau_at(level - 1) + 0.5);
+      res.length_cycle  = std::clamp<int64_t>(std::llround(target_fraction * res.tau), min_length_cycle, max_length_cycle);
+      return res;
+    }
+  };
+
+} // namespace triqs::mc_tools
@@ -23,14 +23,112 @@
 #include <mpi/mpi.hpp>
 #include <triqs/utility/exceptions.hpp>
 #include <triqs/utility/timer.hpp>
+#include "./mc_timing.hpp"
+#include <condition_variable>
+#include <exception>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <cassert>
 #include <iomanip>
 
 namespace triqs {
   namespace mc_tools {
 
+    namespace details {
+
+      // Interface of the asynchronous accumulation of a measure
+      template <typename MCSignType> struct async_measure_base {
+        virtual ~async_measure_base()             = default;
+        virtual void push(MCSignType const &sign) = 0;
+        virtual void drain()                      = 0;
+      };
+
+      /*
+       * Asynchronous accumulation of a measure m modeling the SnapshotMeasure concept, i.e. with
+       *   - a type snapshot_t,
+       *   - void take_snapshot(snapshot_t &s, MCSignType sign), which copies the part of the configuration needed into s,
+       *   - void accumulate_snapshot(snapshot_t const &s), which accumulates the measure from s.
+       *
+       * take_snapshot is called on the Markov chain thread, and fills a slot of a preallocated ring buffer.
+       * A worker thread calls accumulate_snapshot on the slots in order, so the result is the same as
+       * for the synchronous accumulation. If the buffer is full, push waits for a free slot (back-pressure).
+       * An exception in the worker is rethrown on the Markov chain thread by the next push or drain.
+       */
+      template <typename M, typename MCSignType> class async_measure : public async_measure_base<MCSignType> {
+        using snapshot_t = typename M::snapshot_t;
+
+        M *m;
+        std::vector<snapshot_t> ring;
+        uint64_t n_pushed = 0, n_done = 0; // the slots [n_done, n_pushed) are waiting for the worker
+        bool stop_requested = false;
+        std::exception_ptr error;
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::thread worker;
+
+        void work() {
+          std::unique_lock lock{mtx};
+          while (true) {
+            cv.wait(lock, [this] { return stop_requested or n_done < n_pushed; });
+            if (n_done == n_pushed) return; // stop requested and nothing left
+            auto &slot = ring[n_done % ring.size()];
+            bool skip  = bool(error);
+            lock.unlock();
+            std::exception_ptr e;
+            try {
+              if (!skip) m->accumulate_snapshot(slot);
+            } catch (...) { e = std::current_exception(); }
+            lock.lock();
+            if (e) error = e;
+            ++n_done;
+            cv.notify_all();
+          }
+        }
+
+        // call with the lock held
+        void rethrow() {
+          if (error) std::rethrow_exception(std::exchange(error, nullptr));
+        }
+
+        public:
+        async_measure(M *m, size_t buffer_size) : m(m), ring(buffer_size) {
+          if (buffer_size == 0) TRIQS_RUNTIME_ERROR << "async_measure: the size of the buffer must be positive";
+          worker = std::thread{[this] { work(); }};
+        }
+
+        ~async_measure() override {
+          {
+            std::lock_guard lock{mtx};
+            stop_requested = true;
+          }
+          cv.notify_all();
+          worker.join();
+        }
+
+        void push(MCSignType const &sign) override {
+          std::unique_lock lock{mtx};
+          cv.wait(lock, [this] { return n_pushed - n_done < ring.size(); });
+          rethrow();
+          lock.unlock();
+          m->take_snapshot(ring[n_pushed % ring.size()], sign); // the slot is not used by the worker
+          lock.lock();
+          ++n_pushed;
+          cv.notify_all();
+        }
+
+        void drain() override {
+          std::unique_lock lock{mtx};
+          cv.wait(lock, [this] { return n_done == n_pushed; });
+          rethrow();
+        }
+      };
+
+    } // namespace details
+
     // similar technique as move, cf move_set.
     template <typename MCSignType> class measure {
 
@@ -40,6 +138,10 @@ namespace triqs {
       std::function<std::string()> report_;
       std::function<void(h5::group, std::string const &)> h5_r, h5_w;
 
+      // asynchronous accumulation, only for measures modeling the SnapshotMeasure concept
+      std::function<std::unique_ptr<details::async_measure_base<MCSignType>>(size_t)> make_async_;
+      std::unique_ptr<details::async_measure_base<MCSignType>> async_;
+
       uint64_t count_;
       bool enable_timer;
       utility::timer Timer;
@@ -76,6 +178,12 @@ namespace triqs {
           if constexpr (requires { h5_write(g, name, *p); }) h5_write(g, name, *p);
           else (void)p; // suppress clang -Wunused-lambda-capture warning
         };
+        if constexpr (requires(typename m_t::snapshot_t &s, typename m_t::snapshot_t const &cs) {
+                        p->take_snapshot(s, std::declval<MCSignType>());
+                        p->accumulate_snapshot(cs);
+                      }) {
+          make_async_ = [p](size_t buffer_size) { return std::make_unique<details::async_measure<m_t, MCSignType>>(p, buffer_size); };
+        }
       }
 
       //
@@ -88,23 +196,51 @@ namespace triqs {
         assert(impl_);
         count_++;
         if (enable_timer) Timer.start();
-        accumulate_(signe);
+        if (async_)
+          async_->push(signe); // the timer measures the snapshot only
+        else
+          accumulate_(signe);
         if (enable_timer) Timer.stop();
       }
       void collect_results(mpi::communicator const &c) {
+        drain();
         if (enable_timer) Timer.start();
         collect_results_(c);
         if (enable_timer) Timer.stop();
       }
-      std::string report() const { return report_(); }
+      std::string report() const {
+        drain();
+        return report_();
+      }
+
+      /// Can the measure be accumulated asynchronously, i.e. does it model the SnapshotMeasure concept
+      bool supports_async() const { return bool(make_async_); }
+
+      /**
+       * Switch the asynchronous accumulation on or off. Measures that do not support it stay synchronous.
+       * @param async Accumulate on a worker thread
+       * @param buffer_size Number of snapshots in the ring buffer
+       */
+      void set_async(bool async, size_t buffer_size) {
+        drain();
+        async_.reset();
+        if (async and make_async_) async_ = make_async_(buffer_size);
+      }
+
+      /// Wait for the asynchronous accumulation of all snapshots taken so far
+      void drain() const {
+        if (async_) async_->drain();
+      }
 
       uint64_t count() const { return count_; }
       double duration() const { return double(Timer); }
 
       friend void h5_write(h5::group g, std::string const &name, measure const &m) {
+        m.drain();
         if (m.h5_w) m.h5_w(g, name);
       };
       friend void h5_read(h5::group g, std::string const &name, measure &m) {
+        m.drain();
         if (m.h5_r) m.h5_r(g, name);
       };
     };
@@ -137,6 +273,20 @@ namespace triqs {
         return itr;
       }
 
+      /**
+       * Switch the asynchronous accumulation on or off for all measures supporting it
+       * @param async Accumulate on worker threads, one per measure
+       * @param buffer_size Number of snapshots in the ring buffer of each measure
+       */
+      void set_async(bool async, size_t buffer_size) {
+        for (auto &[name, m] : m_map) m.set_async(async, buffer_size);
+      }
+
+      /// Wait for the asynchronous accumulation of all measures
+      void drain() const {
+        for (auto &[name, m] : m_map) m.drain();
+      }
+
       /**
        * Remove the measure m.
        */
@@ -188,6 +338,30 @@ namespace triqs {
         return s.str();
       }
 
+      /// Number of calls and time of all measures as a JSON object name -> {count, duration}
+      std::string get_timings_json() const {
+        std::ostringstream s;
+        s << "{";
+        bool first = true;
+        for (auto &[name, m] : m_map) {
+          s << (first ? "" : ", ") << "\"" << name << R"(": {"count": )" << m.count() << R"(, "duration": )" << details::json_number(m.duration())
+            << "}";
+          first = false;
+        }
+        s << "}";
+        return s.str();
+      }
+
+      /// Write the number of calls and time of all measures to HDF5, one subgroup per measure
+      void write_timings(h5::group g, std::string const &key) const {
+        auto gr = g.create_group(key);
+        for (auto &[name, m] : m_map) {
+          auto mgr = gr.create_group(name);
+          h5::write(mgr, "count", long(m.count()));
+          h5::write(mgr, "duration", m.duration());
+        }
+      }
+
       // gather result for all measure, on communicator c
       void collect_results(mpi::communicator const &c) {
         for (auto &[name, m] : m_map) m.collect_results(c);
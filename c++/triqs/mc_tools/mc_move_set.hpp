@@ -23,7 +23,9 @@
 #include <triqs/utility/exceptions.hpp>
 #include <mpi/mpi.hpp>
 #include <functional>
+#include <iomanip>
 #include "./random_generator.hpp"
+#include "./mc_timing.hpp"
 
 namespace triqs {
   namespace mc_tools {
@@ -48,6 +50,7 @@ namespace triqs {
       uint64_t NProposed, Naccepted;
       double acceptance_rate_;
       bool is_move_set_; // need to remember if the move was a move_set for printing details later.
+      call_timing timing_attempt, timing_accept, timing_reject; // only used if timing_enabled
 
 #ifdef TRIQS_MCTOOLS_DEBUG
       static constexpr bool debug = true;
@@ -97,13 +100,24 @@ namespace triqs {
 
       MCSignType attempt() {
         NProposed++;
-        return attempt_();
+        if constexpr (timing_enabled)
+          return timing_attempt(attempt_);
+        else
+          return attempt_();
       }
       MCSignType accept() {
         Naccepted++;
-        return accept_();
+        if constexpr (timing_enabled)
+          return timing_accept(accept_);
+        else
+          return accept_();
+      }
+      void reject() {
+        if constexpr (timing_enabled)
+          timing_reject(reject_);
+        else
+          reject_();
       }
-      void reject() { reject_(); }
 
       double acceptance_rate() const { return acceptance_rate_; }
       uint64_t n_proposed_config() const { return NProposed; }
@@ -113,8 +127,16 @@ namespace triqs {
         NProposed        = 0;
         Naccepted        = 0;
         acceptance_rate_ = -1;
+        timing_attempt.clear();
+        timing_accept.clear();
+        timing_reject.clear();
       }
 
+      /// Timing of the attempt, accept and reject calls (with TRIQS_MCTOOLS_TIMING)
+      call_timing const &attempt_timing() const { return timing_attempt; }
+      call_timing const &accept_timing() const { return timing_accept; }
+      call_timing const &reject_timing() const { return timing_reject; }
+
       void collect_statistics(mpi::communicator const &c) {
         uint64_t nacc_tot  = mpi::all_reduce(Naccepted, c);
         uint64_t nprop_tot = mpi::all_reduce(NProposed, c);
@@ -293,6 +315,60 @@ namespace triqs {
         return s.str();
       }
 
+      /// Pretty printing of the estimated time spent in the moves (with TRIQS_MCTOOLS_TIMING)
+      std::string get_timings(std::string decal = "") const {
+        std::ostringstream s;
+        int wsec    = 12;
+        size_t wlab = 18;
+        for (auto const &n : names_) wlab = std::max(wlab, n.size() + decal.size());
+        if (decal.empty())
+          s << std::left << std::setw(wlab) << "Move" << " | " << std::setw(wsec) << "attempt [s]" << " | " << std::setw(wsec) << "accept [s]"
+            << " | " << std::setw(wsec) << "reject [s]" << "\n";
+        for (unsigned int u = 0; u < move_vec.size(); ++u) {
+          auto const &m = move_vec[u];
+          s << std::left << std::setw(wlab) << decal + names_[u] << " | " << std::setw(wsec) << m.attempt_timing().estimated_time() << " | "
+            << std::setw(wsec) << m.accept_timing().estimated_time() << " | " << std::setw(wsec) << m.reject_timing().estimated_time() << "\n";
+          if (auto ms = m.as_move_set()) s << ms->get_timings(decal + "  ");
+        }
+        return s.str();
+      }
+
+      /// Statistics and timings of all moves as a JSON object name -> statistics. Move sets are nested under "moves".
+      std::string get_statistics_json() const {
+        std::ostringstream s;
+        s << "{";
+        for (unsigned int u = 0; u < move_vec.size(); ++u) {
+          auto const &m = move_vec[u];
+          s << (u ? ", " : "") << "\"" << names_[u] << R"(": {"n_proposed": )" << m.n_proposed_config() << R"(, "n_accepted": )"
+            << m.n_accepted_config() << R"(, "acceptance_rate": )" << details::json_number(m.acceptance_rate());
+          if constexpr (timing_enabled)
+            s << R"(, "attempt": )" << m.attempt_timing().to_json() << R"(, "accept": )" << m.accept_timing().to_json() << R"(, "reject": )"
+              << m.reject_timing().to_json();
+          if (auto ms = m.as_move_set()) s << R"(, "moves": )" << ms->get_statistics_json();
+          s << "}";
+        }
+        s << "}";
+        return s.str();
+      }
+
+      /// Write the statistics and timings of all moves to HDF5, one subgroup per move
+      void write_statistics(h5::group g, std::string const &name) const {
+        auto gr = g.create_group(name);
+        for (unsigned int u = 0; u < move_vec.size(); ++u) {
+          auto const &m = move_vec[u];
+          auto mgr      = gr.create_group(names_[u]);
+          h5::write(mgr, "n_proposed", long(m.n_proposed_config()));
+          h5::write(mgr, "n_accepted", long(m.n_accepted_config()));
+          h5::write(mgr, "acceptance_rate", m.acceptance_rate());
+          if constexpr (timing_enabled) {
+            h5_write(mgr, "attempt", m.attempt_timing());
+            h5_write(mgr, "accept", m.accept_timing());
+            h5_write(mgr, "reject", m.reject_timing());
+          }
+          if (auto ms = m.as_move_set()) ms->write_statistics(mgr, "moves");
+        }
+      }
+
       private:
       void normaliseProba() { // Computes the normalised accumulated probability
         if (move_vec.size() == 0) TRIQS_RUNTIME_ERROR << " no moves registered";
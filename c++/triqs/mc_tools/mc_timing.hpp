@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include <h5/h5.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace triqs::mc_tools {
+
+  // The timing of the moves and of the Monte-Carlo loop is compiled in only with TRIQS_MCTOOLS_TIMING
+#ifdef TRIQS_MCTOOLS_TIMING
+  inline constexpr bool timing_enabled = true;
+#else
+  inline constexpr bool timing_enabled = false;
+#endif
+
+  namespace details {
+    // A double as a JSON number, null if not finite
+    inline std::string json_number(double x) {
+      if (!std::isfinite(x)) return "null";
+      std::ostringstream s;
+      s << std::setprecision(17) << x;
+      return s.str();
+    }
+  } // namespace details
+
+  /**
+   * Sampled timing of the calls to a function, with a histogram of the latency per call
+   *
+   * Only one call out of sample_period is timed with std::chrono::steady_clock, so that the overhead stays small
+   * for functions of a few tens of nanoseconds. The total time is estimated from the sampled calls.
+   * The latency histogram has logarithmic bins: bin n counts the sampled calls lasting [2^n, 2^(n+1)) ns.
+   */
+  class call_timing {
+    using clock_t = std::chrono::steady_clock;
+
+    public:
+    static constexpr uint64_t sample_period = 16;
+    static constexpr int n_latency_bins     = 40;
+
+    private:
+    uint64_t _n_calls = 0, _n_sampled = 0;
+    double _sampled_time = 0; // in seconds
+    std::array<uint64_t, n_latency_bins> _latency_histogram{};
+
+    void record(clock_t::duration d) {
+      auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+      int bin = std::min<int>(std::bit_width(ns | 1) - 1, n_latency_bins - 1);
+      ++_latency_histogram[bin];
+      ++_n_sampled;
+      _sampled_time += std::chrono::duration<double>(d).count();
+    }
+
+    public:
+    /// Call f(), timing one call out of sample_period
+    template <typename F> decltype(auto) operator()(F &&f) {
+      if (_n_calls++ % sample_period != 0) return std::forward<F>(f)();
+      struct guard_t {
+        call_timing *t;
+        clock_t::time_point start = clock_t::now();
+        ~guard_t() { t->record(clock_t::now() - start); }
+      } guard{this};
+      return std::forward<F>(f)();
+    }
+
+    /// Number of calls
+    [[nodiscard]] uint64_t n_calls() const { return _n_calls; }
+
+    /// Number of timed calls
+    [[nodiscard]] uint64_t n_sampled() const { return _n_sampled; }
+
+    /// Total duration of the timed calls in seconds
+    [[nodiscard]] double sampled_time() const { return _sampled_time; }
+
+    /// Estimation of the total duration of all calls in seconds
+    [[nodiscard]] double estimated_time() const { return _n_sampled == 0 ? 0.0 : _sampled_time * double(_n_calls) / double(_n_sampled); }
+
+    /// Histogram of the latency of the timed calls
+    [[nodiscard]] std::array<uint64_t, n_latency_bins> const &latency_histogram() const { return _latency_histogram; }
+
+    /// Reset all counters
+    void clear() { *this = call_timing{}; }
+
+    /// The timing as a JSON object
+    [[nodiscard]] std::string to_json() const {
+      std::ostringstream s;
+      s << R"({"n_calls": )" << _n_calls << R"(, "n_sampled": )" << _n_sampled << R"(, "sampled_time": )" << details::json_number(_sampled_time)
+        << R"(, "estimated_time": )" << details::json_number(estimated_time()) << R"(, "latency_histogram_log2_ns": [)";
+      for (int n = 0; n < n_latency_bins; ++n) s << (n ? ", " : "") << _latency_histogram[n];
+      s << "]}";
+      return s.str();
+    }
+
+    friend void h5_write(h5::group g, std::string const &name, call_timing const &t) {
+      auto gr = g.create_group(name);
+      h5::write(gr, "n_calls", long(t._n_calls));
+      h5::write(gr, "n_sampled", long(t._n_sampled));
+      h5::write(gr, "sampled_time", t._sampled_time);
+      h5::write(gr, "estimated_time", t.estimated_time());
+      h5::write(gr, "latency_histogram_log2_ns", std::vector<long>(t._latency_histogram.begin(), t._latency_histogram.end()));
+    }
+  };
+
+} // namespace triqs::mc_tools
@@ -27,6 +27,7 @@
 #include <boost/random/ranlux.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <sstream>
+#include <utility>
 #include <boost/preprocessor/seq.hpp>
 #include <boost/preprocessor/control/if.hpp>
 
@@ -38,26 +39,79 @@
 namespace triqs {
   namespace mc_tools {
 
+    namespace {
+
+      // The engine of a generator G: the boost engine of a variate_generator, or G itself
+      template <typename G> auto &engine_of(G &g) {
+        if constexpr (requires { g.engine(); })
+          return g.engine();
+        else
+          return g;
+      }
+
+      // The state is the text representation of the engine, as given by its stream operators
+      template <typename G> struct rng_engine_impl : details::rng_engine {
+        G g;
+
+        template <typename... Args> explicit rng_engine_impl(Args &&...args) : g(std::forward<Args>(args)...) {}
+
+        double operator()() override { return g(); }
+
+        std::string get_state() const override {
+          std::ostringstream os;
+          os << engine_of(g);
+          return os.str();
+        }
+
+        void set_state(std::string const &state) override {
+          std::istringstream is(state);
+          is >> engine_of(g);
+          if (is.fail()) TRIQS_RUNTIME_ERROR << "random_generator: invalid state of the engine";
+        }
+      };
+
+    } // namespace
+
     random_generator::random_generator(std::string const &RandomGeneratorName, uint32_t seed_) {
       _name = RandomGeneratorName;
 
       if (RandomGeneratorName == "") {
-        gen = utility::buffered_function<double>(mc_tools::RandomGenerators::RandMT(seed_));
-        return;
-      }
+        engine = std::make_shared<rng_engine_impl<RandomGenerators::RandMT>>(seed_);
+      } else {
 
-      boost::uniform_real<> dis;
+        boost::uniform_real<> dis;
 
 // now boost random number generators
 #define DRNG(r, data, XX)                                                                                                                            \
-  if (RandomGeneratorName == AS_STRING(XX)) {                                                                                                        \
-    gen = utility::buffered_function<double>(boost::variate_generator<boost::XX, boost::uniform_real<>>(boost::XX(seed_), dis));                     \
-    return;                                                                                                                                          \
-  }
+  if (RandomGeneratorName == AS_STRING(XX))                                                                                                          \
+    engine = std::make_shared<rng_engine_impl<boost::variate_generator<boost::XX, boost::uniform_real<>>>>(boost::XX(seed_), dis);
+
+        BOOST_PP_SEQ_FOR_EACH(DRNG, ~, RNG_LIST)
 
-      BOOST_PP_SEQ_FOR_EACH(DRNG, ~, RNG_LIST)
+        if (!engine) TRIQS_RUNTIME_ERROR << "The random generator " << RandomGeneratorName << " is not recognized";
+      }
+
+      // the engine is not moved with the random_generator, the pointer stays valid
+      gen = utility::buffered_function<double>([e = engine.get()]() { return (*e)(); });
+    }
+
+    //---------------------------------------------
+
+    void h5_write(h5::group g, std::string const &name, random_generator const &rng) {
+      auto gr = g.create_group(name);
+      write_hdf5_format(gr, rng);
+      h5::write(gr, "name", rng._name);
+      h5::write(gr, "engine_state", rng.engine->get_state());
+      h5::write(gr, "buffer", rng.gen.get_buffer());
+      h5::write(gr, "buffer_index", long(rng.gen.get_index()));
+    }
 
-      TRIQS_RUNTIME_ERROR << "The random generator " << RandomGeneratorName << " is not recognized";
+    void h5_read(h5::group g, std::string const &name, random_generator &rng) {
+      auto gr = g.open_group(name);
+      assert_hdf5_format(gr, rng, true);
+      rng = random_generator(h5::read<std::string>(gr, "name"), 0);
+      rng.engine->set_state(h5::read<std::string>(gr, "engine_state"));
+      rng.gen.set_buffer(h5::read<std::vector<double>>(gr, "buffer"), h5::read<long>(gr, "buffer_index"));
     }
 
     //---------------------------------------------
@@ -21,7 +21,9 @@
 #include <triqs/utility/first_include.hpp>
 #include "../utility/exceptions.hpp"
 #include "../utility/buffered_function.hpp"
+#include <h5/h5.hpp>
 #include <cmath>
+#include <memory>
 #include <string>
 #include <assert.h>
 #include <type_traits>
@@ -34,13 +36,27 @@ namespace triqs {
     std::string random_generator_names(std::string const &sep = " ");
     std::vector<std::string> random_generator_names_list();
 
+    namespace details {
+      // The type-erased engine of a random_generator, with access to its state (cf random_generator.cpp)
+      struct rng_engine {
+        virtual ~rng_engine()                       = default;
+        virtual double operator()()                 = 0;
+        virtual std::string get_state() const       = 0;
+        virtual void set_state(std::string const &) = 0;
+      };
+    } // namespace details
+
     /**
   * Random generator, adapting the boost random generator.
   *
   * The name of the generator is given at construction, and its type is erased in this class.
   * For performance, the call to the generator is bufferized, with chunks of 1000 numbers.
+  *
+  * The full state (engine and buffer) can be written to and read from HDF5, so that a restarted
+  * calculation continues with the same sequence of numbers.
   */
     class random_generator {
+      std::shared_ptr<details::rng_engine> engine;
       utility::buffered_function<double> gen;
       std::string _name;
 
@@ -82,6 +98,14 @@ namespace triqs {
         assert(b > a);
         return a + (b - a) * (gen());
       }
+
+      [[nodiscard]] static std::string hdf5_format() { return "RandomGenerator"; }
+
+      /// Write the full state of the generator to HDF5
+      friend void h5_write(h5::group g, std::string const &name, random_generator const &rng);
+
+      /// Read the full state of the generator from HDF5
+      friend void h5_read(h5::group g, std::string const &name, random_generator &rng);
     };
   } // namespace mc_tools
 } // namespace triqs
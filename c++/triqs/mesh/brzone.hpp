@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include "utils.hpp"
 #include <triqs/lattice/brillouin_zone.hpp>
@@ -40,13 +41,23 @@ namespace triqs::mesh {
 
     // -------------------- Data -------------------
     private:
-    brillouin_zone bz_        = {};
-    std::array<long, 3> dims_ = {0, 0, 0};
-    long size_                = 0;
+    // The geometry is immutable and shared by all copies of the mesh, which makes copies cheap
+    struct geometry_t {
+      brillouin_zone bz             = {};
+      nda::matrix<double> units     = nda::eye<double>(3);
+      nda::matrix<double> units_inv = nda::eye<double>(3);
+    };
+
+    std::shared_ptr<const geometry_t> geo_ = std::make_shared<const geometry_t>();
+    std::array<long, 3> dims_              = {0, 0, 0};
+    long size_                             = 0;
     long stride1 = 1, stride0 = 1;
-    nda::matrix<double> units_     = nda::eye<double>(3);
-    nda::matrix<double> units_inv_ = nda::eye<double>(3);
-    uint64_t _mesh_hash            = 0;
+    uint64_t _mesh_hash = 0;
+
+    static std::shared_ptr<const geometry_t> make_geometry(brillouin_zone const &bz, std::array<long, 3> const &dims) {
+      auto units = nda::matrix<double>{inverse(1.0 * nda::diag(dims)) * bz.units()};
+      return std::make_shared<const geometry_t>(geometry_t{bz, units, inverse(units)});
+    }
 
     // -------------------- Constructors -------------------
     public:
@@ -65,13 +76,11 @@ namespace triqs::mesh {
      * @param dims The extents for each of the three dimensions
      */
     brzone(brillouin_zone const &bz, std::array<long, 3> const &dims)
-       : bz_(bz),
+       : geo_(make_geometry(bz, dims)),
          dims_(dims),
          size_(nda::stdutil::product(dims)),
          stride1(dims_[2]),
          stride0(dims_[1] * dims_[2]),
-         units_(inverse(1.0 * nda::diag(dims)) * bz.units()),
-         units_inv_(inverse(units_)),
          _mesh_hash(hash(sum(bz.units()), dims[0], dims[1], dims[2])) {}
 
     ///
@@ -113,9 +122,9 @@ namespace triqs::mesh {
     [[nodiscard]] std::array<long, 3> dims() const { return dims_; }
 
     /// Matrix containing the mesh basis vectors as rows
-    [[nodiscard]] nda::matrix_const_view<double> units() const { return units_; }
+    [[nodiscard]] nda::matrix_const_view<double> units() const { return geo_->units; }
 
-    brillouin_zone const &bz() const noexcept { return bz_; }
+    brillouin_zone const &bz() const noexcept { return geo_->bz; }
 
     // ----------------------------------------
 
@@ -225,7 +234,7 @@ namespace triqs::mesh {
       else {
         // calculate k in the brzone basis
         auto ks      = nda::stack_vector<double, 3>{k[0], k[1], k[2]};
-        auto k_units = transpose(units_inv_) * ks;
+        auto k_units = transpose(geo_->units_inv) * ks;
         auto n       = nda::floor(k_units);
 
         // calculate position relative to neighbors in mesh
@@ -284,7 +293,7 @@ namespace triqs::mesh {
     /// Convert an index to the domain value
     [[nodiscard]] value_t to_value(index_t const &index) const {
       EXPECTS(is_index_valid(index));
-      return transpose(units_)(range::all, range(bz_.lattice().ndim())) * nda::basic_array_view{index}(range(bz_.lattice().ndim()));
+      return transpose(geo_->units)(range::all, range(geo_->bz.lattice().ndim())) * nda::basic_array_view{index}(range(geo_->bz.lattice().ndim()));
     }
 
     // -------------------- print -------------------
@@ -315,7 +324,7 @@ namespace triqs::mesh {
       write_hdf5_format(gr, m);
 
       h5::write(gr, "dims", m.dims_);
-      h5::write(gr, "brillouin_zone", m.bz_);
+      h5::write(gr, "brillouin_zone", m.geo_->bz);
     }
 
     friend void h5_read(h5::group fg, std::string const &subgroup_name, brzone &m) {
@@ -365,7 +374,7 @@ namespace triqs::mesh {
       if constexpr (is_k_expr<V>)
         return evaluate(m, f, v.value());
       else {
-        auto v_index      = make_regular(transpose(m.units_inv_) * nda::basic_array_view{v});
+        auto v_index      = make_regular(transpose(m.geo_->units_inv) * nda::basic_array_view{v});
         auto g            = [&f](long x, long y, long z) { return f(typename brzone::index_t{x, y, z}); };
         auto [d0, d1, d2] = m.dims();
         return evaluate(std::tuple{brzone1d{d0}, brzone1d{d1}, brzone1d{d2}}, g, v_index[0], v_index[1], v_index[2]);
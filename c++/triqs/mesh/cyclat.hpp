@@ -18,6 +18,7 @@
 // Authors: Thomas Ayral, Philipp Dumitrescu, Michel Ferrero, Olivier Parcollet, Nils Wentzell
 
 #pragma once
+#include <memory>
 #include "utils.hpp"
 #include <triqs/lattice/bravais_lattice.hpp>
 
@@ -35,13 +36,18 @@ namespace triqs::mesh {
 
     // -------------------- Data -------------------
     private:
-    bravais_lattice bl_       = {};
-    std::array<long, 3> dims_ = {0, 0, 0};
-    long size_                = 0;
+    // The geometry is immutable and shared by all copies of the mesh, which makes copies cheap
+    struct geometry_t {
+      bravais_lattice bl            = {};
+      nda::matrix<double> units     = nda::eye<double>(3);
+      nda::matrix<double> units_inv = nda::eye<double>(3);
+    };
+
+    std::shared_ptr<const geometry_t> geo_ = std::make_shared<const geometry_t>();
+    std::array<long, 3> dims_              = {0, 0, 0};
+    long size_                             = 0;
     long stride1 = 1, stride0 = 1;
-    nda::matrix<double> units_     = nda::eye<double>(3);
-    nda::matrix<double> units_inv_ = nda::eye<double>(3);
-    uint64_t _mesh_hash            = 0;
+    uint64_t _mesh_hash = 0;
 
     // -------------------- Constructors -------------------
     public:
@@ -52,13 +58,11 @@ namespace triqs::mesh {
      * @param dims The extents for each of the three dimensions
      */
     cyclat(bravais_lattice const &bl, std::array<long, 3> const &dims)
-       : bl_(bl),
+       : geo_(std::make_shared<const geometry_t>(geometry_t{bl, bl.units(), inverse(bl.units())})),
          dims_(dims),
          size_(nda::stdutil::product(dims)),
          stride1(dims_[2]),
          stride0(dims_[1] * dims_[2]),
-         units_(bl.units()),
-         units_inv_(inverse(units_)),
          _mesh_hash(hash(sum(bl.units()), dims[0], dims[1], dims[2])) {}
 
     cyclat(bravais_lattice const &bl, nda::matrix<long> const &pm) : cyclat(bl, std::array{pm(0, 0), pm(1, 1), pm(2, 2)}) {
@@ -98,9 +102,9 @@ namespace triqs::mesh {
     [[nodiscard]] std::array<long, 3> dims() const { return dims_; }
 
     /// Matrix containing the mesh basis vectors as rows
-    [[nodiscard]] nda::matrix_const_view<double> units() const { return units_; }
+    [[nodiscard]] nda::matrix_const_view<double> units() const { return geo_->units; }
 
-    bravais_lattice const &lattice() const noexcept { return bl_; }
+    bravais_lattice const &lattice() const noexcept { return geo_->bl; }
 
     // ----------------------------------------
 
@@ -170,7 +174,7 @@ namespace triqs::mesh {
     [[nodiscard]] mesh_point_t operator[](long data_index) const {
       auto index = to_index(data_index);
       EXPECTS(is_index_valid(index));
-      return {index, data_index, _mesh_hash, &bl_};
+      return {index, data_index, _mesh_hash, &geo_->bl};
     }
 
     [[nodiscard]] mesh_point_t operator[](closest_mesh_point_t<value_t> const &cmp) const { return (*this)[this->to_data_index(cmp)]; }
@@ -178,7 +182,7 @@ namespace triqs::mesh {
     [[nodiscard]] mesh_point_t operator()(index_t const &index) const {
       EXPECTS(is_index_valid(index));
       auto data_index = to_data_index(index);
-      return {index, data_index, _mesh_hash, &bl_};
+      return {index, data_index, _mesh_hash, &geo_->bl};
     }
 
     // -------------------- to_value -------------------
@@ -186,7 +190,7 @@ namespace triqs::mesh {
     /// Convert an index to a lattice value
     [[nodiscard]] value_t to_value(index_t const &index) const {
       EXPECTS(is_index_valid(index));
-      return {index, &bl_};
+      return {index, &geo_->bl};
     }
 
     // -------------------- print -------------------
@@ -217,7 +221,7 @@ namespace triqs::mesh {
       write_hdf5_format(gr, m); // NOLINT
 
       h5::write(gr, "dims", m.dims_);
-      h5::write(gr, "bravais_lattice", m.bl_);
+      h5::write(gr, "bravais_lattice", m.geo_->bl);
     }
 
     friend void h5_read(h5::group fg, std::string const &subgroup_name, cyclat &m) {
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "./dlr.hpp"
+#include <triqs/utility/bounded_cache.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace triqs::mesh {
+
+  namespace {
+
+    // (lambda, eps, statistic, symmetrize)
+    using dlr_ops_key = std::tuple<double, double, int, bool>;
+
+    // The process-wide cache. It is emptied when full, the meshes own their operations.
+    utility::bounded_cache<dlr_ops_key, dlr_ops> &cache() {
+      static utility::bounded_cache<dlr_ops_key, dlr_ops> c{32};
+      return c;
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  std::shared_ptr<const dlr_ops> make_dlr_ops(double lambda, double eps, statistic_enum statistic, bool symmetrize) {
+    // Built outside the lock of the cache: concurrent requests of other parameters are not blocked,
+    // concurrent requests of the same parameters wait for the first one, which builds only once
+    return cache().get({lambda, eps, int(statistic), symmetrize}, [&] {
+      auto freq = cppdlr::build_dlr_rf(lambda, eps, symmetrize);
+      return dlr_ops{freq, {lambda, freq, symmetrize}, {lambda, freq, static_cast<cppdlr::statistic_t>(statistic), symmetrize}};
+    });
+  }
+
+  //-------------------------------------------------------
+
+  std::shared_ptr<const dlr_ops> find_dlr_ops(double lambda, double eps, statistic_enum statistic, bool symmetrize,
+                                              nda::vector<double> const &dlr_freq) {
+    auto res = cache().find({lambda, eps, int(statistic), symmetrize});
+    if (not res or not std::equal(dlr_freq.begin(), dlr_freq.end(), res->freq.begin(), res->freq.end())) return {};
+    return res;
+  }
+
+  //-------------------------------------------------------
+
+  dlr_ops_cache_stats dlr_ops_cache_info() {
+    auto info = cache().info();
+    return {info.hits, info.misses, info.size};
+  }
+
+  void dlr_ops_cache_clear() { cache().clear(); }
+
+} // namespace triqs::mesh
@@ -33,6 +33,36 @@ namespace triqs::mesh {
     cppdlr::imfreq_ops imf;
   };
 
+  /// Statistics of the process-wide cache of DLR operations
+  struct dlr_ops_cache_stats {
+    long hits   = 0;
+    long misses = 0;
+    long size   = 0;
+  };
+
+  /**
+   * The DLR operations for the energy cutoff lambda = w_max * beta
+   *
+   * The operations are built once and kept in a thread-safe process-wide cache of bounded size,
+   * keyed by (lambda, eps, statistic, symmetrize). All DLR meshes with the same parameters share them.
+   *
+   * @param lambda The dimensionless DLR cutoff
+   * @param eps Representation accuracy
+   * @param statistic Fermion or Boson
+   * @param symmetrize Whether to choose the nodes symmetrically
+   */
+  std::shared_ptr<const dlr_ops> make_dlr_ops(double lambda, double eps, statistic_enum statistic, bool symmetrize);
+
+  /// The cached DLR operations for the given parameters if their DLR frequencies are dlr_freq, nullptr otherwise. Does not build.
+  std::shared_ptr<const dlr_ops> find_dlr_ops(double lambda, double eps, statistic_enum statistic, bool symmetrize,
+                                              nda::vector<double> const &dlr_freq);
+
+  /// The hits, misses and size of the cache of DLR operations
+  dlr_ops_cache_stats dlr_ops_cache_info();
+
+  /// Empty the cache of DLR operations. Existing meshes keep their operations.
+  void dlr_ops_cache_clear();
+
   struct dlr {
 
     using index_t      = long;
@@ -72,24 +102,17 @@ namespace triqs::mesh {
      *            For fermionic/bosonic statistic enforces even/odd dlr-rank [default = false]
      */
     dlr(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize = false)
-       : dlr(beta, statistic, w_max, eps, symmetrize,
-             cppdlr::build_dlr_rf(w_max * beta, eps, symmetrize)) {}
+       : dlr(beta, statistic, w_max, eps, symmetrize, make_dlr_ops(w_max * beta, eps, statistic, symmetrize)) {}
 
     private:
-    dlr(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize, nda::vector<double> const &dlr_freq)
-       : dlr(beta, statistic, w_max, eps, symmetrize,
-             dlr_ops{dlr_freq,
-                     {w_max * beta, dlr_freq, symmetrize},
-                     {w_max * beta, dlr_freq, static_cast<cppdlr::statistic_t>(statistic), symmetrize}}) {}
-
-    dlr(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize, dlr_ops dlr)
+    dlr(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize, std::shared_ptr<const dlr_ops> dlr)
        : _beta(beta),
          _statistic(statistic),
          _w_max(w_max),
          _eps(eps),
          _symmetrize(symmetrize),
-         _mesh_hash(hash(beta, statistic, w_max, eps, sum(dlr.freq))),
-         _dlr{std::make_shared<dlr_ops>(std::move(dlr))} {}
+         _mesh_hash(hash(beta, statistic, w_max, eps, sum(dlr->freq))),
+         _dlr{std::move(dlr)} {}
 
     friend struct dlr_imtime;
     friend struct dlr_imfreq;
@@ -250,9 +273,15 @@ namespace triqs::mesh {
       bool symmetrize = false;
       h5::try_read(gr, "symmetrize", symmetrize);
       auto _dlr_freq  = h5::read<nda::vector<double>>(gr, "dlr_freq");
-      auto _dlr_it    = h5::read<cppdlr::imtime_ops>(gr, "dlr_it");
-      auto _dlr_if    = h5::read<cppdlr::imfreq_ops>(gr, "dlr_if");
-      m               = dlr(beta, statistic, w_max, eps, symmetrize, {_dlr_freq, _dlr_it, _dlr_if});
+
+      // Reuse the cached operations if they match the file, otherwise read them
+      auto ops = find_dlr_ops(w_max * beta, eps, statistic, symmetrize, _dlr_freq);
+      if (not ops) {
+        auto _dlr_it = h5::read<cppdlr::imtime_ops>(gr, "dlr_it");
+        auto _dlr_if = h5::read<cppdlr::imfreq_ops>(gr, "dlr_if");
+        ops          = std::make_shared<const dlr_ops>(dlr_ops{_dlr_freq, _dlr_it, _dlr_if});
+      }
+      m = dlr(beta, statistic, w_max, eps, symmetrize, std::move(ops));
     }
   };
 
@@ -66,24 +66,17 @@ namespace triqs::mesh {
      *            and number of tau-points [default = false]
      */
     dlr_imtime(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize = false)
-       : dlr_imtime(beta, statistic, w_max, eps, symmetrize,
-                    cppdlr::build_dlr_rf(w_max * beta, eps, symmetrize)) {}
+       : dlr_imtime(beta, statistic, w_max, eps, symmetrize, make_dlr_ops(w_max * beta, eps, statistic, symmetrize)) {}
 
     private:
-    dlr_imtime(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize, nda::vector<double> const &dlr_freq)
-       : dlr_imtime(beta, statistic, w_max, eps, symmetrize,
-                    dlr_ops{dlr_freq,
-                            {w_max * beta, dlr_freq, symmetrize},
-                            {w_max * beta, dlr_freq, static_cast<cppdlr::statistic_t>(statistic), symmetrize}}) {}
-
-    dlr_imtime(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize, dlr_ops dlr)
+    dlr_imtime(double beta, statistic_enum statistic, double w_max, double eps, bool symmetrize, std::shared_ptr<const dlr_ops> dlr)
        : _beta(beta),
          _statistic(statistic),
          _w_max(w_max),
          _eps(eps),
          _symmetrize(symmetrize),
-         _mesh_hash(hash(beta, w_max, eps, sum(dlr.imt.get_itnodes()))),
-         _dlr{std::make_shared<dlr_ops>(std::move(dlr))} {}
+         _mesh_hash(hash(beta, w_max, eps, sum(dlr->imt.get_itnodes()))),
+         _dlr{std::move(dlr)} {}
 
     friend struct dlr_imfreq;
     friend struct dlr;
@@ -251,9 +244,15 @@ namespace triqs::mesh {
       bool symmetrize = false;
       h5::try_read(gr, "symmetrize", symmetrize);
       auto _dlr_freq  = h5::read<nda::vector<double>>(gr, "dlr_freq");
-      auto _dlr_it    = h5::read<cppdlr::imtime_ops>(gr, "dlr_it");
-      auto _dlr_if    = h5::read<cppdlr::imfreq_ops>(gr, "dlr_if");
-      m               = dlr_imtime(beta, statistic, w_max, eps, symmetrize, {_dlr_freq, _dlr_it, _dlr_if});
+
+      // Reuse the cached operations if they match the file, otherwise read them
+      auto ops = find_dlr_ops(w_max * beta, eps, statistic, symmetrize, _dlr_freq);
+      if (not ops) {
+        auto _dlr_it = h5::read<cppdlr::imtime_ops>(gr, "dlr_it");
+        auto _dlr_if = h5::read<cppdlr::imfreq_ops>(gr, "dlr_if");
+        ops          = std::make_shared<const dlr_ops>(dlr_ops{_dlr_freq, _dlr_it, _dlr_if});
+      }
+      m = dlr_imtime(beta, statistic, w_max, eps, symmetrize, std::move(ops));
     }
   };
 
@@ -22,6 +22,10 @@
 #include <itertools/itertools.hpp>
 #include <triqs/arrays.hpp>
 #include <nda/lapack/gelss_worker.hpp>
+#include <triqs/utility/bounded_cache.hpp>
+
+#include <mutex>
+#include <tuple>
 
 namespace triqs::mesh {
 
@@ -64,6 +68,22 @@ namespace triqs::mesh {
   }
   //----------------------------------------------------------------------------------------------
 
+  namespace detail {
+
+    // Key of a least-squares solver: mesh hash, tail fraction, n_tail_max, expansion order, adjust order, number of known moments
+    using lss_key_t = std::tuple<uint64_t, double, int, int, bool, int>;
+
+    // Process-wide cache of the least-squares solvers of the tail fit,
+    // shared between all tail fitters of meshes with identical parameters
+    template <typename Worker> utility::bounded_cache<lss_key_t, Worker> &get_lss_cache() {
+      static utility::bounded_cache<lss_key_t, Worker> cache{256};
+      return cache;
+    }
+
+  } // namespace detail
+
+  //----------------------------------------------------------------------------------------------
+
   class tail_fitter {
 
     static constexpr int max_order = 9;
@@ -72,10 +92,11 @@ namespace triqs::mesh {
     const bool _adjust_order;
     const int _expansion_order;
     const double _rcond = 1e-8;
-    std::array<std::unique_ptr<const nda::lapack::gelss_worker<dcomplex>>, max_order + 1> _lss;
-    std::array<std::unique_ptr<const nda::lapack::gelss_worker_hermitian>, max_order + 1> _lss_hermitian;
+    std::array<std::shared_ptr<const nda::lapack::gelss_worker<dcomplex>>, max_order + 1> _lss;
+    std::array<std::shared_ptr<const nda::lapack::gelss_worker_hermitian>, max_order + 1> _lss_hermitian;
     nda::matrix<dcomplex> _vander;
     std::vector<long> _fit_idx_lst;
+    std::shared_ptr<std::mutex> _setup_mtx = std::make_shared<std::mutex>();
 
     public:
     tail_fitter(double tail_fraction, int n_tail_max, std::optional<int> expansion_order = {})
@@ -137,6 +158,7 @@ namespace triqs::mesh {
     }
 
     // Set up the least-squares solver for a given number of known moments.
+    // The solvers are shared through a process-wide cache between meshes with identical parameters.
     template <bool enforce_hermiticity = false, typename M> void setup_lss(M const &m, int n_fixed_moments) {
 
       using namespace nda::lapack;
@@ -156,104 +178,117 @@ namespace triqs::mesh {
 
       if (n_fixed_moments + 1 > _vander.extent(0) / 2) TRIQS_RUNTIME_ERROR << "Insufficient data points for least square procedure";
 
-      auto l = [&](int n) { return std::make_unique<const cache_t>(_vander(range::all, range(n_fixed_moments, n + 1))); };
+      auto l = [&](int n) { return std::make_shared<const cache_t>(_vander(range::all, range(n_fixed_moments, n + 1))); };
 
-      auto &lss = get_lss<enforce_hermiticity>();
-
-      if (!_adjust_order)
-        lss[n_fixed_moments] = l(_expansion_order);
-      else { // Use biggest submatrix of Vandermonde for fitting such that condition boundary fulfilled
-        lss[n_fixed_moments].reset();
+      auto make_lss = [&]() -> std::shared_ptr<const cache_t> {
+        if (!_adjust_order) return l(_expansion_order);
+        // Use biggest submatrix of Vandermonde for fitting such that condition boundary fulfilled
         // Ensure that |m.w_max()|^(1-N) > 10^{-16}
         long n_max = std::min(static_cast<long>(max_order), static_cast<long>(1. + 16. / std::log10(1 + std::abs(m.w_max()))));
         // We use at least two times as many data-points as we have moments to fit
         n_max = std::min(n_max, _vander.extent(0) / 2);
         for (int n = n_max; n >= n_fixed_moments; --n) {
           auto ptr = l(n);
-          if (ptr->S_vec()[ptr->S_vec().size() - 1] > _rcond) {
-            lss[n_fixed_moments] = std::move(ptr);
-            break;
-          }
+          if (ptr->S_vec()[ptr->S_vec().size() - 1] > _rcond) return ptr;
         }
-      }
+        TRIQS_RUNTIME_ERROR << "Conditioning of tail-fit violates boundary";
+      };
 
-      if (!lss[n_fixed_moments]) TRIQS_RUNTIME_ERROR << "Conditioning of tail-fit violates boundary";
+      auto key = detail::lss_key_t{m.mesh_hash(), _tail_fraction, _n_tail_max, _expansion_order, _adjust_order, n_fixed_moments};
+      get_lss<enforce_hermiticity>()[n_fixed_moments] = detail::get_lss_cache<cache_t>().get(key, make_lss);
     }
 
     //----------------------------------------------------------------------------------------------
 
-    /**
-     * @param m mesh
-     * @param data
-     * @param n position of the omega in the data array
-     * @param normalize Finish the normalization of the tail coefficient (normally true)
-     * @param known_moments  Array of the known_moments
-     * */
-    template <int N, bool enforce_hermiticity = false, typename M, int R, int R2 = R>
-    std::pair<nda::array<dcomplex, R>, double> fit(M const &m, array_const_view<dcomplex, R> g_data, bool normalize,
-                                                   array_const_view<dcomplex, R2> known_moments, std::optional<long> inner_matrix_dim = {}) {
+    private:
+    // Copy the fit window of g_data into the rows of out, flattening the target space and the remaining mesh into the columns.
+    // The copy is done row by row with a strided assignment, since g_data might have fancy strides/lengths.
+    template <int N, typename M, int R>
+    void gather_fit_rows(M const &m, array_const_view<dcomplex, R> g_data, nda::matrix_view<dcomplex, nda::C_stride_layout> out) const {
+      auto g_data_swap_idx = nda::rotate_index_view<N>(g_data);
+      if (out.extent(1) * g_data_swap_idx.extent(0) != g_data_swap_idx.size())
+        TRIQS_RUNTIME_ERROR << "tail_fitter: incompatible size of the fit matrix";
+      for (auto [i, n] : itertools::enumerate(_fit_idx_lst)) {
+        if constexpr (R == 1)
+          out(i, 0) = g_data_swap_idx(m.to_data_index(n));
+        else
+          nda::reshape(out(i, range::all), stdutil::front_pop(g_data_swap_idx.shape())) = g_data_swap_idx(m.to_data_index(n), nda::ellipsis());
+      }
+    }
+
+    // Flatten the known moments into a matrix and scale them by 1/Omega_max^n
+    template <typename M, int R>
+    nda::matrix<dcomplex> known_moments_matrix(M const &m, array_const_view<dcomplex, R> known_moments, long ncols) const {
+      long n_fixed_moments = known_moments.extent(0);
+      if (known_moments.size() != n_fixed_moments * ncols) TRIQS_RUNTIME_ERROR << "known_moments shape incompatible with shape of data";
+      nda::matrix<dcomplex> km_mat(n_fixed_moments, ncols);
+
+      double z      = 1.0;
+      double om_max = std::abs(m.w_max());
+      for (int order : range(n_fixed_moments)) {
+        if constexpr (R == 1)
+          km_mat(order, 0) = z * known_moments(order);
+        else
+          nda::reshape(km_mat(order, range::all), stdutil::front_pop(known_moments.shape())) = z * known_moments(order, nda::ellipsis());
+        z /= om_max;
+      }
+      return km_mat;
+    }
+
+    // Fit a list of data arrays on the same mesh with a single call to the least-squares solver.
+    // The columns of all data arrays are gathered into one matrix.
+    template <int N, bool enforce_hermiticity, typename M, int R>
+    std::pair<std::vector<nda::array<dcomplex, R>>, double> fit_impl(M const &m, std::vector<array_const_view<dcomplex, R>> const &g_data_vec,
+                                                                      bool normalize,
+                                                                      std::vector<array_const_view<dcomplex, R>> const &known_moments_vec,
+                                                                      std::optional<long> inner_matrix_dim) {
 
       if (enforce_hermiticity and not inner_matrix_dim.has_value())
         TRIQS_RUNTIME_ERROR << "Enforcing the hermiticity in tail_fit requires inner matrix dimension";
       if constexpr (enforce_hermiticity) static_assert(std::is_same_v<M, imfreq>, "Enforcing the hermiticity in tail_fit requires Matsubara mesh");
-      static_assert((R == R2), "The rank of the moment array is not equal to the data to fit !!!");
       if (m.positive_only()) TRIQS_RUNTIME_ERROR << "Can not fit on a positive_only mesh";
+      if (known_moments_vec.size() != g_data_vec.size()) TRIQS_RUNTIME_ERROR << "tail_fitter: one array of known moments per data array required";
 
-      // If not set, build least square solver for for given number of known moments
-      int n_fixed_moments = known_moments.extent(0);
-      if (n_fixed_moments > _expansion_order) return {known_moments, 0.0};
-
-      auto &lss = get_lss<enforce_hermiticity>();
-      if (!bool(lss[n_fixed_moments])) setup_lss<enforce_hermiticity>(m, n_fixed_moments);
+      // All data arrays must share the number of known moments
+      int n_fixed_moments = known_moments_vec.empty() ? 0 : known_moments_vec[0].extent(0);
+      for (auto const &km : known_moments_vec)
+        if (km.extent(0) != n_fixed_moments) TRIQS_RUNTIME_ERROR << "tail_fitter: all data arrays must have the same number of known moments";
 
-      // Total number of moments
-      int n_moments = lss[n_fixed_moments]->n_var() + n_fixed_moments;
-
-      using itertools::enumerate;
-      using nda::ellipsis;
-
-      // The values of the Green function. Swap relevant mesh to front
-      auto g_data_swap_idx = nda::rotate_index_view<N>(g_data);
-      auto const &imp      = g_data_swap_idx.indexmap();
-      long ncols           = imp.size() / imp.lengths()[0];
-
-      // We flatten the data in the target space and remaining mesh into the second dim
-      nda::matrix<dcomplex> g_mat(_vander.extent(0), ncols);
-
-      // Copy g_data into new matrix (necessary because g_data might have fancy strides/lengths)
-      for (auto [i, n] : enumerate(_fit_idx_lst)) {
-        if constexpr (R == 1)
-          g_mat(i, 0) = g_data_swap_idx(m.to_data_index(n));
-        else
-          for (auto [j, x] : enumerate(g_data_swap_idx(m.to_data_index(n), ellipsis()))) { g_mat(i, j) = x; }
+      if (n_fixed_moments > _expansion_order) {
+        std::vector<nda::array<dcomplex, R>> res;
+        for (auto const &km : known_moments_vec) res.emplace_back(km);
+        return {std::move(res), 0.0};
       }
 
-      // If an array with known_moments was passed, flatten the array into a matrix
-      // just like g_data. Then account for the proper shift in g_mat
-      if (n_fixed_moments > 0) {
-        auto imp_km   = known_moments.indexmap();
-        long ncols_km = imp_km.size() / imp_km.lengths()[0];
+      // If not set, build least square solver for for given number of known moments
+      // The fitter is shared by the copies of a mesh, which may be fitted concurrently (e.g. the blocks of a block_gf)
+      auto lss = [&] {
+        auto lock = std::scoped_lock{*_setup_mtx};
+        if (!bool(get_lss<enforce_hermiticity>()[n_fixed_moments])) setup_lss<enforce_hermiticity>(m, n_fixed_moments);
+        return get_lss<enforce_hermiticity>()[n_fixed_moments];
+      }();
 
-        if (ncols != ncols_km) TRIQS_RUNTIME_ERROR << "known_moments shape incompatible with shape of data";
-        nda::matrix<dcomplex> km_mat(n_fixed_moments, ncols);
+      // Total number of moments
+      int n_moments = lss->n_var() + n_fixed_moments;
 
-        // We have to scale the known_moments by 1/Omega_max^n
-        double z      = 1.0;
-        double om_max = std::abs(m.w_max());
+      // Column offsets of each data array in the fit matrix
+      std::vector<long> col_offsets{0};
+      for (auto const &g_data : g_data_vec) col_offsets.push_back(col_offsets.back() + g_data.size() / g_data.extent(N));
 
-        for (int order : range(n_fixed_moments)) {
-          if constexpr (R == 1)
-            km_mat(order, 0) = z * known_moments(order, ellipsis());
-          else
-            for (auto [n, x] : enumerate(known_moments(order, ellipsis()))) km_mat(order, n) = z * x;
-          z /= om_max;
-        }
+      // We flatten the data in the target space and remaining mesh into the second dim
+      nda::matrix<dcomplex> g_mat(_vander.extent(0), col_offsets.back());
+      for (auto [b, g_data] : itertools::enumerate(g_data_vec)) {
+        auto cols = range(col_offsets[b], col_offsets[b + 1]);
+        gather_fit_rows<N, M, R>(m, g_data, g_mat(range::all, cols));
 
         // Shift g_mat to account for known moment correction
-        g_mat -= _vander(range::all, range(n_fixed_moments)) * km_mat;
+        if (n_fixed_moments > 0) {
+          g_mat(range::all, cols) -= _vander(range::all, range(n_fixed_moments)) * known_moments_matrix(m, known_moments_vec[b], cols.size());
+        }
       }
+
       // Call least square solver
-      auto [a_mat, epsilon] = (*lss[n_fixed_moments])(g_mat, inner_matrix_dim); // coef + error
+      auto [a_mat, epsilon] = (*lss)(g_mat, inner_matrix_dim); // coef + error
 
       // === The result a_mat contains the fitted moments divided by w_max()^n
       // Here we extract the real moments
@@ -266,25 +301,62 @@ namespace triqs::mesh {
           z *= om_max;
         }
       }
-      // === Reinterpret the result as an R-dimensional array according to initial shape and return together with the error
 
-      using r_t = nda::array<dcomplex, R>; // return type
-      auto lg   = g_data_swap_idx.indexmap().lengths();
+      // === Reinterpret the result as R-dimensional arrays according to the initial shapes
+      std::vector<nda::array<dcomplex, R>> res_vec;
+      res_vec.reserve(g_data_vec.size());
+      for (auto [b, g_data] : itertools::enumerate(g_data_vec)) {
+        auto lg = nda::rotate_index_view<N>(g_data).shape();
+
+        // The fitted moments of this data array
+        auto a_b = nda::array<dcomplex, 2>{a_mat(range::all, range(col_offsets[b], col_offsets[b + 1]))};
+        lg[0]    = n_moments - n_fixed_moments;
+        auto a_v = nda::reshape(a_b, lg);
+
+        // The full result
+        lg[0]    = n_moments;
+        auto res = nda::array<dcomplex, R>(lg);
+        if (n_fixed_moments) res(range(n_fixed_moments), nda::ellipsis()) = known_moments_vec[b];
+        res(range(n_fixed_moments, n_moments), nda::ellipsis()) = a_v;
+        res_vec.emplace_back(std::move(res));
+      }
 
-      // Index map for the view on the a_mat result
-      lg[0]     = n_moments - n_fixed_moments;
-      auto imp1 = typename r_t::layout_t{lg};
-      //auto imp1 = typename r_t::indexmap_type{typename r_t::indexmap_type::domain_type{lg}};
+      return {std::move(res_vec), epsilon};
+    }
 
-      // Index map for the full result
-      lg[0]    = n_moments;
-      auto res = r_t(lg);
+    public:
+    //----------------------------------------------------------------------------------------------
 
-      if (n_fixed_moments) res(range(n_fixed_moments), ellipsis()) = known_moments;
-      res(range(n_fixed_moments, n_moments), ellipsis()) = nda::array_view<dcomplex, R>{imp1, a_mat.storage()};
-      //res(range(n_fixed_moments, n_moments), ellipsis()) = typename r_t::view_type{imp1, a_mat.storage()};
+    /**
+     * @param m mesh
+     * @param data
+     * @param n position of the omega in the data array
+     * @param normalize Finish the normalization of the tail coefficient (normally true)
+     * @param known_moments  Array of the known_moments
+     * */
+    template <int N, bool enforce_hermiticity = false, typename M, int R, int R2 = R>
+    std::pair<nda::array<dcomplex, R>, double> fit(M const &m, array_const_view<dcomplex, R> g_data, bool normalize,
+                                                   array_const_view<dcomplex, R2> known_moments, std::optional<long> inner_matrix_dim = {}) {
+      static_assert((R == R2), "The rank of the moment array is not equal to the data to fit !!!");
+      auto [res_vec, epsilon] = fit_impl<N, enforce_hermiticity, M, R>(m, {g_data}, normalize, {known_moments}, inner_matrix_dim);
+      return {std::move(res_vec[0]), epsilon};
+    }
 
-      return {std::move(res), epsilon};
+    /**
+     * Fit the tails of several data arrays on the same mesh m, e.g. the blocks of a block Green function,
+     * with a single call to the least-squares solver
+     *
+     * @param m mesh
+     * @param g_data_vec The data arrays
+     * @param normalize Finish the normalization of the tail coefficient (normally true)
+     * @param known_moments_vec The arrays of known moments, one for each data array. They must all have the same number of moments.
+     * @return The tail for each data array, and the maximal error of the fit
+     * */
+    template <int N, typename M, int R>
+    std::pair<std::vector<nda::array<dcomplex, R>>, double> fit_batched(M const &m, std::vector<array_const_view<dcomplex, R>> const &g_data_vec,
+                                                                         bool normalize,
+                                                                         std::vector<array_const_view<dcomplex, R>> const &known_moments_vec) {
+      return fit_impl<N, false, M, R>(m, g_data_vec, normalize, known_moments_vec, {});
     }
 
     //--------------------
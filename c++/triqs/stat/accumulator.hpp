@@ -27,6 +27,7 @@
 #include <triqs/arrays.hpp>
 #include <nda/clef/clef.hpp>
 #include <h5/h5.hpp>
+#include <triqs/utility/h5_chunked.hpp>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -117,9 +118,54 @@ namespace triqs::stat {
       h5_write(gr, "max_n_bins", l.max_n_bins);
     }
 
+    // Write the bins in a chunked, compressed dataset. Array-valued bins are stacked into one array (n_bins, ...).
+    template <typename T>
+    void h5_write_chunked(h5::group g, std::string const &name, lin_binning<T> const &l, utility::h5_chunk_params const &p) {
+      auto gr = g.create_group(name);
+      if constexpr (nda::MemoryArray<T>) {
+        using V = nda::get_value_t<T>;
+        if (l.bins.empty()) {
+          h5_write(gr, "bins", l.bins);
+        } else {
+          auto shape = l.bins[0].shape();
+          auto dims  = std::vector<long>{l.n_bins()};
+          dims.insert(dims.end(), shape.begin(), shape.end());
+          auto ds     = utility::detail::h5_create_chunked(gr, "bins", utility::detail::h5_scalar<V>(), nda::is_complex_v<V>, dims, p);
+          auto offset = std::vector<long>(dims.size(), 0);
+          auto count  = dims;
+          count[0]    = 1;
+          for (long i = 0; i < l.n_bins(); ++i) {
+            if (l.bins[i].shape() != shape) TRIQS_RUNTIME_ERROR << "h5_write_chunked: the bins of the accumulator have different shapes";
+            nda::array<V, nda::get_rank<T>> const &b = l.bins[i]; // Copied only if the bin is not a C-ordered array
+            offset[0]                                = i;
+            utility::detail::h5_write_box(ds, utility::detail::h5_scalar<V>(), nda::is_complex_v<V>, b.data(), offset, count);
+          }
+        }
+      } else if constexpr (std::is_arithmetic_v<T> or nda::is_complex_v<T>) {
+        utility::h5_write_chunked(gr, "bins", nda::array_const_view<T, 1>{std::array<long, 1>{l.n_bins()}, l.bins.data()}, p);
+      } else {
+        h5_write(gr, "bins", l.bins);
+      }
+      h5_write(gr, "last_bin_count", l.last_bin_count);
+      h5_write(gr, "bin_capacity", l.bin_capacity);
+      h5_write(gr, "max_n_bins", l.max_n_bins);
+    }
+
     template <typename T> void h5_read(h5::group g, std::string const &name, lin_binning<T> &l) {
       auto gr = g.open_group(name);
-      h5_read(gr, "bins", l.bins);
+      if constexpr (nda::MemoryArray<T>) {
+        // Bins stacked by h5_write_chunked
+        if (utility::detail::h5_has_dataset(gr, "bins")) {
+          auto stacked = nda::array<nda::get_value_t<T>, nda::get_rank<T> + 1>{};
+          h5_read(gr, "bins", stacked);
+          l.bins.clear();
+          for (long i = 0; i < stacked.extent(0); ++i) l.bins.emplace_back(stacked(i, nda::ellipsis{}));
+        } else {
+          h5_read(gr, "bins", l.bins);
+        }
+      } else {
+        h5_read(gr, "bins", l.bins);
+      }
       h5_read(gr, "last_bin_count", l.last_bin_count);
       h5_read(gr, "bin_capacity", l.bin_capacity);
       h5_read(gr, "max_n_bins", l.max_n_bins);
@@ -301,6 +347,14 @@ namespace triqs::stat {
       h5_write(gr, "count", l.count);
     }
 
+    // Same as h5_write, with the linear bins in a chunked, compressed dataset, cf. utility::h5_chunk_params
+    friend void h5_write_chunked(h5::group g, std::string const &name, accumulator<T> const &l, utility::h5_chunk_params const &p = {}) {
+      auto gr = g.create_group(name);
+      h5_write(gr, "log_bins", l.log_bins);
+      details::h5_write_chunked(gr, "lin_bins", l.lin_bins, p);
+      h5_write(gr, "count", l.count);
+    }
+
     friend void h5_read(h5::group g, std::string const &name, accumulator<T> &l) {
       auto gr = g.open_group(name);
       h5_read(gr, "log_bins", l.log_bins);
@@ -18,6 +18,9 @@
 // Authors: Philipp D, Igor Krivenko, Nils Wentzell
 
 #include "./histograms.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace triqs::stat {
 
@@ -47,6 +50,82 @@ namespace triqs::stat {
     return *this;
   }
 
+  namespace {
+
+    // Number of values binned at a time in the batched insertion
+    constexpr long block_size = 256;
+
+    // Bin index of each value in [a, b], and n_bins for the values outside
+    // For x >= a the truncation is a floor, and the values outside are replaced by a before the conversion.
+    void bin_indices(double const *x, long n, double a, double b, double step, long n_bins, long *idx) {
+#pragma omp simd
+      for (long i = 0; i < n; ++i) {
+        bool in  = (x[i] >= a) && (x[i] <= b);
+        double y = in ? x[i] : a;
+        idx[i]   = in ? long((y - a) * step + 0.5) : n_bins;
+      }
+    }
+
+    // Same for integer values and bins of length 1 starting at the integer a
+    void bin_indices(long const *x, long n, long a, long b, long n_bins, long *idx) {
+#pragma omp simd
+      for (long i = 0; i < n; ++i) idx[i] = ((x[i] >= a) && (x[i] <= b)) ? x[i] - a : n_bins;
+    }
+
+  } // namespace
+
+  template <typename T> void histogram::_bin(std::span<T const> xs) {
+    // counts[n_bins] accumulates the discarded points
+    auto counts = std::vector<unsigned long long>(n_bins + 1, 0);
+    auto idx    = std::array<long, block_size>{};
+
+    bool unit_bins = std::is_integral_v<T> && (_step == 1.0) && (a == std::floor(a));
+    for (long start = 0; start < long(xs.size()); start += block_size) {
+      long n       = std::min(block_size, long(xs.size()) - start);
+      auto const x = xs.data() + start;
+      if constexpr (std::is_integral_v<T>) {
+        if (unit_bins) {
+          bin_indices(x, n, long(a), long(b), n_bins, idx.data());
+        } else {
+          auto xd = std::array<double, block_size>{};
+          for (long i = 0; i < n; ++i) xd[i] = double(x[i]);
+          bin_indices(xd.data(), n, a, b, _step, n_bins, idx.data());
+        }
+      } else {
+        bin_indices(x, n, a, b, _step, n_bins, idx.data());
+      }
+      for (long i = 0; i < n; ++i) ++counts[idx[i]];
+    }
+
+    for (long i = 0; i < n_bins; ++i) _data[i] += double(counts[i]);
+    _n_lost_pts += counts[n_bins];
+    _n_data_pts += xs.size() - counts[n_bins];
+  }
+
+  template <typename T> histogram &histogram::_insert(std::span<T const> xs, bool parallel) {
+    if (!parallel) {
+      _bin(xs);
+      return *this;
+    }
+
+    // Each thread bins chunks of values into its own histogram
+    constexpr long chunk_size = 1l << 16;
+    long n_chunks             = (long(xs.size()) + chunk_size - 1) / chunk_size;
+#pragma omp parallel
+    {
+      auto local = histogram{a, b, n_bins};
+#pragma omp for schedule(static)
+      for (long c = 0; c < n_chunks; ++c) local._bin(xs.subspan(c * chunk_size, std::min(chunk_size, long(xs.size()) - c * chunk_size)));
+#pragma omp critical
+      *this = std::move(*this) + local;
+    }
+    return *this;
+  }
+
+  histogram &histogram::insert(std::span<double const> xs, bool parallel) { return _insert(xs, parallel); }
+
+  histogram &histogram::insert(std::span<long const> ns, bool parallel) { return _insert(ns, parallel); }
+
   histogram operator+(histogram h1, histogram const &h2) {
     auto l1 = h1.limits(), l2 = h2.limits();
     if (l1 != l2 || h1.size() != h2.size()) {
@@ -24,6 +24,7 @@
 #include <triqs/arrays.hpp>
 #include <nda/mpi.hpp>
 #include <ostream>
+#include <span>
 
 namespace triqs::stat {
 
@@ -45,6 +46,9 @@ namespace triqs::stat {
 
     void _init(); // initialize _step
 
+    template <typename T> void _bin(std::span<T const> xs);                     // batched insertion
+    template <typename T> histogram &_insert(std::span<T const> xs, bool parallel); // batched insertion, optionally threaded
+
     inline friend histogram pdf(histogram const &h); // probability distribution function = normalized histogram
     inline friend histogram cdf(histogram const &h); // cumulative distribution function = normalized histogram integrated
 
@@ -76,6 +80,28 @@ namespace triqs::stat {
     /// @brief Bin a real value into the histogram
     histogram &operator<<(double x);
 
+    /// Bins a batch of real values into the histogram, with the same convention as `operator<<`.
+    /// The bin indices are computed for blocks of values in a branchless loop that the compiler can vectorize.
+    /// In the parallel mode, each OpenMP thread bins a part of the values into its own histogram,
+    /// and the histograms are summed with `operator+`.
+    ///
+    /// @param xs Sampled values
+    /// @param parallel Distribute the values over the OpenMP threads
+    /// @return Reference to `*this`
+    /// @brief Bin a batch of real values into the histogram
+    histogram &insert(std::span<double const> xs, bool parallel = false);
+
+    /// Bins a batch of integer values, e.g. perturbation orders, into the histogram.
+    /// For a histogram with bin length 1 over an integer range, as built by `histogram(int, int)`,
+    /// the value :math:`n` falls into the bin :math:`n - a` without any floating-point arithmetic.
+    /// Otherwise the values are binned as real values.
+    ///
+    /// @param ns Sampled values
+    /// @param parallel Distribute the values over the OpenMP threads
+    /// @return Reference to `*this`
+    /// @brief Bin a batch of integer values into the histogram
+    histogram &insert(std::span<long const> ns, bool parallel = false);
+
     /// Get position of bin's center
     /// @param n Bin index
     /// @return Position of the center, :math:`n (b - a) / (n_\mathrm{bins} - 1)`
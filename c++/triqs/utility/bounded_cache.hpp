@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include <chrono>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace triqs::utility {
+
+  /**
+   * A thread-safe cache of immutable values, shared through std::shared_ptr
+   *
+   * The cache is emptied when it holds max_size values and a new one is added.
+   * The values handed out stay alive as long as their users hold them.
+   * Values are built outside the lock, so that different keys are built concurrently.
+   * Concurrent requests of a key being built wait for it, so that each key is built only once.
+   * The function building a value must therefore not request the same key.
+   *
+   * @tparam K The key, ordered by std::less
+   * @tparam V The value
+   */
+  template <typename K, typename V> class bounded_cache {
+    using value_t = std::shared_ptr<V const>;
+
+    // The value of a key, available once built. The slots are compared by address on a failed build.
+    struct slot {
+      std::shared_future<value_t> value;
+    };
+
+    long max_size_;
+    mutable std::mutex mtx_;
+    std::map<K, std::shared_ptr<slot>> table_;
+    long hits_ = 0, misses_ = 0;
+
+    public:
+    /// Statistics of the cache
+    struct stats {
+      long hits, misses, size;
+    };
+
+    /// Construct an empty cache which holds at most max_size values
+    explicit bounded_cache(long max_size) : max_size_(max_size) {}
+
+    /**
+     * The value of a key, built by make on a miss
+     *
+     * @param key The key
+     * @param make Callable without arguments, returning V or std::shared_ptr<V const>. If it throws, nothing is cached,
+     *             and the error is rethrown to this request and to the requests waiting for the key.
+     * @return The shared value
+     */
+    template <typename F> value_t get(K const &key, F &&make) {
+      auto lock = std::unique_lock{mtx_};
+      if (auto it = table_.find(key); it != table_.end()) {
+        ++hits_;
+        auto value = it->second->value;
+        lock.unlock();
+        return value.get();
+      }
+      ++misses_;
+      auto promise = std::promise<value_t>{};
+      auto s       = std::make_shared<slot>(slot{promise.get_future().share()});
+      if (long(table_.size()) >= max_size_) table_.clear();
+      table_.emplace(key, s);
+      lock.unlock();
+
+      try {
+        auto res = [&]() -> value_t {
+          if constexpr (std::is_convertible_v<std::invoke_result_t<F>, value_t>)
+            return make();
+          else
+            return std::make_shared<V const>(make());
+        }();
+        promise.set_value(res);
+        return res;
+      } catch (...) {
+        // The slot is removed before it becomes ready, so that the ready slots of the table hold a value
+        lock.lock();
+        if (auto it = table_.find(key); it != table_.end() and it->second == s) table_.erase(it);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+      }
+    }
+
+    /// The value of a key if it is cached, nullptr otherwise. Does not build, nor wait for a key being built.
+    value_t find(K const &key) {
+      auto lock = std::lock_guard{mtx_};
+      auto it   = table_.find(key);
+      if (it == table_.end() or it->second->value.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+        ++misses_;
+        return {};
+      }
+      ++hits_;
+      return it->second->value.get();
+    }
+
+    /// The hits, misses and size of the cache
+    stats info() const {
+      auto lock = std::lock_guard{mtx_};
+      return {hits_, misses_, long(table_.size())};
+    }
+
+    /// Empty the cache and reset its statistics. The values handed out are kept by their users.
+    void clear() {
+      auto lock = std::lock_guard{mtx_};
+      table_.clear();
+      hits_ = misses_ = 0;
+    }
+  };
+
+} // namespace triqs::utility
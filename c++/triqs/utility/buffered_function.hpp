@@ -64,6 +64,22 @@ namespace triqs {
         return buffer[index];
       }
 
+      /// The buffer
+      std::vector<R> const &get_buffer() const { return buffer; }
+
+      /// The index of the next element in the buffer
+      size_t get_index() const { return index; }
+
+      /** Restore the buffer and the index, e.g. from a checkpoint. The bufferized function is unchanged.
+   *
+   * @param b : the buffer
+   * @param i : the index of the next element in b
+   */
+      void set_buffer(std::vector<R> b, size_t i) {
+        buffer = std::move(b);
+        index  = i;
+      }
+
       private:
       size_t index;
       std::vector<R> buffer;
@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include "./h5_chunked.hpp"
+#include "./exceptions.hpp"
+#include <hdf5.h>
+
+#include <algorithm>
+
+namespace triqs::utility::detail {
+
+  using h5::dataset;
+  using h5::object;
+
+  namespace {
+
+    // The registered id of the zstd filter, provided by the HDF5 plugin
+    constexpr H5Z_filter_t zstd_filter_id = 32015;
+
+    // Target size of the default chunks in bytes
+    constexpr long default_chunk_bytes = 1 << 20;
+
+    h5::datatype native_type(h5_scalar_t ty) {
+      switch (ty) {
+        case h5_scalar_t::int_: return h5::hdf5_type<int>();
+        case h5_scalar_t::long_: return h5::hdf5_type<long>();
+        default: return h5::hdf5_type<double>();
+      }
+    }
+
+    long scalar_size(h5_scalar_t ty) {
+      switch (ty) {
+        case h5_scalar_t::int_: return sizeof(int);
+        case h5_scalar_t::long_: return sizeof(long);
+        default: return sizeof(double);
+      }
+    }
+
+    // The extents in the file, with the trailing axis of size 2 of the complex numbers
+    std::vector<hsize_t> file_extents(std::vector<long> const &v, bool is_complex, hsize_t last) {
+      auto res = std::vector<hsize_t>(v.begin(), v.end());
+      if (is_complex) res.push_back(last);
+      return res;
+    }
+
+    // The chunk shape of the dataset with the file extents dims
+    std::vector<hsize_t> chunk_extents(std::vector<hsize_t> const &dims, long elem_size, std::vector<long> const &chunk_shape) {
+      long rank = dims.size();
+      auto res  = dims;
+      if (not chunk_shape.empty()) {
+        if (chunk_shape.size() > dims.size()) TRIQS_RUNTIME_ERROR << "h5_write_chunked: the chunk shape has more axes than the array";
+        for (long d = 0; d < long(chunk_shape.size()); ++d) {
+          if (chunk_shape[d] <= 0)
+            TRIQS_RUNTIME_ERROR << "h5_write_chunked: the chunk extent " << chunk_shape[d] << " along the axis " << d << " is not positive";
+          res[d] = std::min<hsize_t>(chunk_shape[d], dims[d]);
+        }
+        return res;
+      }
+
+      // Full trailing axes, as long as the chunk stays below the target size, then a part of the next axis
+      long bytes = elem_size;
+      long d     = rank - 1;
+      for (; d >= 0 and bytes * long(dims[d]) <= default_chunk_bytes; --d) bytes *= dims[d];
+      if (d >= 0) res[d] = std::max(1l, default_chunk_bytes / bytes);
+      for (long e = d - 1; e >= 0; --e) res[e] = 1;
+      return res;
+    }
+
+  } // namespace
+
+  //-------------------------------------------------------
+
+  dataset h5_create_chunked(h5::group g, std::string const &name, h5_scalar_t ty, bool is_complex, std::vector<long> const &dims,
+                            h5_chunk_params const &p) {
+    auto f_dims   = file_extents(dims, is_complex, 2);
+    object dspace = H5Screate_simple(f_dims.size(), f_dims.data(), nullptr);
+
+    // The chunks and the filters. HDF5 does not chunk empty datasets.
+    object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    if (std::none_of(f_dims.begin(), f_dims.end(), [](hsize_t n) { return n == 0; })) {
+      auto chunk = chunk_extents(f_dims, scalar_size(ty), p.chunk_shape);
+      if (H5Pset_chunk(dcpl, chunk.size(), chunk.data()) < 0) TRIQS_RUNTIME_ERROR << "h5_write_chunked: cannot set the chunks of " << name;
+      if (p.shuffle and p.filter != h5_filter::none) H5Pset_shuffle(dcpl);
+      if (p.filter == h5_filter::deflate) {
+        if (p.level < 0 or p.level > 9) TRIQS_RUNTIME_ERROR << "h5_write_chunked: the deflate level " << p.level << " is not in [0, 9]";
+        H5Pset_deflate(dcpl, p.level);
+      } else if (p.filter == h5_filter::zstd) {
+        if (H5Zfilter_avail(zstd_filter_id) <= 0)
+          TRIQS_RUNTIME_ERROR << "h5_write_chunked: the zstd filter is not available. Install the HDF5 plugin and set HDF5_PLUGIN_PATH";
+        auto level = static_cast<unsigned int>(p.level);
+        H5Pset_filter(dcpl, zstd_filter_id, H5Z_FLAG_MANDATORY, 1, &level);
+      }
+    }
+
+    dataset ds = g.create_dataset(name, native_type(ty), dspace, dcpl);
+    if (is_complex) h5::write_attribute(ds, "__complex__", std::string{"1"});
+    return ds;
+  }
+
+  //-------------------------------------------------------
+
+  void h5_write_box(dataset ds, h5_scalar_t ty, bool is_complex, void const *data, std::vector<long> const &offset, std::vector<long> const &count) {
+    auto f_offset = file_extents(offset, is_complex, 0);
+    auto f_count  = file_extents(count, is_complex, 2);
+    if (std::any_of(f_count.begin(), f_count.end(), [](hsize_t n) { return n == 0; })) return;
+
+    h5::dataspace file_space = H5Dget_space(ds);
+    H5Sselect_hyperslab(file_space, H5S_SELECT_SET, f_offset.data(), nullptr, f_count.data(), nullptr);
+    object mem_space = H5Screate_simple(f_count.size(), f_count.data(), nullptr);
+
+    herr_t status = H5Dwrite(ds, native_type(ty), mem_space, file_space, H5P_DEFAULT, data);
+    if (status < 0) TRIQS_RUNTIME_ERROR << "h5_write_chunked: error writing a box of the dataset";
+  }
+
+  //-------------------------------------------------------
+
+  void h5_read_box(h5::group g, std::string const &name, h5_scalar_t ty, bool is_complex, void *data, std::vector<long> const &offset,
+                   std::vector<long> const &count) {
+    dataset ds               = g.open_dataset(name);
+    h5::dataspace file_space = H5Dget_space(ds);
+
+    // Check the rank and the box against the stored extents
+    auto f_offset = file_extents(offset, is_complex, 0);
+    auto f_count  = file_extents(count, is_complex, 2);
+    int rank      = H5Sget_simple_extent_ndims(file_space);
+    if (rank != int(f_count.size()) or offset.size() != count.size())
+      TRIQS_RUNTIME_ERROR << "h5_read_box: rank mismatch. The dataset " << name << " in the group " << g.name() << " has rank " << rank
+                          << " instead of " << f_count.size();
+    auto dims = std::vector<hsize_t>(rank);
+    H5Sget_simple_extent_dims(file_space, dims.data(), nullptr);
+    for (long d = 0; d < long(offset.size()); ++d)
+      if (offset[d] < 0 or offset[d] + count[d] > long(dims[d]))
+        TRIQS_RUNTIME_ERROR << "h5_read_box: the box [" << offset[d] << ", " << offset[d] + count[d] << ") along the axis " << d
+                            << " is out of the extent " << dims[d] << " of the dataset " << name;
+    if (std::any_of(f_count.begin(), f_count.end(), [](hsize_t n) { return n == 0; })) return;
+
+    H5Sselect_hyperslab(file_space, H5S_SELECT_SET, f_offset.data(), nullptr, f_count.data(), nullptr);
+    object mem_space = H5Screate_simple(f_count.size(), f_count.data(), nullptr);
+
+    herr_t status = H5Dread(ds, native_type(ty), mem_space, file_space, H5P_DEFAULT, data);
+    if (status < 0) TRIQS_RUNTIME_ERROR << "h5_read_box: error reading the dataset " << name << " from the group " << g.name();
+  }
+
+  //-------------------------------------------------------
+
+  bool h5_has_dataset(h5::group g, std::string const &name) {
+    if (not g.has_key(name)) return false;
+    object obj = H5Oopen(g, name.c_str(), H5P_DEFAULT);
+    return H5Iget_type(obj) == H5I_DATASET;
+  }
+
+} // namespace triqs::utility::detail
@@ -0,0 +1,132 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#pragma once
+#include <h5/h5.hpp>
+#include <nda/nda.hpp>
+
+#include <complex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace triqs::utility {
+
+  /// The compression filters of chunked HDF5 datasets
+  enum class h5_filter { none, deflate, zstd };
+
+  /**
+   * Parameters of the chunked, compressed storage of an array in HDF5
+   *
+   * The dataset keeps the name, shape and type of h5_write, so it is read transparently by h5_read,
+   * also by older versions, as long as the HDF5 library has the filter: deflate is always built in,
+   * zstd requires the registered HDF5 plugin 32015.
+   */
+  struct h5_chunk_params {
+    /// The extents of the chunks along the leading axes, the other axes are not split.
+    /// If empty, the chunks are made of full trailing axes, with about 1 MB each.
+    std::vector<long> chunk_shape = {};
+
+    /// The compression filter
+    h5_filter filter = h5_filter::deflate;
+
+    /// The compression level, 1-9 for deflate and 1-22 for zstd
+    int level = 4;
+
+    /// Shuffle the bytes of the elements before the compression (lossless, efficient for floating-point data)
+    bool shuffle = true;
+  };
+
+  namespace detail {
+
+    // The scalar types of the datasets. Complex numbers are stored as pairs of double, as in h5_write.
+    enum class h5_scalar_t { int_, long_, double_ };
+
+    template <typename T> constexpr h5_scalar_t h5_scalar() {
+      if constexpr (std::is_same_v<T, int>)
+        return h5_scalar_t::int_;
+      else if constexpr (std::is_same_v<T, long>)
+        return h5_scalar_t::long_;
+      else {
+        static_assert(std::is_same_v<T, double> or std::is_same_v<T, std::complex<double>>, "Chunked HDF5 storage: unsupported value type");
+        return h5_scalar_t::double_;
+      }
+    }
+
+    // Create the chunked dataset name with the shape dims, replacing an existing one
+    h5::dataset h5_create_chunked(h5::group g, std::string const &name, h5_scalar_t ty, bool is_complex, std::vector<long> const &dims,
+                                  h5_chunk_params const &p);
+
+    // Write the C-ordered data into the box [offset, offset + count) of the dataset
+    void h5_write_box(h5::dataset ds, h5_scalar_t ty, bool is_complex, void const *data, std::vector<long> const &offset,
+                      std::vector<long> const &count);
+
+    // Read the box [offset, offset + count) of the dataset name into the C-ordered data
+    void h5_read_box(h5::group g, std::string const &name, h5_scalar_t ty, bool is_complex, void *data, std::vector<long> const &offset,
+                     std::vector<long> const &count);
+
+    // Is name a dataset of the group
+    bool h5_has_dataset(h5::group g, std::string const &name);
+
+  } // namespace detail
+
+  /**
+   * Write an array into a chunked, compressed HDF5 dataset, cf. h5_chunk_params
+   *
+   * @param g The HDF5 group
+   * @param name The name of the dataset
+   * @param a The array
+   * @param p The chunk shape and the compression
+   */
+  template <nda::MemoryArray A> void h5_write_chunked(h5::group g, std::string const &name, A const &a, h5_chunk_params const &p = {}) {
+    using T = nda::get_value_t<A>;
+    static_assert(nda::get_rank<A> > 0, "h5_write_chunked: scalars are not chunked");
+    nda::array<T, nda::get_rank<A>> const &a_c = a; // Copied only if a is not a C-ordered array
+
+    auto dims = std::vector<long>(a_c.shape().begin(), a_c.shape().end());
+    auto ds   = detail::h5_create_chunked(g, name, detail::h5_scalar<T>(), nda::is_complex_v<T>, dims, p);
+    detail::h5_write_box(ds, detail::h5_scalar<T>(), nda::is_complex_v<T>, a_c.data(), std::vector<long>(dims.size(), 0), dims);
+  }
+
+  /**
+   * Read a box of a dataset written by h5_write or h5_write_chunked
+   *
+   * Only the box [offset, offset + shape of a) is read, i.e. only the chunks which intersect it.
+   * It is read directly into a if a is contiguous and C-ordered.
+   *
+   * @param g The HDF5 group
+   * @param name The name of the dataset
+   * @param a The array (or view) to read into, with the shape of the box
+   * @param offset The first index of the box, for each axis
+   */
+  template <typename A>
+    requires(nda::MemoryArray<std::decay_t<A>>)
+  void h5_read_box(h5::group g, std::string const &name, A &&a, std::vector<long> const &offset) {
+    using T    = nda::get_value_t<std::decay_t<A>>;
+    auto count = std::vector<long>(a.shape().begin(), a.shape().end());
+
+    // Read directly into a contiguous C-ordered a, through a temporary otherwise
+    if (a.indexmap().is_contiguous() and a.indexmap().is_stride_order_C()) {
+      detail::h5_read_box(g, name, detail::h5_scalar<T>(), nda::is_complex_v<T>, a.data(), offset, count);
+    } else {
+      auto a_c = nda::array<T, nda::get_rank<std::decay_t<A>>>(a.shape());
+      detail::h5_read_box(g, name, detail::h5_scalar<T>(), nda::is_complex_v<T>, a_c.data(), offset, count);
+      a = a_c;
+    }
+  }
+
+} // namespace triqs::utility
@@ -46,7 +46,9 @@ MeshCyclicLattice = MeshCycLat
 
 from .gf_fnt import fit_tail, fit_hermitian_tail, density, set_from_fourier, is_gf_real_in_tau, set_from_legendre, set_from_imfreq, set_from_imtime, is_gf_hermitian, fit_tail_on_window, fit_hermitian_tail_on_window, replace_by_tail, replace_by_tail_in_fit_window, rebinning_tau, enforce_discontinuity 
 
-from .gf_factories import make_gf_from_fourier, make_hermitian, make_real_in_tau, make_gf_dlr, fit_gf_dlr, make_gf_dlr_imtime, make_gf_dlr_imfreq, make_gf_imtime, make_gf_imfreq
+from .wrapped_aux import set_block_parallel, get_block_parallel
+
+from .gf_factories import make_gf_from_fourier, make_hermitian, make_real_in_tau, make_gf_dlr, fit_gf_dlr, make_gf_dlr_imtime, make_gf_dlr_imfreq, make_gf_imtime, make_gf_imfreq, dlr_dyson_g, dlr_dyson_sigma, dlr_convolve
 
 import warnings
 
@@ -63,7 +65,7 @@ __all__ = [ 'Omega','iOmega_n','SemiCircular','Flat', 'Wilson','Fourier','Legend
             'MeshBrZone', 'MeshBrillouinZone',
             'MeshCycLat', 'MeshCyclicLattice',
             'MeshDLR', 'MeshDLRImFreq', 'MeshDLRImTime',
-            'BlockGf', 'fix_gf_struct_type',
+            'BlockGf', 'fix_gf_struct_type', 'set_block_parallel', 'get_block_parallel',
             'Block2Gf',
             'inverse', 'conjugate', 'transpose',
             'is_gf_real_in_tau',
@@ -78,6 +80,7 @@ __all__ = [ 'Omega','iOmega_n','SemiCircular','Flat', 'Wilson','Fourier','Legend
             'set_from_legendre', 'set_from_imfreq', 'set_from_imtime',
             'make_gf_dlr', 'fit_gf_dlr', 'make_gf_dlr_imtime', 'make_gf_dlr_imfreq',
             'make_gf_imtime', 'make_gf_imfreq',
+            'dlr_dyson_g', 'dlr_dyson_sigma', 'dlr_convolve',
             'rebinning_tau', 'enforce_discontinuity',
             'density',
             'make_adjoint_mesh',
@@ -406,6 +406,13 @@ class BlockGf:
 
     def total_density(self, *args, **kwargs):
         """ Total density of G  """
+        from . import gf_fnt
+        from .meshes import MeshImFreq, MeshReFreq
+        g0 = self._first()
+        if g0.target_rank == 2 and isinstance(g0.mesh, MeshImFreq) and not (args or kwargs):
+            return gf_fnt.total_density(self)
+        if g0.target_rank == 2 and isinstance(g0.mesh, MeshReFreq) and 'beta' in kwargs:
+            return gf_fnt.total_density(self, kwargs['beta'])
         return sum([ g.total_density(*args, **kwargs)  for i,g in self ])
 
     def __check_attr(self,ATTR):
@@ -413,14 +420,25 @@ class BlockGf:
            raise RuntimeError("The blocks of this Green Function do not possess the %s method"%ATTR)
 
     def invert(self): 
-       """Inverse all the blocks inplace"""
+       """Inverse all the blocks inplace. Complex matrix-valued blocks are inverted according to the block execution policy, cf. set_block_parallel"""
        self.__check_attr("invert")
-       for i,g in self: g.invert()
+       if all(g.target_rank == 2 and g.data.dtype == np.complex128 for i,g in self):
+           from . import wrapped_aux
+           ds = []
+           for i,g in self:
+               d = g.data.view()
+               d.shape = (np.prod(d.shape[:-2]),) + d.shape[-2:] # reshaped view, guarantee no copy
+               ds.append(d)
+           wrapped_aux._gf_invert_data_in_place_blocks(ds)
+       else:
+           for i,g in self: g.invert()
 
     def inverse(self):
-       """Return inverse of the BlockGf"""
+       """Return inverse of the BlockGf, cf. invert"""
        self.__check_attr("inverse")
-       return self.__class__( name_block_generator = [ (n, g.inverse()) for n,g in self], make_copies=False)
+       r = self.copy()
+       r.invert()
+       return r
 
     def transpose(self):
        """Return transpose of the BlockGf"""
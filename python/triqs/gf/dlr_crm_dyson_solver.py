@@ -24,7 +24,7 @@ from triqs.gf import (
     BlockGf,
     make_gf_dlr,
     make_gf_dlr_imfreq,
-    inverse
+    dlr_dyson_sigma
 )
 from triqs.gf.meshes import MeshDLRImFreq, MeshDLRImTime, MeshDLR
 
@@ -182,7 +182,7 @@ def minimize_dyson(
         return r
 
     # compute initial guess for Sigma from Dyson equation
-    sig0_iwaa = inverse(g0_iwaa) - inverse(g_iwaa) - Sigma_moments[0]
+    sig0_iwaa = dlr_dyson_sigma(g0_iwaa, g_iwaa) - Sigma_moments[0]
     x_init = flatten(sig0_iwaa.data)
 
     # run solver to optimize Σ(iν)
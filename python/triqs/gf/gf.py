@@ -71,6 +71,87 @@ class Idx:
     def __init__(self, *x):
         self.index = x[0] if len(x)==1 else x
 
+# ---------- Single-pass evaluation of lazy expressions
+
+class _NotFusable(Exception):
+    pass
+
+# The instructions of wrapped_aux.eval_expr_program, cf. triqs/gfs/gf/expr_program.hpp
+_expr_op = dict(push_data = 0, push_constant = 1, push_omega = 2, inverse = 7, transpose = 8, conjugate = 9)
+_expr_binary_op = {"+": 3, "-": 4, "*": 5, "/": 6}
+
+def _eval_lazy_expr_fused(g, expr):
+    """
+    Evaluate the lazy expression into g in a single pass over the mesh, with no temporary Gf.
+
+    The expression is lowered to a postfix program on the (N,N) matrices at each mesh point,
+    which is executed in C++. Returns False, leaving g untouched, if the expression
+    is not supported, e.g. for Gf of different mesh or target shape, or for an unknown lazy function.
+    In that case the caller falls back to the term by term evaluation.
+    """
+    from . import tools
+    if g.target_rank not in (0, 2) or g.data.dtype != np.complex128: return False
+    if g.target_rank == 2 and g.target_shape[0] != g.target_shape[1]: return False
+    N = g.target_shape[0] if g.target_rank == 2 else 1
+    n_mesh = len(g.mesh)
+    is_freq = type(g.mesh) in [meshes.MeshImFreq, meshes.MeshDLRImFreq, meshes.MeshReFreq]
+    functions = {'inverse': tools.inverse, 'transpose': tools.transpose, 'conjugate': tools.conjugate}
+
+    program, operands = [], []
+    def push(op, a):
+        program.extend([_expr_op[op], len(operands)])
+        operands.append(np.ascontiguousarray(a, dtype=np.complex128))
+
+    def push_gf(x):
+        if x.mesh != g.mesh or x.target_shape != g.target_shape: raise _NotFusable
+        push('push_data', x.data.reshape(n_mesh, N, N))
+
+    def push_constant(c):
+        c = np.asarray(c)
+        if c.ndim == 0: c = c * np.identity(N)
+        if c.shape != (N, N): raise _NotFusable
+        push('push_constant', c.reshape(1, N, N))
+
+    def lower(e):
+        if e.tag == "T":
+            x = e.childs[0]
+            if isinstance(x, Gf): push_gf(x)
+            elif isinstance(x, descriptor_base.Omega_):
+                if not is_freq: raise _NotFusable
+                program.append(_expr_op['push_omega'])
+            elif isinstance(x, descriptor_base.Const):
+                if not is_freq: raise _NotFusable
+                push_constant(x.C)
+            elif isinstance(x, descriptor_base.Base):
+                tmp = g.copy()
+                x(tmp)
+                push_gf(tmp)
+            elif descriptor_base.is_scalar(x): push_constant(x)
+            else: raise _NotFusable
+        elif e.tag == "F":
+            name, f = e.childs[0].get_terminal()
+            if functions.get(name) is not f or len(e.childs) != 2: raise _NotFusable
+            if name == 'transpose' and g.target_rank != 2: raise _NotFusable
+            lower(e.childs[1])
+            program.append(_expr_op[name])
+        else:
+            # Division of a matrix valued Gf is elementwise, only a division by a number is a matrix operation
+            if e.tag == "/" and N > 1 and not isinstance(e.childs[1].get_terminal(), numbers.Number): raise _NotFusable
+            lower(e.childs[0])
+            lower(e.childs[1])
+            program.append(_expr_binary_op[e.tag])
+
+    out = g.data.view()
+    try:
+        out.shape = (n_mesh, N, N) # reshaped view, guarantee no copy
+        lower(expr)
+    except (AttributeError, _NotFusable):
+        return False
+
+    omega = np.asarray(g.mesh.values() if is_freq else [], dtype=np.complex128)
+    wrapped_aux.eval_expr_program(out, program, operands, omega)
+    return True
+
 class Gf(metaclass=AddMethod):
     r""" TRIQS Greens function container class
 
@@ -393,6 +474,7 @@ class Gf(metaclass=AddMethod):
                 self.copy_from(A)
         elif isinstance(A, lazy_expressions.LazyExpr): # A is a lazy_expression made of GF, scalars, descriptors
             A2 = descriptors.convert_scalar_to_const(A)
+            if _eval_lazy_expr_fused(self, A2): return self
             def e_t (x):
                 if not isinstance(x, descriptors.Base): return x
                 tmp = self.copy()
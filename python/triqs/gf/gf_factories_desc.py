@@ -157,6 +157,14 @@ for Target in  ["scalar_valued", "tensor_valued<1>", "matrix_valued", "tensor_va
         m.add_function(f"{gf_type}<imfreq, {Target}> make_gf_imfreq({gf_view_type}<dlr_imtime, {Target}> g_tau, long n_iw)", doc="""Transform any DLR Green's function to a Matsubara frequency Green's function""")
         m.add_function(f"{gf_type}<imfreq, {Target}> make_gf_imfreq({gf_view_type}<dlr_imfreq, {Target}> g_iw, long n_iw)", doc="""Transform any DLR Green's function to a Matsubara frequency Green's function""")
 
+# ---------------------- DLR Dyson equation and convolution --------------------
+for gf_type in ["gf", "block_gf"]:
+    gf_view_type = gf_type +  '_const_view'
+    m.add_function(f"{gf_type}<dlr_imfreq, matrix_valued> dlr_dyson_g({gf_view_type}<dlr_imfreq, matrix_valued> g0, {gf_view_type}<dlr_imfreq, matrix_valued> sigma)", doc="""Solve the Dyson equation G = (G0^-1 - Sigma)^-1 on the DLR Matsubara nodes""")
+    m.add_function(f"{gf_type}<dlr_imfreq, matrix_valued> dlr_dyson_sigma({gf_view_type}<dlr_imfreq, matrix_valued> g0, {gf_view_type}<dlr_imfreq, matrix_valued> g)", doc="""Solve the Dyson equation Sigma = G0^-1 - G^-1 on the DLR Matsubara nodes""")
+
+m.add_function("gf<dlr_imtime, matrix_valued> dlr_convolve(gf_const_view<dlr, matrix_valued> f, gf_const_view<dlr, matrix_valued> g, bool time_order = false)", doc="""The convolution int_0^beta f(tau - tau') g(tau') dtau' of two DLR coefficient Green's functions, on the DLR imaginary time nodes""")
+
 # DLR Product Mesh Conversion
 # Limit combinations to avoid compile-time blowup
 for Target in  ["scalar_valued", "matrix_valued"]:
@@ -11,12 +11,37 @@ m.add_include("<triqs/gfs/transform/pade.hpp>")
 m.add_include("<triqs/gfs/gf/gf_expr.hpp>")
 
 m.add_include("<cpp2py/converters/pair.hpp>")
+m.add_include("<cpp2py/converters/tuple.hpp>")
 m.add_include("<cpp2py/converters/vector.hpp>")
 m.add_include("<triqs/cpp2py_converters.hpp>")
 
 m.add_using("namespace triqs::arrays")
 m.add_using("namespace triqs::gfs")
 m.add_preamble("""
+namespace triqs::gfs {
+
+  // Python interface of fit_bath: the parameters as arguments, and the result as a tuple (V, eps, norm, n_iter, converged)
+  inline bath_fit_params make_bath_fit_params(bool complex_hoppings, double tol, long max_iter, long n_starts, double eps_min, double eps_max, long seed) {
+    return {complex_hoppings, tol, max_iter, n_starts, eps_min, eps_max, uint32_t(seed)};
+  }
+  inline auto as_tuple(bath_fit_result const &r) { return std::make_tuple(r.V, r.eps, r.norm, r.n_iter, r.converged); }
+
+  template <typename M>
+  auto fit_bath_py(gf_const_view<M, matrix_valued> delta, nda::matrix<dcomplex> const &V0, nda::vector<double> const &eps0, bool complex_hoppings,
+                   double tol, long max_iter, long n_starts, double eps_min, double eps_max, long seed) {
+    return as_tuple(fit_bath(delta, V0, eps0, make_bath_fit_params(complex_hoppings, tol, max_iter, n_starts, eps_min, eps_max, seed)));
+  }
+
+  template <typename M>
+  auto fit_bath_py(block_gf_const_view<M, matrix_valued> delta, std::vector<nda::matrix<dcomplex>> const &V0, std::vector<nda::vector<double>> const &eps0,
+                   bool complex_hoppings, double tol, long max_iter, long n_starts, double eps_min, double eps_max, long seed) {
+    auto res = fit_bath(delta, V0, eps0, make_bath_fit_params(complex_hoppings, tol, max_iter, n_starts, eps_min, eps_max, seed));
+    auto out = std::vector<decltype(as_tuple(res[0]))>{};
+    for (auto const &r : res) out.push_back(as_tuple(r));
+    return out;
+  }
+
+} // namespace triqs::gfs
 """)
 
 # ---------------------- Tail functionality --------------------
@@ -53,6 +78,9 @@ m.add_function("dcomplex density(gf_view<refreq, scalar_valued> g)", doc = "Dens
 m.add_function("matrix<dcomplex> density(gf_view<refreq, matrix_valued> g, double beta)", doc = "Density, as a matrix, computed from a frequency integral at finite temperature")
 m.add_function("dcomplex density(gf_view<refreq, scalar_valued> g, double beta)", doc = "Density, as a complex, computed from a  frequency integral at finite temperature")
 
+m.add_function("dcomplex total_density(block_gf_view<imfreq, matrix_valued> g, std::vector<array<dcomplex, 3>> known_moments = {})", doc = "Total density of all blocks, computed from a Matsubara sum")
+m.add_function("dcomplex total_density(block_gf_view<refreq, matrix_valued> g, double beta)", doc = "Total density of all blocks, computed from a frequency integral at finite temperature")
+
 m.add_function("matrix<dcomplex> density(gf_view<triqs::gfs::legendre, matrix_valued> g)", doc = "Density, as a matrix, computed from evaluation in imaginary time")
 m.add_function("dcomplex density(gf_view<triqs::gfs::legendre, scalar_valued> g)", doc = "Density, as a complex, computed from evaluation in imaginary time")
 
@@ -169,6 +197,17 @@ for Target in  ["scalar_valued", "tensor_valued<1>", "matrix_valued", "tensor_va
                     calling_pattern = "g_out = fourier(g_in)",
                     doc = """Fills self with the Fourier transform of g_in""")
 
+# ---------------------- Discretization of a hybridization function --------------------
+fit_bath_result = "std::tuple<matrix<dcomplex>, nda::vector<double>, double, long, bool>"
+fit_bath_args = "bool complex_hoppings, double tol, long max_iter, long n_starts, double eps_min, double eps_max, long seed"
+for mesh in ["imfreq", "imtime"]:
+    m.add_function(name = "fit_bath",
+                   signature = f"{fit_bath_result} fit_bath_py(gf_const_view<{mesh}, matrix_valued> delta, matrix<dcomplex> V0, nda::vector<double> eps0, {fit_bath_args})",
+                   doc = """Fit a hybridization function by bath sites with an L-BFGS minimization. Returns (V, eps, norm, n_iter, converged). Cf. triqs.gf.tools.discretize_bath""")
+    m.add_function(name = "fit_bath",
+                   signature = f"std::vector<{fit_bath_result}> fit_bath_py(block_gf_const_view<{mesh}, matrix_valued> delta, std::vector<matrix<dcomplex>> V0, std::vector<nda::vector<double>> eps0, {fit_bath_args})",
+                   doc = """Fit all blocks of a hybridization function by bath sites, in parallel over the blocks. Returns a list of (V, eps, norm, n_iter, converged)""")
+
 ########################
 ##   Code generation
 ########################
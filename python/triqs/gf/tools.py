@@ -24,6 +24,7 @@ from .block_gf import BlockGf
 from .gf import Gf
 from .gf_factories import make_hermitian
 import numpy as np
+import warnings
 from itertools import product
 from .backwd_compat.gf_refreq import GfReFreq
 from .map_block import map_block
@@ -323,8 +324,56 @@ def make_delta(V, eps, mesh, block_names=None):
     return delta_res
 
 
+def _bath_fit_initial_guess(delta_in, Nb, eps0, V0, cmplx):
+    # Returns the matrix-valued hybridization function and the initial hoppings and energies for the fit
+    if len(delta_in.target_shape) == 0:
+        delta = Gf(mesh=delta_in.mesh, data=delta_in.data.reshape(-1, 1, 1))
+    else:
+        delta = delta_in
+    n_orb = delta.target_shape[0]
+
+    # initialize bath_hoppings
+    # create bath hoppings V with dim (Nb)
+    if isinstance(V0, np.ndarray):
+        assert V0.shape == (n_orb, Nb), 'V0 shape is incorrect. Must be ({},{}), but is {}'.format(n_orb, Nb, V0.shape)
+    elif isinstance(V0, (float, complex)):
+        if isinstance(V0, complex) and not cmplx:
+            raise ValueError('V0 initialized with a complex value, but cmplx=False')
+        V0 = V0*np.ones((n_orb, Nb))
+    elif V0 is None:
+        print('initial guess of V from cholesky decomposition of leading order moment of delta_in')
+        # get 1st moment of delta_in
+        if isinstance(delta.mesh, MeshImFreq):
+            known_moments = make_zero_tail(delta, n_moments=1)
+            delta.mesh.set_tail_fit_parameters(tail_fraction=0.3)
+            tail, err = delta.fit_hermitian_tail(known_moments=known_moments)
+            leading_moment = tail[1]
+        else:
+            leading_moment = -delta.data[0, ...]-delta.data[-1, ...]
+        # obtain guess from cholesky decomposition of 1st moment (tail[1])
+        chol = np.linalg.cholesky(leading_moment)
+        # chol always returns complex arrays
+        if not cmplx:
+            chol = chol.real
+        # chol has shape n_orb x n_orb. We repeat columns
+        # of chol until V matrix is filled and normalize each
+        # col by the sqrt(#occurances)
+        col_idxs = [i % n_orb for i in range(Nb)]
+        V0 = np.block([chol[:, i:i+1] / np.sqrt(col_idxs.count(i)) for i in col_idxs])
+    else:
+        raise ValueError('V0 has invalid type {}, should be one of: None, float, complex, or np.ndarray'.format(type(V0)))
+
+    # bath energies are initialized as linspace over the approximate bandwidth or given as list
+    if (isinstance(eps0, list) or isinstance(eps0, np.ndarray)):
+        assert len(eps0) == Nb, 'len(eps) does not match number of bath sides'
+    else:
+        eps0 = np.linspace(-eps0, eps0, Nb)
+
+    return delta, np.asarray(V0, dtype=complex), np.asarray(eps0, dtype=float)
+
+
 def discretize_bath(delta_in, Nb, eps0=3, V0=None, tol=1e-15, maxiter=10000,
-                    cmplx=False, method='BFGS'):
+                    cmplx=False, method='BFGS', n_starts=1, eps_bounds=None, seed=0):
     r"""
     Discretize a given hybridization function using Nb bath sites.
 
@@ -340,8 +389,9 @@ def discretize_bath(delta_in, Nb, eps0=3, V0=None, tol=1e-15, maxiter=10000,
     .. math:: \left[ \frac{1}{\sqrt(N)} \sum_{i \omega_n}^{N} | \Delta^{disc} (i \omega_n) - \Delta (i \omega_n) |^2 \right]^{\frac{1}{2}}
     and for MeshImTime
     .. math:: \left[ \frac{1}{\sqrt(N)} \sum_{\tau}^{N} | \Delta^{disc} (\tau) - \Delta (\tau) |^2 \right]^{\frac{1}{2}}
-    This minimization is performed with the given tolerance using scipy.optimize.minimize
-    or the scipy.optimize.basinhopping frontend.
+    This minimization is performed in C++ (cf. fit_bath) with an L-BFGS using the analytic gradient,
+    with box constraints on the bath energies. Several starts run in parallel threads,
+    and the blocks of a BlockGf are fitted in parallel.
 
     Parameters
     ----------
@@ -360,14 +410,22 @@ def discretize_bath(delta_in, Nb, eps0=3, V0=None, tol=1e-15, maxiter=10000,
         .. math:: -\Delta(\tau=0^+) - \Delta(\tau=\beta^-)
         to obtain an initial guess for V.
     tol : float, default=1e-15
-        Tolerance for scipy minimize on data to optimize (xatol / ftol)
+        Tolerance on the relative decrease of the norm and on the projected gradient
     maxiter : int, default=10000
-        Maximum number of optimization steps
+        Maximum number of optimization steps per start
     complx : bool, default=False
         Allow the hoppings V to be complex
     method : string, default=BFGS
-        Method for minimizing the function.
-        Should be one of 'BFGS', 'Nelder-Mead' and 'basinhopping'.
+        'BFGS' for the L-BFGS minimization from the initial guess.
+        'basinhopping' uses at least 16 starts, perturbed from the initial guess.
+        'Nelder-Mead' is deprecated and replaced by 'BFGS'.
+    n_starts : int, default=1
+        Number of starts of the minimization, the first one from the initial guess,
+        the others from random perturbations of it. The best fit is returned.
+    eps_bounds : tuple(float, float), optional
+        Lower and upper bounds of the bath energies
+    seed : int, default=0
+        Seed of the random perturbations of the initial guess
 
     Returns
     -------
@@ -378,133 +436,60 @@ def discretize_bath(delta_in, Nb, eps0=3, V0=None, tol=1e-15, maxiter=10000,
     delta_disc : Gf or BlockGf
         Discretized hybridization function
     """
-    from scipy.optimize import minimize, basinhopping
-    if isinstance(delta_in, BlockGf):
-        V_opt, eps_opt, delta_list = [], [], []
-        for j, (block, delta) in enumerate(delta_in):
-            res = discretize_bath(delta, Nb,
-                                  eps0[j] if isinstance(eps0, list) else eps0,
-                                  V0[j] if isinstance(V0, list) else V0,
-                                  tol, maxiter, cmplx, method)
-            V_opt.append(res[0])
-            eps_opt.append(res[1])
-            delta_list.append(res[2])
-
-        return V_opt, eps_opt, BlockGf(name_list=list(delta_in.indices), block_list=delta_list)
-
-    # some tests if input is okay
-    assert isinstance(delta_in.mesh, MeshImFreq) or isinstance(delta_in.mesh, MeshImTime), 'input delta_in should have a mesh MeshImFreq or MeshImTime'
-
-    if isinstance(delta_in.mesh, MeshImFreq):
-        assert delta_in.is_gf_real_in_tau()
-
-    # enforce hermiticity
-    delta_in << make_hermitian(delta_in)
-
-    def unflatten(x):
-        # first half of parameters are hoppings, second half are bath energies
-        if cmplx:
-            V   = x[0:2*Nb*n_orb].view(complex).reshape(n_orb, Nb)
-            eps = x[2*Nb*n_orb:]
-        else:
-            V   = x[0:Nb*n_orb].reshape(n_orb, Nb)
-            eps = x[Nb*n_orb:]
-        return V, eps
+    if method == 'basinhopping':
+        n_starts = max(n_starts, 16)
+    elif method == 'Nelder-Mead':
+        warnings.warn("discretize_bath: method 'Nelder-Mead' is deprecated, using the L-BFGS minimization", DeprecationWarning)
+    elif method != 'BFGS':
+        raise ValueError('method for minimizer not recognized')
 
-    ####
-    # define minimizer for scipy
-    def minimizer(parameters):
-        V, eps = unflatten(parameters)
+    eps_min, eps_max = eps_bounds if eps_bounds is not None else (-np.inf, np.inf)
+    fit_args = (cmplx, tol, maxiter, n_starts, eps_min, eps_max, seed)
 
-        # Build discretized bath function
-        delta_disc = make_delta(V, eps, delta_in.mesh)
+    def results(delta_in, V, eps, norm, n_iter, converged):
+        print('optimization finished after {} iterations with norm {:.3e}'.format(n_iter, norm))
+        if not converged:
+            print('optimization finished, but the tolerance was not reached within maxiter iterations')
+        V_opt = V if cmplx else V.real
+        delta_disc = make_delta(V_opt, eps, delta_in.mesh)
 
         # if Gf is scalar-valued we have to squeeze the trivial axes
         if len(delta_in.target_shape) == 0:
             delta_disc = delta_disc[0, 0]
+        return V_opt, eps, delta_disc
 
-        # calculate norm
-        norm = np.linalg.norm(delta_disc.data - delta_in.data)/np.sqrt(len(delta_disc.mesh))
-        return norm
-    ####
-
-    if len(delta_in.target_shape) == 0:
-        n_orb = 1
-    else:
-        n_orb = delta_in.target_shape[0]
-
-    # initialize bath_hoppings
-    # create bath hoppings V with dim (Nb)
-    if isinstance(V0, np.ndarray):
-        assert V0.shape == (n_orb, Nb), 'V0 shape is incorrect. Must be ({},{}), but is {}'.format(n_orb, Nb, V0.shape)
-    elif isinstance(V0, (float, complex)):
-        if isinstance(V0, complex) and not cmplx:
-            raise ValueError('V0 initialized with a complex value, but cmplx=False')
-        V0 = V0*np.ones((n_orb, Nb))
-    elif V0 is None:
-        print('initial guess of V from cholesky decomposition of leading order moment of delta_in')
-        # get 1st moment of delta_in
-        if isinstance(delta_in.mesh, MeshImFreq):
-            known_moments = make_zero_tail(delta_in, n_moments=1)
-            delta_in.mesh.set_tail_fit_parameters(tail_fraction=0.3)
-            tail, err = delta_in.fit_hermitian_tail(known_moments=known_moments)
-            leading_moment = tail[1]
-        else:
-            leading_moment = -delta_in.data[0, ...]-delta_in.data[-1, ...]
-        # obtain guess from cholesky decomposition of 1st moment (tail[1])
-        chol = np.linalg.cholesky(leading_moment)
-        # chol always returns complex arrays
-        if not cmplx:
-            chol = chol.real
-        # chol has shape n_orb x n_orb. We repeat columns
-        # of chol until V matrix is filled and normalize each
-        # col by the sqrt(#occurances)
-        col_idxs = [i % n_orb for i in range(Nb)]
-        V0 = np.block([chol[:, i:i+1] / np.sqrt(col_idxs.count(i)) for i in col_idxs])
-    else:
-        raise ValueError('V0 has invalid type {}, should be one of: None, float, complex, or np.ndarray'.format(type(V0)))
-
-    # bath energies are initialized as linspace over the approximate bandwidth or given as list
-    if (isinstance(eps0, list) or isinstance(eps0, np.ndarray)):
-        assert len(eps0) == Nb, 'len(eps) does not match number of bath sides'
-    else:
-        eps0 = np.linspace(-eps0, eps0, Nb)
-
-    # parameters for scipy must be a 1D array
-    parameters = np.concatenate([V0.view(float).flatten(), eps0])
-
-    # run the minimizer with method Nelder-Mead and optimize the hoppings and energies to given
-    # tolerance
     start_time = timer()
-    if method == 'BFGS':
-        result = minimize(minimizer, parameters, method='L-BFGS-B',
-                          options={'ftol': tol, 'gtol': 1e-15, 'maxiter': maxiter, "disp": False, "maxfun": maxiter})
-    elif method == 'basinhopping':
-        result = basinhopping(minimizer, parameters, niter_success=30, niter=maxiter, disp=False, stepsize=0.8,
-                              minimizer_kwargs={'method': 'L-BFGS-B',
-                                                'options': {'ftol': tol, 'gtol': 1e-15, "disp": False, "maxfun": 10000000}})\
-                              .lowest_optimization_result
-    elif method == 'Nelder-Mead':
-        result = minimize(minimizer, parameters, method='Nelder-Mead', options={'xatol': tol, 'maxiter': maxiter, 'adaptive': True})
-    else:
-        raise ValueError('method for minimizer not recognized')
 
-    print('optimization finished in {:.2f} s after {} iterations with norm {:.3e}'.format(timer()-start_time, result.nit, result.fun))
+    if isinstance(delta_in, BlockGf):
+        blocks, V_init, eps_init = [], [], []
+        for j, (block, delta) in enumerate(delta_in):
+            _check_bath_input(delta)
+            d, V, e = _bath_fit_initial_guess(delta, Nb,
+                                              eps0[j] if isinstance(eps0, list) else eps0,
+                                              V0[j] if isinstance(V0, list) else V0, cmplx)
+            blocks.append(d)
+            V_init.append(V)
+            eps_init.append(e)
+
+        delta_mat = BlockGf(name_list=list(delta_in.indices), block_list=blocks, make_copies=False)
+        res = [results(delta, *r) for (block, delta), r in zip(delta_in, gf_fnt.fit_bath(delta_mat, V_init, eps_init, *fit_args))]
+        print('bath fit of {} blocks finished in {:.2f} s'.format(len(res), timer()-start_time))
+
+        V_opt, eps_opt, delta_list = map(list, zip(*res))
+        return V_opt, eps_opt, BlockGf(name_list=list(delta_in.indices), block_list=delta_list)
 
-    if not result.success:
-        print('optimization finished, but scipy minimize signaled no success, check result: {}'.format(result.message))
-    # results
-    V_opt, eps_opt = unflatten(result.x)
+    _check_bath_input(delta_in)
+    delta, V_init, eps_init = _bath_fit_initial_guess(delta_in, Nb, eps0, V0, cmplx)
+    res = results(delta_in, *gf_fnt.fit_bath(delta, V_init, eps_init, *fit_args))
+    print('bath fit finished in {:.2f} s'.format(timer()-start_time))
+    return res
 
-    # sort by energy
-    order = np.argsort(eps_opt)
-    eps_opt = eps_opt[order]
-    V_opt = V_opt[:, order]
 
-    delta_disc = make_delta(V_opt, eps_opt, delta_in.mesh)
+def _check_bath_input(delta_in):
+    # some tests if input is okay, and enforce hermiticity
+    assert isinstance(delta_in.mesh, MeshImFreq) or isinstance(delta_in.mesh, MeshImTime), 'input delta_in should have a mesh MeshImFreq or MeshImTime'
 
-    # if Gf is scalar-valued we have to squeeze the trivial axes
-    if len(delta_in.target_shape) == 0:
-        delta_disc = delta_disc[0, 0]
+    if isinstance(delta_in.mesh, MeshImFreq):
+        assert delta_in.is_gf_real_in_tau()
 
-    return V_opt, eps_opt, delta_disc
+    delta_in << make_hermitian(delta_in)
@@ -147,6 +147,23 @@ for TY in ['double', 'dcomplex'] :
 
 # invert auxiliary tool
 m.add_function("void _gf_invert_data_in_place(array_view <dcomplex, 3> a)", doc = "Aux function for inversion")
+m.add_function("void _gf_invert_data_in_place_blocks(std::vector<array_view<dcomplex, 3>> a)",
+               calling_pattern = "details::for_each_block(a.size(), get_block_exec_policy(), [&a](long i) { _gf_invert_data_in_place(a[i]); })",
+               doc = "Aux function for the inversion of the blocks of a BlockGf, according to the block execution policy")
+
+m.add_function("void eval_expr_program(array_view<dcomplex, 3> out, std::vector<long> program, std::vector<array_view<dcomplex, 3>> operands, array_view<dcomplex, 1> omega)",
+               doc = "Aux function for the single-pass evaluation of lazy expressions")
+
+# Execution policy of the block functions, cf. triqs/gfs/block/exec_policy.hpp
+m.add_function("bool set_block_parallel(bool parallel)",
+               calling_pattern = "bool result = set_block_exec_policy(parallel ? block_exec_policy::parallel : block_exec_policy::sequential) == block_exec_policy::parallel",
+               doc = "Compute the blocks of block Green functions in parallel (or not) in the C++ block functions. Returns the previous setting.\n\n"
+                     "In Python, it applies to the functions called on a whole BlockGf (make_gf_from_fourier, fit_tail, total_density, ...) "
+                     "and to BlockGf.invert and BlockGf.inverse. The other BlockGf methods (arithmetic, <<, density, ...) loop over the blocks in Python "
+                     "and are not parallelized.")
+m.add_function("bool get_block_parallel()",
+               calling_pattern = "bool result = get_block_exec_policy() == block_exec_policy::parallel",
+               doc = "Are the blocks of block Green functions computed in parallel in the C++ block functions?")
 
 # For legacy Python code : authorize g + Matrix functions, which are defined in legacy_for_python_api.hpp
 for M in ['imfreq', 'imtime', 'refreq', 'retime', 'brzone', 'cyclat', 'legendre', 'dlr', 'dlr_imfreq', 'dlr_imtime']:
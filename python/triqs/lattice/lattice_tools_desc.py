@@ -3,10 +3,12 @@ from cpp2py.wrap_generator import *
 module = module_(full_name = "triqs.lattice.lattice_tools", doc = "Lattice tools (to be improved)")
 module.add_include("<triqs/lattice/brillouin_zone.hpp>")
 module.add_include("<triqs/lattice/tight_binding.hpp>")
+module.add_include("<triqs/lattice/lattice_gf.hpp>")
 
 module.add_include("<cpp2py/converters/pair.hpp>")
 module.add_include("<cpp2py/converters/vector.hpp>")
 module.add_include("<cpp2py/converters/map.hpp>")
+module.add_include("<cpp2py/converters/string.hpp>")
 module.add_include("<triqs/cpp2py_converters.hpp>")
 
 module.add_using("namespace triqs::lattice")
@@ -177,17 +179,87 @@ tb.add_method(name = "dispersion",
               signature = "gf<mesh::brzone, tensor_real_valued<1>> (mesh::brzone k_mesh)",
               doc = """Evaluate the dispersion relation on the k_mesh and return the associated Green-function object""")
 
+tb.add_method(name = "dispersion",
+              signature = "gf<mesh::brzone, tensor_real_valued<1>> (irreducible_kgrid grid)",
+              doc = """Evaluate the dispersion relation on the full mesh of an IrreducibleKGrid, diagonalizing only at the irreducible points""")
+
+tb.add_method(name = "eigenelements",
+              signature = "std::pair<nda::array<double, 2>, nda::array<dcomplex, 3>> (matrix_const_view<double> K)",
+              doc = """Evaluate the eigenvalues eps(k, band) and eigenvectors U(k, orbital, band) for an array of momentum vectors k in units of the reciprocal lattice vectors, in batches and in parallel""")
+
+tb.add_method(name = "eigenelements",
+              signature = "std::pair<gf<mesh::brzone, tensor_real_valued<1>>, gf<mesh::brzone, matrix_valued>> (irreducible_kgrid grid)",
+              doc = """Evaluate the eigenvalues and eigenvectors on the full mesh of an IrreducibleKGrid, diagonalizing only at the irreducible points""")
+
 
 module.add_class(tb)
 
+# ---------   IrreducibleKGrid ----------------------------------
+kg = class_(py_type = "IrreducibleKGrid",
+        c_type = "irreducible_kgrid",
+        c_type_absolute = "triqs::lattice::irreducible_kgrid",
+        doc = """
+        A Brillouin-zone mesh reduced to its irreducible wedge by symmetry operations
+
+        Each point of the mesh is the image of one irreducible point, so that
+        quantities computed on the irreducible points unfold onto the full mesh,
+        e.g. x_full = x_irr[grid.irr_index].
+
+        Parameters
+        ----------
+        k_mesh : MeshBrZone
+            The Brillouin-zone mesh
+        tb : TightBinding, optional
+            Use the symmetries of the hoppings instead of the point group of the lattice
+        """
+       )
+
+kg.add_constructor(signature = "(mesh::brzone k_mesh)",
+                   doc = """Reduce the mesh with the point group of its lattice""")
+
+kg.add_constructor(signature = "(mesh::brzone k_mesh, tight_binding tb)",
+                   calling_pattern = "auto result = irreducible_kgrid(k_mesh, tb.symmetries())",
+                   doc = """Reduce the mesh with the symmetries of a tight-binding Hamiltonian""")
+
+kg.add_property(getter = cfunction("mesh::brzone k_mesh()"), doc = "The full Brillouin-zone mesh")
+kg.add_property(getter = cfunction("long size()"), doc = "Number of irreducible points")
+kg.add_property(getter = cfunction("std::vector<long> irr_points()"), doc = "The data indices in k_mesh of the irreducible points")
+kg.add_property(getter = cfunction("nda::vector<double> weights()"), doc = "The weights of the irreducible points, which sum to 1")
+kg.add_property(getter = cfunction("std::vector<long> irr_index()"), doc = "For each data index of k_mesh, the index of its irreducible point")
+kg.add_property(getter = cfunction("std::vector<long> op_index()"), doc = "For each data index of k_mesh, the index of the operation which maps its irreducible point onto it")
+kg.add_property(getter = cfunction("matrix<double> kvecs()"), doc = "The irreducible points in units of the reciprocal lattice vectors, as rows")
+
+module.add_class(kg)
+
 # ---------   Module functions ----------------------------------
 
 module.add_function(name = "dos",
                     signature = "std::pair<array<double, 1>, array<double, 2>> (tight_binding  TB, int nkpts, int neps)",
                     doc = """ """)
+module.add_function(name = "dos_tetrahedron",
+                    signature = "std::pair<array<double, 1>, array<double, 2>> (tight_binding TB, int nkpts, int neps, bool bloechl_correction = true)",
+                    doc = r"""Density of states and orbital-resolved partial DOS using the linear tetrahedron method""")
 module.add_function(name = "dos_patch",
                     signature = "std::pair<array<double, 1>, array<double, 1>> (tight_binding  TB, array<double, 2> triangles, int neps, int ndiv)",
                     doc = """ """)
+module.add_function(name = "parse_wannier90_hr",
+                    signature = "std::pair<std::vector<nda::vector<long>>, std::vector<matrix<dcomplex>>> (std::string filename)",
+                    doc = r"""Stream the displacements and the hopping matrices, divided by the degeneracies, of a Wannier90 *_hr.dat file""")
+module.add_function(name = "tight_binding_from_wannier90_hr",
+                    signature = "tight_binding (bravais_lattice bl, std::string filename, std::string cache_file)",
+                    doc = r"""The TightBinding of a Wannier90 *_hr.dat file, optionally read from or written to an HDF5 cache file""")
+module.add_function(name = "make_lattice_gf",
+                    signature = "gf<prod<brzone, imfreq>, matrix_valued> (tight_binding tb, mesh::brzone k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma)",
+                    doc = r"""The lattice Green function G(k, iw) = [iw + mu - h_k - Sigma(iw)]^{-1}, threaded and distributed over k""")
+module.add_function(name = "make_lattice_gf_local",
+                    signature = "gf<imfreq, matrix_valued> (tight_binding tb, mesh::brzone k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma)",
+                    doc = r"""The local lattice Green function, summed over k without storing G(k, iw)""")
+module.add_function(name = "make_lattice_gf_real_space",
+                    signature = "std::vector<gf<imfreq, matrix_valued>> (tight_binding tb, mesh::brzone k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma, std::vector<nda::vector<long>> R_vec)",
+                    doc = r"""The lattice Green functions G(R, iw) for a list of displacements R, summed over k without storing G(k, iw)""")
+module.add_function(name = "lattice_density",
+                    signature = "gf<brzone, matrix_valued> (tight_binding tb, mesh::brzone k_mesh, double mu, gf_const_view<imfreq, matrix_valued> sigma)",
+                    doc = r"""The density matrix n(k) of the lattice Green function, without storing G(k, iw)""")
 
 ########################
 ##   Code generation
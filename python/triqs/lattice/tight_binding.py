@@ -19,7 +19,7 @@
 
 
 from h5.formats import register_class
-__all__ = ['BravaisLattice', 'BrillouinZone', 'TightBinding', 'dos', 'TBLattice']
+__all__ = ['BravaisLattice', 'BrillouinZone', 'TightBinding', 'dos', 'dos_tetrahedron', 'TBLattice']
 
 from ..gf import Gf, MeshBrZone, MeshCycLat
 from .lattice_tools import BravaisLattice
@@ -27,6 +27,7 @@ from .lattice_tools import BrillouinZone
 from .lattice_tools import TightBinding
 from .lattice_tools import dos_patch as dos_patch_c
 from .lattice_tools import dos as dos_c
+from .lattice_tools import dos_tetrahedron as dos_tetrahedron_c
 from triqs.dos import DOS
 import numpy
 import warnings
@@ -45,6 +46,20 @@ def dos(tight_binding, n_kpts, n_eps, name):
     return [DOS(eps, arr[:, i], name) for i in range(arr.shape[1])]
 
 
+def dos_tetrahedron(tight_binding, n_kpts, n_eps, name, bloechl_correction = True):
+    """
+    :param tight_binding: a tight_binding object
+    :param n_kpts: the number of k points to use in each dimension
+    :param n_eps: number of energy bins
+    :param name: name of the resulting dos
+    :param bloechl_correction: apply the Bloechl correction (3d only)
+
+    :rtype: return a list of DOS, one for each orbital, using the linear tetrahedron method
+    """
+    eps, arr = dos_tetrahedron_c(tight_binding, n_kpts, n_eps, bloechl_correction)
+    return [DOS(eps, arr[:, i], name) for i in range(arr.shape[1])]
+
+
 def dos_patch(tight_binding, triangles, n_eps, n_div, name):
     """
     To be written
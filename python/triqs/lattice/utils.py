@@ -96,29 +96,13 @@ def parse_hopping_from_wannier90_hr_dat(filename):
 
     """
 
-    with open(filename, 'r') as fd:
-        fd.readline()  # eliminate time header
-        num_wann = int(fd.readline())
-        nrpts = int(fd.readline())
-        lines = fd.readlines()
-
-    # Read R Vector degeneracies, At most 15 elements before line-break
-    nlines = int(np.ceil(nrpts / 15.))
-    deg = np.array("".join(lines[:nlines]).split(), dtype=int)
-    assert deg.shape == (nrpts,)
-
-    # Read R Vector and Hopping data
-    dat = "".join(lines[nlines:])
-    dat = np.loadtxt(StringIO(dat))
-    dat = dat.reshape(nrpts, num_wann, num_wann, 7)
-    R = dat[:, 0, 0, 0:3].astype(int)
-    hopp = dat[..., 5] + 1.j * dat[..., 6]
+    from triqs.lattice.lattice_tools import parse_wannier90_hr
 
-    # Account for degeneracy of the Wigner-Seitz points
-    hopp /= deg[:, None, None]
+    displs, hopps = parse_wannier90_hr(filename)
+    num_wann = hopps[0].shape[0]
 
     # Dict with hopping matrices
-    hopp_dict = {tuple(R[i]): hopp[i] for i in range(nrpts)}
+    hopp_dict = {tuple(R): hopp for R, hopp in zip(displs, hopps)}
 
     return hopp_dict, num_wann
 
@@ -171,7 +155,7 @@ def extend_wannier90_to_spin(hopp_dict, num_wann):
     return hopp_dict_spin, 2 * num_wann
 
 
-def TB_from_wannier90(seed, path='./',  extend_to_spin=False, add_local=None):
+def TB_from_wannier90(seed, path='./',  extend_to_spin=False, add_local=None, cache=None):
     r"""
     read wannier90 output and convert to TBLattice object
 
@@ -188,6 +172,9 @@ def TB_from_wannier90(seed, path='./',  extend_to_spin=False, add_local=None):
         extend hopping Hamiltonian with spin indices
     add_local: numpy array , default = None
         add a local term to hopping[0,0,0] of shape Norb x Norb
+    cache: str, default = None
+        HDF5 file caching the parsed hoppings. It is read instead of seed_hr.dat
+        if it is up to date, and written otherwise
 
     Returns
     -------
@@ -197,20 +184,35 @@ def TB_from_wannier90(seed, path='./',  extend_to_spin=False, add_local=None):
     """
 
     from triqs.lattice.tight_binding import TBLattice
+    from triqs.lattice.lattice_tools import BravaisLattice, TightBinding, tight_binding_from_wannier90_hr
 
-    hopp_dict, num_wann = parse_hopping_from_wannier90_hr_dat(path + seed + '_hr.dat')
+    hr_file = path + seed + '_hr.dat'
     units = parse_lattice_vectors_from_wannier90_wout(path + seed + '.wout')
+    with open(hr_file, 'r') as fd:
+        fd.readline()  # eliminate time header
+        num_wann = int(fd.readline())
 
-    if extend_to_spin:
-        hopp_dict, num_wann = extend_wannier90_to_spin(hopp_dict, num_wann)
+    # Stream the hoppings directly into a TightBinding
+    bl = BravaisLattice(units, [(0, 0, 0)]*num_wann, [str(i) for i in range(num_wann)])
+    tb = tight_binding_from_wannier90_hr(bl, hr_file, cache or "")
 
-    if add_local is not None:
-        hopp_dict[(0, 0, 0)] += add_local
+    if extend_to_spin:
+        num_wann *= 2
 
-    # Should we use hopp_dict or hopping?
-    TBL = TBLattice(units=units, hoppings=hopp_dict,
+    TBL = TBLattice(units=units,
                     orbital_positions=[(0, 0, 0)]*num_wann,
                     orbital_names=[str(i) for i in range(num_wann)])
+
+    if extend_to_spin or add_local is not None:
+        displs, hopps = tb.displ_vec, tb.overlap_mat_vec
+        if extend_to_spin:
+            hopps = [np.kron(np.eye(2), hopp) for hopp in hopps]
+        if add_local is not None:
+            R0 = next(i for i, R in enumerate(displs) if not np.any(R))
+            hopps[R0] = hopps[R0] + add_local
+        tb = TightBinding(TBL.bl, displs, hopps)
+
+    TBL.tb = tb
     return TBL
 
 def TB_from_pythTB(ptb):
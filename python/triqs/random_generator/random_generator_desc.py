@@ -16,6 +16,7 @@ module.add_include("<triqs/cpp2py_converters.hpp>")
 r = class_(py_type = "RandomGenerator",
            c_type = "random_generator",
            c_type_absolute = "triqs::mc_tools::random_generator",
+           hdf5 = True,
           )
 
 r.add_constructor(signature = "(std::string name, int seed)", 
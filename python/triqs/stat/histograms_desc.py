@@ -111,6 +111,35 @@ c.add_method("""void clear ()""",
 
     Resets all data values and the total counts of accumulated and discarded points.""")
 
+c.add_method("""void insert(nda::vector<double> xs, bool parallel = false)""",
+             calling_pattern = "self_c.insert(std::span<double const>{xs.data(), size_t(xs.size())}, parallel)",
+             doc = r"""Bin a batch of real values into the histogram
+
+    The values are binned with the same convention as the ``<<`` operator.
+
+Parameters
+----------
+xs
+     Sampled values, e.g. a numpy array
+
+parallel
+     Distribute the values over the OpenMP threads""")
+
+c.add_method("""void insert(nda::vector<long> ns, bool parallel = false)""",
+             calling_pattern = "self_c.insert(std::span<long const>{ns.data(), size_t(ns.size())}, parallel)",
+             doc = r"""Bin a batch of integer values into the histogram
+
+    For a histogram with bin length 1 over an integer range, the values are binned
+    without floating-point arithmetic.
+
+Parameters
+----------
+ns
+     Sampled values, e.g. a numpy array of perturbation orders
+
+parallel
+     Distribute the values over the OpenMP threads""")
+
 f = pyfunction(name = '__lshift__', arity = 2)
 f.add_overload(calling_pattern = '<<', signature = 'self_t& (triqs::stat::histogram h, double x)')
 f.treat_as_inplace = True
@@ -35,8 +35,64 @@ master =0
 
 All_Nodes_report = False
 
-def bcast(x, root = 0):
-    return world.bcast(x, root = root)
+# ---------- Buffer-based collectives for numpy arrays and Green functions
+
+def _is_gf(x, *schemes):
+    return getattr(type(x), '_hdf5_data_scheme_', None) in schemes
+
+def _data_arrays(x):
+    """
+    The numpy arrays holding the data of x, or None if x is not a contiguous numeric array, a Gf, a BlockGf or a Block2Gf.
+    Arrays of other dtypes (object, unicode, structured, ...) or strided arrays are pickled.
+    """
+    import numpy as np
+    if isinstance(x, np.ndarray): return [x] if x.dtype.kind in 'biufc' and x.flags.c_contiguous else None
+    if _is_gf(x, 'Gf'): return [x.data]
+    if _is_gf(x, 'BlockGf', 'Block2Gf'): return [g.data for i, g in x]
+    return None
+
+def _skeleton(x):
+    """A picklable description of the structure of x, without its data"""
+    import numpy as np
+    if isinstance(x, np.ndarray): return ('ndarray', x.shape, x.dtype)
+    if _is_gf(x, 'Gf'): return ('Gf', x.mesh, x.data.shape, x.data.dtype, x.name)
+    if _is_gf(x, 'BlockGf'): return ('BlockGf', list(x.indices), [_skeleton(g) for i, g in x], x.name)
+    return ('Block2Gf', list(x.indices1), list(x.indices2), [_skeleton(g) for i, g in x], x.name)
+
+def _from_skeleton(s):
+    """An object of the structure s, with uninitialized data"""
+    import numpy as np
+    from triqs.gf import Gf, BlockGf, Block2Gf
+    if s[0] == 'ndarray': return np.empty(s[1], dtype=s[2])
+    if s[0] == 'Gf': return Gf(mesh=s[1], data=np.empty(s[2], dtype=s[3]), name=s[4])
+    if s[0] == 'BlockGf': return BlockGf(name_list=s[1], block_list=[_from_skeleton(b) for b in s[2]], make_copies=False, name=s[3])
+    n2 = len(s[2])
+    blocks = [_from_skeleton(b) for b in s[3]]
+    return Block2Gf(s[1], s[2], [blocks[i:i + n2] for i in range(0, len(blocks), n2)], make_copies=False, name=s[4])
+
+def _in_place(arrays, f):
+    """Call f on each array, through a contiguous copy if needed"""
+    import numpy as np
+    for a in arrays:
+        if a.flags.c_contiguous:
+            f(a)
+        else:
+            b = np.ascontiguousarray(a)
+            f(b)
+            a[...] = b
+
+def bcast(x, root = 0, comm = world):
+    """
+    Broadcast x from the root. Contiguous numeric numpy arrays and Green functions (Gf, BlockGf, Block2Gf)
+    are sent as raw buffers after their structure, other objects are pickled.
+    """
+    is_root = comm.Get_rank() == root
+    if is_root: s = comm.bcast(('buffer', _skeleton(x)) if _data_arrays(x) is not None else ('pickle', x), root = root)
+    else: s = comm.bcast(None, root = root)
+    if s[0] == 'pickle': return x if is_root else s[1]
+    if not is_root: x = _from_skeleton(s[1])
+    _in_place(_data_arrays(x), lambda a: comm.Bcast(a, root = root))
+    return x
 
 def send(val, dest):
     world.send(val, dest = dest)
@@ -65,6 +121,15 @@ def barrier(poll_msec=1):
             time.sleep(poll_msec / 1000)
 
 def all_reduce(x, comm=world, op=MPI.SUM):
+    """
+    Reduce x over all nodes and return the result on every node.
+    Contiguous numeric numpy arrays and Green functions are reduced as raw buffers into a copy of x,
+    other objects are pickled. x must have the same type, dtype and layout on all nodes.
+    """
+    if _data_arrays(x) is not None and isinstance(op, MPI.Op):
+        res = x.copy()
+        _in_place(_data_arrays(res), lambda a: comm.Allreduce(MPI.IN_PLACE, a, op = op))
+        return res
     try:
         return comm.allreduce(x, op=op)
     except (AttributeError, TypeError) as e:
@@ -75,6 +140,20 @@ def all_reduce(x, comm=world, op=MPI.SUM):
             return world.allreduce(comm)
         raise e
 
+def reduce(x, root=0, comm=world, op=MPI.SUM):
+    """
+    Reduce x over all nodes, the result is returned on the root and None on the other nodes.
+    Contiguous numeric numpy arrays and Green functions are reduced as raw buffers, other objects are pickled.
+    x must have the same type, dtype and layout on all nodes.
+    """
+    if _data_arrays(x) is None or not isinstance(op, MPI.Op):
+        return comm.reduce(x, op = op, root = root)
+    if comm.Get_rank() == root:
+        res = x.copy()
+        _in_place(_data_arrays(res), lambda a: comm.Reduce(MPI.IN_PLACE, a, op = op, root = root))
+        return res
+    _in_place(_data_arrays(x), lambda a: comm.Reduce(a, None, op = op, root = root))
+    return None
 
 Verbosity_Level_Report_Max = 1
 def report(*x,**opt):
@@ -46,7 +46,7 @@ def report(*x,**opt):
 
 def is_master_node(): return True
 
-def bcast(x, root = 0): return x
+def bcast(x, root = 0, comm = world): return x
 
 def barrier(poll_msec=1) : return
 
@@ -59,6 +59,8 @@ def all_reduce(x, comm=world, op=lambda x, y: x + y):
         return comm
     return x
 
+def reduce(x, root=0, comm=world, op=lambda x, y: x + y): return x
+
 def send(val, dest):
     _sendval = val
     return
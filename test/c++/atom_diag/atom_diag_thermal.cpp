@@ -0,0 +1,66 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/gfs.hpp>
+
+#include <triqs/atom_diag/atom_diag.hpp>
+#include <triqs/atom_diag/functions.hpp>
+#include <triqs/atom_diag/thermal_state.hpp>
+
+#include "./hamiltonian.hpp"
+
+using namespace triqs::atom_diag;
+
+template <bool Complex> void check_thermal_state() {
+  using op_t = typename atom_diag<Complex>::many_body_op_t;
+
+  auto fops = make_fops();
+  auto h    = make_hamiltonian<op_t>(0.5, 3.0, 0.3, 0.1, 0.2);
+  auto ad   = atom_diag<Complex>(h, fops);
+  auto ts   = thermal_state<Complex>(ad);
+
+  std::vector<op_t> ops;
+  for (auto s : {"up", "dn"})
+    for (int o : range(3)) ops.push_back(op_t{n(s, o)});
+  ops.push_back(h);
+  ops.push_back(op_t{c_dag("up", 0) * c("up", 1)});
+
+  for (double beta : {1.0, 10.0, 1.0}) {
+    EXPECT_NEAR(ts.partition_function(beta), partition_function(ad, beta), 1e-10 * partition_function(ad, beta));
+
+    auto dm              = atomic_density_matrix(ad, beta);
+    auto dm_ts           = ts.density_matrix(beta);
+    auto values          = ts.expectation_values(ops, beta);
+    auto values_threaded = ts.expectation_values(ops, beta, true);
+    for (int bl : range(ad.n_subspaces())) EXPECT_ARRAY_NEAR(dm[bl], dm_ts[bl], 1e-12);
+    for (int i : range(ops.size())) {
+      EXPECT_COMPLEX_NEAR(values[i], trace_rho_op(dm, ops[i], ad), 1e-10);
+      EXPECT_COMPLEX_NEAR(values_threaded[i], values[i], 1e-12);
+      EXPECT_COMPLEX_NEAR(ts.expectation_value(ops[i], beta), values[i], 1e-12);
+    }
+  }
+
+  // Cached results are the same after clearing the caches
+  auto e = ts.expectation_value(h, 10.0);
+  ts.clear_cache();
+  EXPECT_COMPLEX_NEAR(ts.expectation_value(h, 10.0), e, 1e-14);
+}
+
+TEST(atom_diag_thermal, Real) { check_thermal_state<false>(); }
+TEST(atom_diag_thermal, Complex) { check_thermal_state<true>(); }
+
+MAKE_MAIN;
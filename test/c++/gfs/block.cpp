@@ -141,4 +141,56 @@ TEST(Block, Arithmetic) {
   EXPECT_BLOCK_GF_NEAR(block_gf<imfreq>{2 * B}, block_gf<imfreq>{1.0 * B + B * 1.0});
 }
 
+TEST(Block, ParallelPolicy) {
+  triqs::clef::placeholder<0> w_;
+
+  // Blocks on different meshes, so that the tails are fitted block by block
+  std::vector<gf<imfreq>> G_vec;
+  for (int b : range(8)) {
+    auto G = gf<imfreq>({1.0 + b, Fermion, 200}, {2, 2});
+    G(w_) << 1 / (w_ + 0.5 * b) + 0.1 / (w_ - b);
+    G_vec.push_back(G);
+  }
+  auto B = block_gf{G_vec};
+
+  auto run = [&](block_exec_policy p) {
+    auto old   = set_block_exec_policy(p);
+    auto B_inv = inverse(B);
+    auto B_tau = make_gf_from_fourier(B);
+    auto tails = fit_tail(B).first;
+    auto n     = total_density(B);
+    set_block_exec_policy(old);
+    return std::make_tuple(B_inv, B_tau, tails, n);
+  };
+
+  // The parallel policy gives the same results as the sequential one
+  auto [B_inv, B_tau, tails, n]         = run(block_exec_policy::sequential);
+  auto [B_inv_p, B_tau_p, tails_p, n_p] = run(block_exec_policy::parallel);
+  EXPECT_BLOCK_GF_NEAR(B_inv, B_inv_p, 1e-15);
+  EXPECT_BLOCK_GF_NEAR(B_tau, B_tau_p, 1e-15);
+  for (int b : range(8)) EXPECT_ARRAY_NEAR(tails[b], tails_p[b], 1e-15);
+  EXPECT_EQ(n, n_p);
+
+  // Lazy transforms and block2
+  auto B_tau_lazy = B_tau;
+  B_tau_lazy()    = fourier(B);
+  EXPECT_BLOCK_GF_NEAR(B_tau, B_tau_lazy, 1e-15);
+
+  auto B2   = make_block2_gf({"a", "b"}, {"c", "d", "e"}, {{G_vec[0], G_vec[1], G_vec[2]}, {G_vec[3], G_vec[4], G_vec[5]}});
+  auto g_00 = [](auto const &g) { return g.data()(0, 0, 0); };
+  auto v    = map_block_gf(g_00, B2, block_exec_policy::parallel);
+  for (int i : range(2))
+    for (int j : range(3)) EXPECT_EQ(v[i][j], g_00(B2(i, j)));
+
+  // The exception of the first failing block is rethrown
+  auto thrower = [](auto const &g) {
+    if (g.mesh().beta() > 3.5) TRIQS_RUNTIME_ERROR << "beta = " << g.mesh().beta();
+    return g.mesh().beta();
+  };
+  try {
+    map_block_gf(thrower, B, block_exec_policy::parallel);
+    FAIL();
+  } catch (triqs::runtime_error const &e) { EXPECT_NE(std::string{e.what()}.find("beta = 4"), std::string::npos); }
+}
+
 MAKE_MAIN;
@@ -173,4 +173,42 @@ TEST(FitTailMatsubara, Multivar) { // NOLINT
   EXPECT_ARRAY_NEAR(tail_exact, tail(range(5), range::all, range::all, 0, 0), 1e-6);
 }
 
+// ------------------------------------------------------------------------------
+
+TEST(FitTailMatsubara, Block) { // NOLINT
+
+  triqs::clef::placeholder<0> iw_;
+  double beta = 10;
+  int N       = 100;
+
+  auto iw_mesh = mesh::imfreq{beta, Fermion, N};
+
+  // Blocks with different target shapes and tails, on the same mesh
+  auto g1 = gf<imfreq>{iw_mesh, {1, 1}};
+  auto g2 = gf<imfreq>{iw_mesh, {2, 2}};
+  g1(iw_) << 1 / (iw_ - 0.5);
+  g2(iw_) << 1 / (iw_ + 0.3) + 2 / iw_ / iw_;
+  auto bg = make_block_gf({"a", "b"}, {g1, g2});
+
+  // The batched fit of the block Green function agrees with the fit of the individual blocks
+  auto km = std::vector{array<dcomplex, 3>{{{0.0}}}, array<dcomplex, 3>(1, 2, 2)};
+  km[1]() = 0.0;
+
+  auto [tail_vec, err] = fit_tail(bg, km);
+  auto [tail1, err1]   = fit_tail(g1, km[0]);
+  auto [tail2, err2]   = fit_tail(g2, km[1]);
+
+  EXPECT_ARRAY_NEAR(tail_vec[0], tail1, 1e-10);
+  EXPECT_ARRAY_NEAR(tail_vec[1], tail2, 1e-10);
+  EXPECT_NEAR(err, std::max(err1, err2), 1e-12);
+
+  // The fit solvers are shared between meshes with identical parameters
+  auto iw_mesh2 = mesh::imfreq{beta, Fermion, N};
+  auto g3       = gf<imfreq>{iw_mesh2, {1, 1}};
+  g3(iw_) << 1 / (iw_ - 0.5);
+  auto [tail3, err3] = fit_tail(g3, km[0]);
+  EXPECT_ARRAY_NEAR(tail3, tail1, 1e-12);
+  EXPECT_EQ(g3.mesh().get_tail_fitter().get_lss()[1], g1.mesh().get_tail_fitter().get_lss()[1]);
+}
+
 MAKE_MAIN;
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/gfs.hpp>
+
+using namespace triqs::gfs;
+using namespace nda;
+
+double beta = 20;
+
+// Delta = V S V^+ on the mesh, cf. fit_bath
+template <typename M> gf<M, matrix_valued> make_delta(M const &m, matrix<dcomplex> const &V, vector<double> const &eps) {
+  long n_orb = V.extent(0), n_bath = V.extent(1);
+  auto delta = gf<M, matrix_valued>{m, {n_orb, n_orb}};
+  for (auto x : m) {
+    auto S = matrix<dcomplex>::zeros(n_bath, n_bath);
+    for (long j = 0; j < n_bath; ++j) {
+      if constexpr (std::is_same_v<M, imfreq>)
+        S(j, j) = 1 / (dcomplex(x) - eps(j));
+      else
+        S(j, j) = -std::exp(-double(x) * eps(j)) / (1 + std::exp(-beta * eps(j)));
+    }
+    delta[x] = V * S * dagger(V);
+  }
+  return delta;
+}
+
+auto V_ref   = matrix<dcomplex>{{0.5, 0.2, 0.0}, {0.1, 0.0, 0.4}};
+auto eps_ref = vector<double>{-1.0, 0.3, 0.8};
+
+// ----------------------------------------------------------------
+
+TEST(BathFit, ImFreq) {
+  auto delta = make_delta(imfreq{beta, Fermion, 100}, V_ref, eps_ref);
+  auto V0    = matrix<dcomplex>{{0.3, 0.3, 0.1}, {0.1, 0.1, 0.3}};
+  auto eps0  = vector<double>{-1.5, 0.0, 1.5};
+
+  auto res = fit_bath(delta, V0, eps0, {.tol = 1e-14});
+  EXPECT_TRUE(res.converged);
+  EXPECT_LT(res.norm, 1e-8);
+  EXPECT_ARRAY_NEAR(res.eps, eps_ref, 1e-6);
+  EXPECT_GF_NEAR(make_delta(delta.mesh(), res.V, res.eps), delta, 1e-8);
+}
+
+// ----------------------------------------------------------------
+
+TEST(BathFit, ImTimeComplex) {
+  auto V_c   = matrix<dcomplex>{{0.5, 0.2i, 0.0}, {0.1i, 0.0, 0.4}};
+  auto delta = make_delta(imtime{beta, Fermion, 401}, V_c, eps_ref);
+  auto V0    = matrix<dcomplex>{{0.3, 0.3, 0.1}, {0.1, 0.1, 0.3}};
+  auto eps0  = vector<double>{-1.5, 0.0, 1.5};
+
+  // Real hoppings cannot fit complex ones
+  auto res_real = fit_bath(delta, V0, eps0, {.tol = 1e-14});
+  EXPECT_GT(res_real.norm, 1e-4);
+
+  auto res = fit_bath(delta, V0, eps0, {.complex_hoppings = true, .tol = 1e-14});
+  EXPECT_LT(res.norm, 1e-8);
+  EXPECT_ARRAY_NEAR(res.eps, eps_ref, 1e-5);
+  EXPECT_GF_NEAR(make_delta(delta.mesh(), res.V, res.eps), delta, 1e-8);
+}
+
+// ----------------------------------------------------------------
+
+TEST(BathFit, BoundsAndStarts) {
+  auto delta = make_delta(imfreq{beta, Fermion, 100}, V_ref, eps_ref);
+  auto V0    = matrix<dcomplex>{{0.3, 0.3, 0.1}, {0.1, 0.1, 0.3}};
+  auto eps0  = vector<double>{-1.5, 0.0, 1.5};
+
+  // The bounds on the energies are enforced
+  auto res_bounded = fit_bath(delta, V0, eps0, {.eps_min = -0.5, .eps_max = 0.5});
+  EXPECT_GE(min_element(res_bounded.eps), -0.5);
+  EXPECT_LE(max_element(res_bounded.eps), 0.5);
+
+  // Several starts do no worse than the first one, and are deterministic
+  auto p     = bath_fit_params{.max_iter = 20, .n_starts = 8, .seed = 7};
+  auto res_a = fit_bath(delta, V0, eps0, p);
+  auto res_b = fit_bath(delta, V0, eps0, p);
+  EXPECT_LE(res_a.norm, fit_bath(delta, V0, eps0, {.max_iter = 20}).norm);
+  EXPECT_EQ(res_a.norm, res_b.norm);
+  EXPECT_ARRAY_EQ(res_a.eps, res_b.eps);
+
+  EXPECT_THROW(fit_bath(delta, matrix<dcomplex>(3, 3), eps0), triqs::runtime_error);
+}
+
+// ----------------------------------------------------------------
+
+TEST(BathFit, Block) {
+  auto m      = imtime{beta, Fermion, 201};
+  auto V2     = matrix<dcomplex>{{0.3, -0.6, 0.2}, {0.0, 0.2, 0.5}};
+  auto eps2   = vector<double>{-0.7, 0.1, 1.2};
+  auto delta  = block_gf{std::vector{make_delta(m, V_ref, eps_ref), make_delta(m, V2, eps2)}};
+  auto V0     = matrix<dcomplex>{{0.3, 0.3, 0.1}, {0.1, 0.1, 0.3}};
+  auto eps0   = vector<double>{-1.5, 0.0, 1.5};
+  auto res    = fit_bath(delta, std::vector{V0, V0}, std::vector{eps0, eps0}, {.tol = 1e-14});
+  auto single = fit_bath(delta[1], V0, eps0, {.tol = 1e-14});
+
+  ASSERT_EQ(res.size(), 2);
+  EXPECT_ARRAY_NEAR(res[0].eps, eps_ref, 1e-5);
+  EXPECT_ARRAY_NEAR(res[1].eps, eps2, 1e-5);
+
+  // Same result as the fit of the block alone
+  EXPECT_EQ(res[1].norm, single.norm);
+  EXPECT_ARRAY_EQ(res[1].V, single.V);
+
+  // The parallel policy gives the same result, and rethrows the error of a block unchanged
+  auto old_policy = set_block_exec_policy(block_exec_policy::parallel);
+  auto res_par    = fit_bath(delta, std::vector{V0, V0}, std::vector{eps0, eps0}, {.tol = 1e-14});
+  EXPECT_EQ(res_par[1].norm, res[1].norm);
+  EXPECT_ARRAY_EQ(res_par[1].V, res[1].V);
+  EXPECT_THROW(fit_bath(delta, std::vector{V0, matrix<dcomplex>(3, 3)}, std::vector{eps0, eps0}), triqs::runtime_error);
+  set_block_exec_policy(old_policy);
+}
+
+MAKE_MAIN;
@@ -18,6 +18,7 @@
 // Authors: Philipp Dumitrescu, Alexander Hampel, Hugo U. R. Strand, Nils Wentzell
 
 #include <triqs/test_tools/gfs.hpp>
+#include <nda/linalg/eigenelements.hpp>
 
 TEST(Gf, DensityFermion) {
 
@@ -90,4 +91,60 @@ TEST(Gf, DensityFermionReFreq) {
   EXPECT_COMPLEX_NEAR(trace(n), 2.0 + 0.0i, 1.e-3);
 }
 
+TEST(Gf, DensityFermionReFreqBeta) {
+
+  int N       = 20000;
+  double beta = 10;
+  auto h      = matrix<dcomplex>{{{-2 + 0i, 1i}, {-1i, -3.5 + 0i}}};
+  auto G      = gf<refreq>{{-10.0, 3.0, N}, {2, 2}};
+  for (auto w : G.mesh()) G[w] = inverse(w - h + 1e-3i);
+
+  // Compare against the direct sum over the mesh
+  auto res = nda::matrix<dcomplex>::zeros(2, 2);
+  for (auto w : G.mesh()) res += G[w] / (1. + exp(beta * w));
+  diagonal(res) = 1i * imag(diagonal(res));
+  res *= 1i * G.mesh().delta() / M_PI;
+  auto n_ref = nda::matrix<dcomplex>{0.5 * (res + dagger(res))};
+
+  auto n = triqs::gfs::density(G, beta);
+  EXPECT_ARRAY_NEAR(n, n_ref, 1e-12);
+
+  // The weights are cached per mesh and beta
+  EXPECT_ARRAY_NEAR(triqs::gfs::density(G, beta), n, 1e-14);
+  EXPECT_COMPLEX_NEAR(total_density(make_block_gf({G, G}), beta), 2. * trace(n), 1e-12);
+}
+
+TEST(Gf, TotalDensityBlock) {
+
+  double beta = 2;
+  auto h1     = matrix<dcomplex>{{{0.5 + 0i, 0.2i}, {-0.2i, -1.0 + 0i}}};
+  auto h2     = matrix<dcomplex>{{{0.3}}};
+  auto g1     = gf<imfreq>{{beta, Fermion, 500}, {2, 2}};
+  auto g2     = gf<imfreq>{{beta, Fermion, 500}, {1, 1}};
+  for (auto w : g1.mesh()) g1[w] = inverse(w - h1);
+  for (auto w : g2.mesh()) g2[w] = inverse(w - h2);
+  auto G = make_block_gf({"up", "dn"}, {g1, g2});
+
+  // Exact density sum_i f(e_i) of the non-interacting blocks
+  auto n_exact = [beta](matrix<dcomplex> const &h) {
+    double n = 0;
+    for (auto e : nda::linalg::eigenelements(h).first) n += 1 / (1 + std::exp(beta * e));
+    return n;
+  };
+
+  auto n = total_density(G);
+  EXPECT_COMPLEX_NEAR(n, trace(density(g1)) + trace(density(g2)), 1e-12);
+  EXPECT_COMPLEX_NEAR(n, n_exact(h1) + n_exact(h2), 1e-6);
+
+  // With known moments no fit is required
+  auto km1 = make_zero_tail(g1, 4), km2 = make_zero_tail(g2, 4);
+  km1(1, range::all, range::all) = nda::eye<dcomplex>(2);
+  km1(2, range::all, range::all) = h1;
+  km1(3, range::all, range::all) = h1 * h1;
+  km2(1, range::all, range::all) = nda::eye<dcomplex>(1);
+  km2(2, range::all, range::all) = h2;
+  km2(3, range::all, range::all) = h2 * h2;
+  EXPECT_COMPLEX_NEAR(total_density(G, {km1, km2}), n_exact(h1) + n_exact(h2), 1e-6);
+}
+
 MAKE_MAIN;
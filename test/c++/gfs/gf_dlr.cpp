@@ -512,6 +512,94 @@ TEST(Gf, DLR_h5) {
   rw_h5(Bgiwn, "bg_dlr_imfreq");
 }
 
+// ----------------------------------------------------------------
+
+TEST(Gf, DLR_dyson) {
+  double beta = 10.0, w_max = 10.0, eps = 1e-12;
+  double e0 = 0.3, e1 = -0.7, v = 0.5;
+
+  auto mat   = nda::matrix<dcomplex>{{e0, 0.1}, {0.1, -e0}};
+  auto g0    = gf<dlr_imfreq, matrix_valued>{{beta, Fermion, w_max, eps}, {2, 2}};
+  auto sigma = g0;
+  for (auto w : g0.mesh()) {
+    g0[w]    = inverse(nda::matrix<dcomplex>{dcomplex(w) - mat});
+    sigma[w] = v * v / (dcomplex(w) - e1);
+  }
+
+  auto g = dlr_dyson_g(g0, sigma);
+  for (auto w : g.mesh()) EXPECT_ARRAY_NEAR(g[w], inverse(nda::matrix<dcomplex>{dcomplex(w) - mat - v * v / (dcomplex(w) - e1)}), 1e-12);
+  EXPECT_GF_NEAR(dlr_dyson_sigma(g0, g), sigma, 1e-10);
+
+  // Block version
+  auto bg0 = block_gf{std::vector{g0, g0}};
+  auto bs  = block_gf{std::vector{sigma, sigma}};
+  auto bg  = dlr_dyson_g(bg0, bs);
+  EXPECT_GF_NEAR(bg[1], g, 1e-14);
+  EXPECT_GF_NEAR(dlr_dyson_sigma(bg0, bg)[0], sigma, 1e-10);
+}
+
+// ----------------------------------------------------------------
+
+TEST(Gf, DLR_convolution) {
+  double beta = 5.0, w_max = 10.0, eps = 1e-12;
+  double e0 = 0.8, e1 = -0.4;
+
+  auto g0_t = gf<dlr_imtime, matrix_valued>{{beta, Fermion, w_max, eps}, {1, 1}};
+  auto g1_t = g0_t;
+  for (auto tau : g0_t.mesh()) {
+    g0_t[tau] = onefermion(tau, e0, beta);
+    g1_t[tau] = onefermion(tau, e1, beta);
+  }
+  auto g0_c = make_gf_dlr(g0_t), g1_c = make_gf_dlr(g1_t);
+
+  // The convolution is a product in Matsubara frequencies
+  auto conv = dlr_convolution{g0_c.mesh()};
+  auto h_t  = conv(g0_c, g1_c);
+  auto h_w  = make_gf_dlr_imfreq(make_gf_dlr(h_t));
+  auto g0_w = make_gf_dlr_imfreq(g0_c), g1_w = make_gf_dlr_imfreq(g1_c);
+  for (auto w : h_w.mesh()) EXPECT_ARRAY_NEAR(h_w[w], g0_w[w] * g1_w[w], 1e-9);
+
+  // Same result from the convolution matrix, and from the cached operator of the free function
+  auto C = conv.matrix(g0_c);
+  auto h = nda::vector<dcomplex>{C * nda::vector<dcomplex>{g1_t.data()(range::all, 0, 0)}};
+  EXPECT_ARRAY_NEAR(h, h_t.data()(range::all, 0, 0), 1e-12);
+  EXPECT_GF_NEAR(dlr_convolve(g0_c, g1_c), h_t, 1e-14);
+}
+
+// ----------------------------------------------------------------
+
+TEST(Gf, DLR_ops_cache) {
+  double beta  = 3.0;
+  double w_max = 7.0;
+  double eps   = 1e-8;
+
+  // The three meshes share one set of operations
+  dlr_ops_cache_clear();
+  auto m_it = dlr_imtime{beta, Fermion, w_max, eps};
+  auto m_if = dlr_imfreq{beta, Fermion, w_max, eps};
+  auto m_c  = dlr{beta, Fermion, w_max, eps};
+  auto info = dlr_ops_cache_info();
+  EXPECT_EQ(info.misses, 1);
+  EXPECT_EQ(info.hits, 2);
+  EXPECT_EQ(info.size, 1);
+  EXPECT_EQ(&m_it.dlr_if(), &m_c.dlr_if());
+
+  // Same Lambda = w_max * beta, other statistic
+  auto m_b = dlr_imfreq{2 * beta, Boson, w_max / 2, eps};
+  EXPECT_EQ(dlr_ops_cache_info().size, 2);
+  EXPECT_NE(&m_b.dlr_if(), &m_if.dlr_if());
+
+  // Reading from file reuses the cached operations
+  auto m_r = rw_h5(m_if, "dlr_ops_cache");
+  EXPECT_EQ(m_r, m_if);
+  EXPECT_EQ(&m_r.dlr_if(), &m_if.dlr_if());
+
+  // The meshes keep their operations when the cache is cleared
+  dlr_ops_cache_clear();
+  EXPECT_EQ(dlr_ops_cache_info().size, 0);
+  EXPECT_EQ(m_it.size(), m_c.size());
+}
+
 // ----------------------------------------------------------------
 // Partial test with a more complex function. ?
 TEST(Gf, DLR_two_poles) {
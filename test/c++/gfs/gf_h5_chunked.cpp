@@ -0,0 +1,104 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/gfs.hpp>
+
+using namespace triqs::gfs;
+using namespace triqs::lattice;
+using triqs::utility::h5_chunk_params;
+using triqs::utility::h5_filter;
+using nda::range;
+
+// G(k, iw) with distinct values
+auto make_g_k_iw() {
+  auto bz = brillouin_zone{bravais_lattice{nda::eye<double>(2)}};
+  auto g  = gf<prod<brzone, imfreq>, matrix_valued>{{{bz, 6}, {10.0, Fermion, 8}}, {2, 2}};
+  auto *p = g.data().data();
+  for (long i = 0; i < g.data().size(); ++i) p[i] = dcomplex(i, -0.5 * i);
+  return g;
+}
+
+// ----------------------------------------------------------------
+
+TEST(h5_chunked, gf_round_trip) {
+  auto g = make_g_k_iw();
+  {
+    h5::file file("gf_h5_chunked.h5", 'w');
+    h5_write_chunked(file, "g_default", g);
+    h5_write_chunked(file, "g_k", g, {.chunk_shape = {1}, .level = 9});
+    h5_write_chunked(file, "g_none", g, {.chunk_shape = {4, 3}, .filter = h5_filter::none});
+  }
+
+  // Read back by the standard h5_read
+  h5::file file("gf_h5_chunked.h5", 'r');
+  for (auto name : {"g_default", "g_k", "g_none"}) {
+    auto g2 = gf<prod<brzone, imfreq>, matrix_valued>{};
+    h5_read(file, name, g2);
+    EXPECT_GF_NEAR(g, g2, 1e-15);
+  }
+
+  EXPECT_THROW(h5_write_chunked(h5::file("gf_h5_chunked_err.h5", 'w'), "g", g, {.chunk_shape = {1, 1, 1}}), triqs::runtime_error);
+}
+
+// ----------------------------------------------------------------
+
+TEST(h5_chunked, gf_mesh_slice) {
+  auto g = make_g_k_iw();
+  {
+    h5::file file("gf_h5_chunked_slice.h5", 'w');
+    h5_write_chunked(file, "g", g, {.chunk_shape = {1}});
+  }
+
+  // Only the momenta 5 to 10 and the 4 lowest positive frequencies are read
+  h5::file file("gf_h5_chunked_slice.h5", 'r');
+  auto g2    = g;
+  g2.data()  = 0;
+  auto slice = std::array{range(5, 11), range(8, 12)};
+  h5_read_mesh_slice(file, "g", g2, slice);
+  EXPECT_ARRAY_NEAR(g2.data()(slice[0], slice[1], range::all, range::all), g.data()(slice[0], slice[1], range::all, range::all), 1e-15);
+  EXPECT_ARRAY_NEAR(g2.data()(range(0, 5), range::all, range::all, range::all), nda::zeros<dcomplex>(5, 16, 2, 2), 1e-15);
+  EXPECT_ARRAY_NEAR(g2.data()(slice[0], range(0, 8), range::all, range::all), nda::zeros<dcomplex>(6, 8, 2, 2), 1e-15);
+
+  // The slice must be within the mesh, and the mesh must be the stored one
+  EXPECT_THROW(h5_read_mesh_slice(file, "g", g2, {range(30, 40), range(0, 16)}), triqs::runtime_error);
+  auto g3 = gf<prod<brzone, imfreq>, matrix_valued>{{std::get<0>(g.mesh()), {10.0, Fermion, 4}}, {2, 2}};
+  EXPECT_THROW(h5_read_mesh_slice(file, "g", g3, {range(0, 1), range(0, 1)}), triqs::runtime_error);
+}
+
+// ----------------------------------------------------------------
+
+TEST(h5_chunked, array_box) {
+  auto a = nda::array<double, 3>(4, 5, 6);
+  for (long i = 0; i < a.size(); ++i) a.data()[i] = 0.5 * i;
+  {
+    h5::file file("array_h5_chunked.h5", 'w');
+    h5_write_chunked(file, "a", a, {.chunk_shape = {1, 2}});
+  }
+
+  // Into a contiguous array, read directly, and into a strided view, read through a temporary
+  h5::file file("array_h5_chunked.h5", 'r');
+  auto b = nda::array<double, 3>(2, 5, 3);
+  triqs::utility::h5_read_box(file, "a", b, {1, 0, 2});
+  EXPECT_ARRAY_EQ(b, a(range(1, 3), range::all, range(2, 5)));
+
+  auto c = nda::zeros<double>(2, 5, 6);
+  triqs::utility::h5_read_box(file, "a", c(range::all, range::all, range(0, 6, 2)), {2, 0, 3});
+  EXPECT_ARRAY_EQ(c(range::all, range::all, range(0, 6, 2)), a(range(2, 4), range::all, range(3, 6)));
+  EXPECT_ARRAY_EQ(c(range::all, range::all, range(1, 6, 2)), nda::zeros<double>(2, 5, 3));
+}
+
+MAKE_MAIN;
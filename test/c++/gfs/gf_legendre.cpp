@@ -69,4 +69,39 @@ TEST(GfLegendre, Mesh) {
   }
 }
 
+TEST(GfLegendre, Transform) {
+
+  double const beta = 2.0;
+  auto const n_l    = 12;
+
+  auto gl = gf<legendre, matrix_valued>{{beta, Fermion, n_l}, {2, 2}};
+  for (auto l : gl.mesh()) gl[l] = nda::matrix<dcomplex>{{1.0 / (1 + l.index()), 0.5i}, {-0.5i, 2.0 / (2 + l.index())}};
+
+  // Matsubara frequencies, compared to the explicit sum over T_{nl}
+  auto gw = gf<imfreq, matrix_valued>{{beta, Fermion, 20}, {2, 2}};
+  gw()    = legendre_to_imfreq(gl);
+
+  auto gw_ref = gw;
+  gw_ref()    = 0.0;
+  for (auto om : gw_ref.mesh())
+    for (auto l : gl.mesh()) gw_ref[om] += triqs::utility::legendre_T(om.index(), l.index()) * gl[l];
+  EXPECT_GF_NEAR(gw, gw_ref, 1e-12);
+
+  // The cached matrix is shared between identical meshes
+  EXPECT_EQ(legendre_T_matrix(-20, 40, n_l), legendre_T_matrix(-20, 40, n_l));
+
+  // Imaginary time, compared to the explicit sum over P_l(x)
+  auto gt = gf<imtime, matrix_valued>{{beta, Fermion, 51}, {2, 2}};
+  gt()    = legendre_to_imtime(gl);
+
+  auto gt_ref = gt;
+  gt_ref()    = 0.0;
+  triqs::utility::legendre_generator L;
+  for (auto t : gt_ref.mesh()) {
+    L.reset(2 * t / beta - 1);
+    for (auto l : gl.mesh()) gt_ref[t] += std::sqrt(2 * l.index() + 1) / beta * gl[l] * L.next();
+  }
+  EXPECT_GF_NEAR(gt, gt_ref, 1e-12);
+}
+
 MAKE_MAIN;
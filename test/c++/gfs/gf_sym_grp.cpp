@@ -294,4 +294,55 @@ TEST(GfSymGrp, MomentumFrequencyOmp) {
   EXPECT_GF_NEAR(G, Gp);
 }
 
+TEST(GfSymGrp, ClassTable) {
+  // some dummy gf
+  mesh::imfreq m{1, Fermion, 10};
+  auto G               = gf<prod<imfreq, imfreq>, matrix_valued>{m * m, {3, 3}};
+  using mesh_index_t   = decltype(G)::mesh_t::index_t;
+  using target_index_t = std::array<long, 2>;
+  using sym_t          = std::tuple<mesh_index_t, target_index_t, nda::operation>;
+  using sym_func_t     = std::function<sym_t(mesh_index_t const &, target_index_t const &)>;
+
+  // some dummy symmetries, with complex conjugation and sign flips
+  auto s1 = [](mesh_index_t const &x, target_index_t const &y) {
+    auto [n_w1, n_w2] = x;
+    return sym_t{std::tuple{-n_w1 - 1, -n_w2 - 1}, y, {false, true}};
+  };
+
+  auto s2 = [](mesh_index_t const &x, target_index_t const &y) {
+    auto [y1, y2] = y;
+    return sym_t{x, std::array{y2, y1}, {true, false}};
+  };
+
+  // the parallel construction yields the same classes as the serial one
+  std::vector<sym_func_t> sym_list = {s1, s2};
+  auto grp                         = triqs::gfs::sym_grp{G, sym_list};
+  auto grp_omp                     = triqs::gfs::sym_grp{G, sym_list, 0, true};
+
+  EXPECT_EQ(grp.num_classes(), 1200);
+  EXPECT_EQ(grp_omp.num_classes(), grp.num_classes());
+  EXPECT_ARRAY_EQ(grp_omp.get_sym_class_table().class_ptr, grp.get_sym_class_table().class_ptr);
+  EXPECT_ARRAY_EQ(grp_omp.get_sym_class_table().members, grp.get_sym_class_table().members);
+  EXPECT_ARRAY_EQ(grp_omp.get_sym_class_table().ops, grp.get_sym_class_table().ops);
+
+  // rebuild the symmetry group from the class table stored in hdf5
+  auto table  = rw_h5(grp.get_sym_class_table(), "sym_class_table");
+  auto grp_h5 = triqs::gfs::sym_grp<sym_func_t, decltype(G)>{G, table};
+  EXPECT_EQ(grp_h5.num_classes(), grp.num_classes());
+
+  for (auto &x : G.data()) x = std::complex{nda::rand(), nda::rand()};
+  auto Gp = G;
+  grp.symmetrize(G);
+  grp_h5.symmetrize(Gp);
+  EXPECT_GF_NEAR(G, Gp);
+
+  // symmetrized data is invariant under the symmetries
+  for (auto [w1, w2] : G.mesh())
+    for (auto [a, b] : std::array{std::pair{0, 1}, std::pair{1, 2}}) EXPECT_COMPLEX_NEAR(G[w1, w2](a, b), -G[w1, w2](b, a), 1e-14);
+
+  // the table can not be used for another mesh
+  auto G2 = gf<prod<imfreq, imfreq>, matrix_valued>{m * mesh::imfreq{1, Fermion, 5}, {3, 3}};
+  EXPECT_THROW((triqs::gfs::sym_grp<sym_func_t, decltype(G)>{G2, table}), triqs::runtime_error);
+}
+
 MAKE_MAIN;
@@ -139,6 +139,40 @@ TEST_F(MpiGf, ReduceBlockView) {
 
 //----------------------------------------------
 
+TEST_F(MpiGf, ReduceBlock2) {
+  block2_gf<imfreq> bgf = make_block2_gf({"up", "dn"}, {"a", "b", "c"}, {{g1, g1, g1}, {g1, g1, g1}});
+
+  block2_gf<imfreq> bgf2 = mpi::all_reduce(bgf, world);
+  EXPECT_EQ(bgf2.block_names(), bgf.block_names());
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j) test_gfs_are_close(bgf2(i, j), gf<imfreq>{world.size() * g1});
+}
+
+//----------------------------------------------
+
+TEST_F(MpiGf, ReduceBlockInPlace) {
+  block_gf<imfreq> bgf = make_block_gf({g1, g1, g1});
+
+  mpi::all_reduce_in_place(bgf, world);
+  for (int i = 0; i < 3; ++i) test_gfs_are_close(bgf[i], gf<imfreq>{world.size() * g1});
+
+  auto bgf2 = make_block_gf({g1, g1, g1});
+  mpi::all_reduce_in_place(bgf2(), world);
+  for (int i = 0; i < 3; ++i) test_gfs_are_close(bgf2[i], gf<imfreq>{world.size() * g1});
+}
+
+//----------------------------------------------
+
+TEST_F(MpiGf, BroadcastBlock) {
+  block_gf<imfreq> bgf = make_block_gf({g1, g1, g1});
+  for (int i = 0; i < 3; ++i) bgf[i].data() *= (world.rank() + 1) * (i + 1);
+
+  mpi::broadcast(bgf, world, 0);
+  for (int i = 0; i < 3; ++i) test_gfs_are_close(bgf[i], gf<imfreq>{(i + 1) * g1});
+}
+
+//----------------------------------------------
+
 //TEST_F(MpiGf, final) {
 //auto g10 = gf<imfreq>{{beta, Fermion, Nfreq}, {1, 1}};
 //g10(w_) << 1 / (w_ + 1);
@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/gfs.hpp>
+
+using namespace triqs::lattice;
+
+int n_k     = 8;
+int n_iw    = 200;
+int n_iW    = 4;
+double beta = 5;
+
+auto bz    = brillouin_zone{bravais_lattice{nda::eye<double>(2)}};
+auto eps_k = [](auto const &k) { return -2 * (cos(k[0]) + cos(k[1])); };
+auto fermi = [](double e) { return 1 / (1 + std::exp(beta * e)); };
+
+auto make_g_wk() {
+  auto g = gf<prod<imfreq, brzone>, matrix_valued>{{{beta, Fermion, n_iw}, {bz, n_k}}, {1, 1}};
+  for (auto [iw, k] : g.mesh()) g[iw, k] = 1 / (iw - eps_k(k));
+  return g;
+}
+
+// The mesh point s1 * k1 + s2 * k2
+auto combine(brzone const &m, brzone::mesh_point_t const &k1, int s1, brzone::mesh_point_t const &k2, int s2) {
+  auto idx = std::array<long, 3>{};
+  for (int d = 0; d < 3; ++d) idx[d] = s1 * k1.index()[d] + s2 * k2.index()[d];
+  return m[m.to_data_index(m.index_modulo(idx))];
+}
+
+// ------------------------------------------------------------
+
+TEST(Bubble, PH) {
+  auto g_wk   = make_g_wk();
+  auto chi    = make_bubble(g_wk, bubble_channel::PH, n_iW);
+  auto k_mesh = std::get<1>(g_wk.mesh());
+
+  // Lindhard function -1/N_k sum_k (f(e_k) - f(e_k+q)) / (iW + e_k - e_k+q) for iW != 0
+  for (auto [iW, q] : chi.mesh()) {
+    if (iW.index() == 0) continue;
+    dcomplex res = 0;
+    for (auto k : k_mesh) {
+      double e1 = eps_k(k), e2 = eps_k(combine(k_mesh, k, 1, q, 1));
+      res -= (fermi(e1) - fermi(e2)) / (iW + e1 - e2);
+    }
+    EXPECT_COMPLEX_NEAR(chi[iW, q](0, 0, 0, 0), res / double(k_mesh.size()), 1e-3);
+  }
+}
+
+// ------------------------------------------------------------
+
+TEST(Bubble, PP) {
+  auto g_wk   = make_g_wk();
+  auto chi    = make_bubble(g_wk, bubble_channel::PP, n_iW);
+  auto k_mesh = std::get<1>(g_wk.mesh());
+
+  // 1/N_k sum_k (1 - f(e_k) - f(e_q-k)) / (e_k + e_q-k - iW) for iW != 0
+  for (auto [iW, q] : chi.mesh()) {
+    if (iW.index() == 0) continue;
+    dcomplex res = 0;
+    for (auto k : k_mesh) {
+      double e1 = eps_k(k), e2 = eps_k(combine(k_mesh, q, 1, k, -1));
+      res += (1 - fermi(e1) - fermi(e2)) / (e1 + e2 - iW);
+    }
+    EXPECT_COMPLEX_NEAR(chi[iW, q](0, 0, 0, 0), res / double(k_mesh.size()), 1e-3);
+  }
+}
+
+// ------------------------------------------------------------
+
+TEST(Bubble, RealSpace) {
+  // Compare the product in (tau, r) against the explicit expression for a two-orbital Green function
+  auto g_tr = gf<prod<imtime, cyclat>, matrix_valued>{{{beta, Fermion, 11}, {bravais_lattice{nda::eye<double>(2)}, 3}}, {2, 2}};
+  for (auto [t, r] : g_tr.mesh())
+    for (int a = 0; a < 2; ++a)
+      for (int b = 0; b < 2; ++b) g_tr[t, r](a, b) = dcomplex(t.index() + 0.5 * a, r.data_index() - b);
+
+  auto chi_ph = make_bubble(g_tr, bubble_channel::PH);
+  auto chi_pp = make_bubble(g_tr, bubble_channel::PP);
+
+  auto const &r_mesh = std::get<1>(g_tr.mesh());
+  auto g             = g_tr.data();
+  long n_tau         = g.extent(0);
+  for (auto r : r_mesh) {
+    auto idx = r.index();
+    long ir  = r.data_index(), mr = r_mesh.to_data_index(r_mesh.index_modulo({-idx[0], -idx[1], -idx[2]}));
+    for (long t = 0; t < n_tau; ++t)
+      for (int a = 0; a < 2; ++a)
+        for (int b = 0; b < 2; ++b)
+          for (int c = 0; c < 2; ++c)
+            for (int d = 0; d < 2; ++d) {
+              EXPECT_COMPLEX_NEAR(chi_ph.data()(t, ir, a, b, c, d), g(n_tau - 1 - t, mr, d, a) * g(t, ir, b, c), 1e-12);
+              EXPECT_COMPLEX_NEAR(chi_pp.data()(t, ir, a, b, c, d), g(t, ir, a, c) * g(t, ir, b, d), 1e-12);
+            }
+  }
+}
+
+MAKE_MAIN;
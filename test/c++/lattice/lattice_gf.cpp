@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/gfs.hpp>
+#include <triqs/lattice/lattice_gf.hpp>
+#include <nda/linalg/eigenelements.hpp>
+#include <itertools/itertools.hpp>
+
+using namespace triqs::gfs;
+using namespace triqs::lattice;
+
+double beta = 10, mu = 0.3;
+
+// Two hybridized orbitals on the square lattice
+tight_binding make_tb() {
+  auto units           = nda::matrix<double>{{1., 0.}, {0., 1.}};
+  auto bl              = bravais_lattice(units, std::vector(2, nda::vector<double>{0., 0.}));
+  auto displ_vec       = std::vector<nda::vector<long>>{{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  auto hop             = nda::matrix<dcomplex>{{-1.0, 0.2i}, {-0.2i, -0.5}};
+  auto overlap_mat_vec = std::vector<nda::matrix<dcomplex>>{{{0.3, 0.1}, {0.1, -0.3}}, hop, dagger(hop), hop, dagger(hop)};
+  return {bl, displ_vec, overlap_mat_vec};
+}
+
+// A causal self-energy with a constant part
+gf<imfreq, matrix_valued> make_sigma(long n_iw) {
+  auto sigma = gf<imfreq, matrix_valued>{{beta, Fermion, n_iw}, {2, 2}};
+  auto s0    = nda::matrix<dcomplex>{{0.5, 0.1}, {0.1, -0.2}};
+  auto v     = nda::matrix<dcomplex>{{0.6, 0.0}, {0.3, 0.4}};
+  for (auto w : sigma.mesh()) sigma[w] = s0 + v * dagger(v) / (dcomplex(w) - 0.4);
+  return sigma;
+}
+
+auto tb     = make_tb();
+auto k_mesh = brzone{brillouin_zone{tb.lattice()}, 8};
+
+// ----------------------------------------------------------------
+
+TEST(lattice_gf, full_and_local) {
+  auto sigma = make_sigma(64);
+  auto g     = make_lattice_gf(tb, k_mesh, mu, sigma);
+
+  auto h     = tb.fourier(k_mesh);
+  auto g_loc = gf<imfreq, matrix_valued>{sigma.mesh(), {2, 2}};
+  g_loc()    = 0;
+  for (auto k : k_mesh) {
+    for (auto w : sigma.mesh()) {
+      auto g_kw = nda::matrix<dcomplex>{inverse((dcomplex(w) + mu) * nda::eye<dcomplex>(2) - h[k] - sigma[w])};
+      EXPECT_ARRAY_NEAR(g[k, w], g_kw, 1e-12);
+      g_loc[w] += g_kw / double(k_mesh.size());
+    }
+  }
+
+  EXPECT_GF_NEAR(make_lattice_gf_local(tb, k_mesh, mu, sigma), g_loc, 1e-12);
+}
+
+// ----------------------------------------------------------------
+
+TEST(lattice_gf, real_space) {
+  auto sigma = make_sigma(32);
+  auto g     = make_lattice_gf(tb, k_mesh, mu, sigma);
+  auto R_vec = std::vector<nda::vector<long>>{{0, 0}, {1, 0}, {2, -3}};
+  auto g_R   = make_lattice_gf_real_space(tb, k_mesh, mu, sigma, R_vec);
+  ASSERT_EQ(g_R.size(), 3);
+
+  // Same as the Fourier transform from the brzone to the cyclat mesh
+  auto g_r           = make_gf_from_fourier<0>(g, make_adjoint_mesh(k_mesh));
+  auto const &r_mesh = std::get<0>(g_r.mesh());
+  for (auto [g_R_i, R] : itertools::zip(g_R, R_vec)) {
+    auto r = r_mesh[r_mesh.to_data_index(r_mesh.index_modulo({R(0), R(1), 0}))];
+    for (auto w : sigma.mesh()) EXPECT_ARRAY_NEAR(g_R_i[w], g_r[r, w], 1e-12);
+  }
+  EXPECT_GF_NEAR(g_R[0], make_lattice_gf_local(tb, k_mesh, mu, sigma), 1e-12);
+
+  auto R_3d = std::vector<nda::vector<long>>{{1, 0, 0}};
+  EXPECT_THROW(make_lattice_gf_real_space(tb, k_mesh, mu, sigma, R_3d), triqs::runtime_error);
+}
+
+// ----------------------------------------------------------------
+
+TEST(lattice_gf, density) {
+  // Free case: the Fermi function of h_k - mu
+  auto sigma_0 = make_sigma(16);
+  sigma_0()    = 0;
+  auto n_0     = lattice_density(tb, k_mesh, mu, sigma_0);
+  auto h       = tb.fourier(k_mesh);
+  for (auto k : k_mesh) {
+    auto h_k      = nda::matrix<dcomplex>{h[k] - mu * nda::eye<dcomplex>(2)};
+    auto [eps, U] = nda::linalg::eigenelements(h_k);
+    auto f        = nda::matrix<dcomplex>::zeros(2, 2);
+    for (int l = 0; l < 2; ++l) f(l, l) = 1 / (1 + std::exp(beta * eps(l)));
+    EXPECT_ARRAY_NEAR(n_0[k], U * f * dagger(U), 1e-10);
+  }
+
+  // Interacting case: the average over k is the density of the local Green function
+  auto sigma = make_sigma(1000);
+  auto n     = lattice_density(tb, k_mesh, mu, sigma);
+  auto n_loc = nda::matrix<dcomplex>::zeros(2, 2);
+  for (auto k : k_mesh) n_loc += n[k] / double(k_mesh.size());
+
+  auto known_moments = nda::array<dcomplex, 3>::zeros(2, 2, 2);
+  for (int a = 0; a < 2; ++a) known_moments(1, a, a) = 1;
+  EXPECT_ARRAY_NEAR(n_loc, density(make_lattice_gf_local(tb, k_mesh, mu, sigma), known_moments), 1e-4);
+
+  EXPECT_THROW(lattice_density(tb, k_mesh, mu, positive_freq_view(sigma)), triqs::runtime_error);
+}
+
+MAKE_MAIN;
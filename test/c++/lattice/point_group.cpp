@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/gfs.hpp>
+#include <triqs/lattice/tight_binding.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace triqs::gfs;
+using namespace triqs::lattice;
+
+// Two orbitals on the square lattice, at the corner and at the center of the cell
+tight_binding make_checkerboard() {
+  double e0 = 0.3, e1 = -0.2, t = -1.0, tp = -0.4;
+
+  auto units           = nda::matrix<double>{{1., 0.}, {0., 1.}};
+  auto bl              = bravais_lattice(units, std::vector<nda::vector<double>>{{0., 0.}, {0.5, 0.5}});
+  auto displ_vec       = std::vector<nda::vector<long>>{{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, -1}};
+  auto overlap_mat_vec = std::vector<nda::matrix<dcomplex>>{
+     {{e0, t}, {t, e1}}, {{tp, 0}, {t, tp}}, {{tp, t}, {0, tp}}, {{tp, 0}, {t, tp}}, {{tp, t}, {0, tp}}, {{0, 0}, {t, 0}}, {{0, t}, {0, 0}}};
+  return {bl, displ_vec, overlap_mat_vec};
+}
+
+// ----------------------------------------------------------------
+
+TEST(point_group, lattices) {
+  double s3 = std::sqrt(3.);
+  EXPECT_EQ(point_group(bravais_lattice{nda::eye<double>(3)}).size(), 48);
+  EXPECT_EQ(point_group(bravais_lattice{nda::matrix<double>{{0, 0.5, 0.5}, {0.5, 0, 0.5}, {0.5, 0.5, 0}}}).size(), 48);
+  EXPECT_EQ(point_group(bravais_lattice{nda::matrix<double>{{1, 0, 0}, {0.5, s3 / 2, 0}, {0, 0, 1.6}}}).size(), 24);
+  EXPECT_EQ(point_group(bravais_lattice{nda::matrix<double>{{1, 0}, {0.5, s3 / 2}}, {{0, 0}}}).size(), 12);
+  EXPECT_EQ(point_group(bravais_lattice{nda::matrix<double>{{1}}, {{0}}}).size(), 2);
+
+  // The orbitals reduce the group of the square lattice
+  auto square = nda::matrix<double>{{1, 0}, {0, 1}};
+  EXPECT_EQ(point_group(bravais_lattice{square, {{0, 0}}}).size(), 8);
+  EXPECT_EQ(point_group(bravais_lattice{square, {{0, 0}, {0.5, 0}}}).size(), 4);
+  EXPECT_EQ(point_group(bravais_lattice{square, {{0, 0}, {0.5, 0.5}}}).size(), 8);
+  EXPECT_EQ(point_group(bravais_lattice{square, {{0, 0}, {0.5, 0.5}}, {"A", "B"}}).size(), 8);
+  EXPECT_EQ(point_group(bravais_lattice{square, {{0, 0}, {0, 0}}, {"A", "B"}}).size(), 8);
+
+  // The identity comes first
+  auto ops = point_group(bravais_lattice{square, {{0, 0}, {0.5, 0.5}}});
+  EXPECT_ARRAY_EQ(ops[0].W, nda::eye<long>(2));
+  EXPECT_EQ(ops[0].perm, (std::vector<long>{0, 1}));
+}
+
+// ----------------------------------------------------------------
+
+TEST(point_group, irreducible_kgrid) {
+  auto k_mesh = brzone{brillouin_zone{bravais_lattice{nda::eye<double>(3)}}, 8};
+  auto grid   = irreducible_kgrid{k_mesh};
+  EXPECT_EQ(grid.ops().size(), 48);
+  EXPECT_EQ(grid.size(), 35);
+  EXPECT_NEAR(sum(grid.weights()), 1.0, 1e-14);
+
+  // The irreducible points are their own images by the identity
+  for (auto [i, k] : itertools::enumerate(grid.irr_points())) {
+    EXPECT_EQ(grid.irr_index()[k], i);
+    EXPECT_EQ(grid.op_index()[k], 0);
+  }
+
+  // A mesh with different extents breaks the symmetries which exchange the axes
+  auto grid_842 = irreducible_kgrid{brzone{k_mesh.bz(), std::array<long, 3>{8, 4, 2}}};
+  EXPECT_EQ(grid_842.ops().size(), 8);
+  EXPECT_NEAR(sum(grid_842.weights()), 1.0, 1e-14);
+}
+
+// ----------------------------------------------------------------
+
+TEST(point_group, tight_binding) {
+  auto tb     = make_checkerboard();
+  auto k_mesh = brzone{brillouin_zone{tb.lattice()}, 8};
+
+  // All operations of the square lattice, also combined with time reversal
+  auto ops = tb.symmetries();
+  EXPECT_EQ(ops.size(), 16);
+  auto grid = irreducible_kgrid{k_mesh, ops};
+  EXPECT_EQ(grid.size(), 15);
+
+  EXPECT_GF_NEAR(tb.dispersion(grid), tb.dispersion(k_mesh), 1e-12);
+
+  // The unfolded eigenvectors diagonalize h_k
+  auto [e_k, U_k] = tb.eigenelements(grid);
+  auto h          = tb.fourier(k_mesh);
+  for (auto k : k_mesh) {
+    auto U = nda::matrix<dcomplex>{U_k[k]};
+    EXPECT_ARRAY_NEAR(dagger(U) * U, nda::eye<dcomplex>(2), 1e-12);
+    EXPECT_ARRAY_NEAR(dagger(U) * h[k] * U, nda::diag(nda::vector<dcomplex>{e_k[k]}), 1e-12);
+  }
+
+  // Complex hoppings break time reversal
+  auto hop = nda::matrix<dcomplex>{{-1.0, 0.2i}, {-0.2i, -0.5}};
+  auto tb_c =
+     tight_binding{bravais_lattice{nda::matrix<double>{{1, 0}, {0, 1}}, {{0, 0}, {0, 0}}}, {{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}},
+                   {nda::matrix<dcomplex>{{0.3, 0.1}, {0.1, -0.3}}, hop, dagger(hop), hop, dagger(hop)}};
+  auto ops_c = tb_c.symmetries();
+  EXPECT_FALSE(ops_c.empty());
+  EXPECT_TRUE(std::none_of(ops_c.begin(), ops_c.end(), [](auto const &op) { return op.time_reversal; }));
+  EXPECT_GF_NEAR(tb_c.dispersion(irreducible_kgrid{k_mesh, ops_c}), tb_c.dispersion(k_mesh), 1e-12);
+
+  // The full point group of the lattice does not leave the complex hoppings invariant
+  auto grid_c = irreducible_kgrid{k_mesh};
+  EXPECT_THROW(tb_c.dispersion(grid_c), triqs::runtime_error);
+  EXPECT_THROW(tb_c.eigenelements(grid_c), triqs::runtime_error);
+}
+
+MAKE_MAIN;
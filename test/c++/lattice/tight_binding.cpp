@@ -22,6 +22,9 @@
 
 #include <triqs/lattice/tight_binding.hpp>
 
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <vector>
 
 using namespace triqs::gfs;
@@ -55,4 +58,99 @@ TEST(tight_binding, h5_read_write) {
   }
 }
 
+TEST(tight_binding, dos_tetrahedron_chain) {
+  // Nearest-neighbor chain with eps_k = 2 t cos(k) and integrated DOS N(E) = 1 - acos(E / 2t) / pi
+  auto units           = nda::matrix<double>{{1., 0., 0.}};
+  auto bl              = bravais_lattice(units, std::vector{nda::vector<double>{0., 0., 0.}});
+  auto displ_vec       = std::vector<nda::vector<long>>{{1}, {-1}};
+  double t             = 1.0;
+  auto overlap_mat_vec = std::vector(displ_vec.size(), nda::matrix<dcomplex>{{t}});
+  auto tb              = tight_binding{bl, displ_vec, overlap_mat_vec};
+
+  int neps        = 100;
+  auto [eps, rho] = dos_tetrahedron(tb, 1000, neps);
+  double deps     = eps(1) - eps(0);
+  auto N          = [t](double E) { return 1 - std::acos(std::clamp(E / (2 * t), -1., 1.)) / M_PI; };
+  EXPECT_NEAR(sum(rho) * deps, 1.0, 1e-12);
+  for (int i = 0; i < neps; ++i) {
+    if (std::abs(eps(i)) > 1.5 * t) continue;
+    EXPECT_NEAR(rho(i, 0), (N(eps(i) + deps / 2) - N(eps(i) - deps / 2)) / deps, 1e-4);
+  }
+}
+
+TEST(tight_binding, dos_tetrahedron_cubic) {
+  // Two hybridized orbitals on the simple cubic lattice
+  auto units           = nda::matrix<double>{{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+  auto bl              = bravais_lattice(units, std::vector(2, nda::vector<double>{0., 0., 0.}));
+  auto displ_vec       = std::vector<nda::vector<long>>{{0, 0, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+  auto hop             = nda::matrix<dcomplex>{{1.0, 0.2}, {0.2, 0.5}};
+  auto overlap_mat_vec = std::vector(displ_vec.size(), hop);
+  overlap_mat_vec[0]   = nda::matrix<dcomplex>{{0.3, 0.1}, {0.1, -0.3}};
+  auto tb              = tight_binding{bl, displ_vec, overlap_mat_vec};
+
+  for (bool bloechl_correction : {true, false}) {
+    auto [eps, rho] = dos_tetrahedron(tb, 16, 200, bloechl_correction);
+    double deps     = eps(1) - eps(0);
+
+    // Each orbital carries unit spectral weight
+    for (int o = 0; o < 2; ++o) EXPECT_NEAR(sum(rho(range::all, o)) * deps, 1.0, 1e-10);
+
+    // The first moment of the total DOS is the trace of h_k averaged over k, i.e. the on-site energies
+    double m1 = 0;
+    for (int i = 0; i < eps.size(); ++i) m1 += eps(i) * (rho(i, 0) + rho(i, 1)) * deps;
+    EXPECT_NEAR(m1, 0.0, 1e-2);
+  }
+}
+
+TEST(tight_binding, wannier90_hr) {
+  // Two Wannier functions, nearest-neighbor hoppings along x with a degeneracy of 2
+  {
+    std::ofstream f("test_w90_hr.dat");
+    f << " written on 01Jan2026\n           2\n           3\n    2    1    2\n";
+    for (int R : {-1, 0, 1})
+      for (int n = 1; n <= 2; ++n)
+        for (int m = 1; m <= 2; ++m) {
+          double re = (R == 0) ? (m == n ? 0.5 * m : 0.0) : (m == n ? -2.0 : 0.0);
+          double im = (R != 0) ? (m - n) * 0.2 : 0.0;
+          f << std::setw(5) << R << "    0    0" << std::setw(5) << m << std::setw(5) << n << std::setw(12) << re << std::setw(12) << im << "\n";
+        }
+  }
+
+  auto [displ_vec, overlap_mat_vec] = parse_wannier90_hr("test_w90_hr.dat");
+  ASSERT_EQ(displ_vec.size(), 3);
+  EXPECT_EQ(displ_vec[2], (nda::vector<long>{1, 0, 0}));
+  EXPECT_ARRAY_NEAR(overlap_mat_vec[1], (nda::matrix<dcomplex>{{0.5, 0}, {0, 1.0}}));
+  // divided by the degeneracy, with the element (n, m) from the line R m n
+  EXPECT_ARRAY_NEAR(overlap_mat_vec[2], (nda::matrix<dcomplex>{{-1.0, 0.1i}, {-0.1i, -1.0}}));
+
+  auto bl = bravais_lattice(nda::matrix<double>{{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}}, std::vector(2, nda::vector<double>{0., 0., 0.}));
+  auto tb = tight_binding(bl, displ_vec, overlap_mat_vec);
+  std::filesystem::remove("test_w90_hr.h5");
+  EXPECT_EQ(tight_binding_from_wannier90_hr(bl, "test_w90_hr.dat", "test_w90_hr.h5"), tb);
+  EXPECT_TRUE(std::filesystem::exists("test_w90_hr.h5"));
+  EXPECT_EQ(tight_binding_from_wannier90_hr(bl, "test_w90_hr.dat", "test_w90_hr.h5"), tb);
+
+  // A truncated file is an error
+  std::filesystem::resize_file("test_w90_hr.dat", std::filesystem::file_size("test_w90_hr.dat") - 40);
+  EXPECT_THROW(parse_wannier90_hr("test_w90_hr.dat"), triqs::runtime_error);
+  EXPECT_THROW(tight_binding_from_wannier90_hr(bl, "test_w90_hr.dat", "test_w90_hr.h5"), triqs::runtime_error);
+}
+
+TEST(tight_binding, dos_tetrahedron_flat_band_edges) {
+  // A dispersive band on the square lattice, between two flat bands at the edges of the spectrum
+  auto units           = nda::matrix<double>{{1., 0.}, {0., 1.}};
+  auto bl              = bravais_lattice(units, std::vector(3, nda::vector<double>{0., 0.}));
+  auto displ_vec       = std::vector<nda::vector<long>>{{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  auto hop             = nda::matrix<dcomplex>{{1.0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+  auto overlap_mat_vec = std::vector(displ_vec.size(), hop);
+  overlap_mat_vec[0]   = nda::matrix<dcomplex>{{0, 0, 0}, {0, -5.0, 0}, {0, 0, 5.0}};
+  auto tb              = tight_binding{bl, displ_vec, overlap_mat_vec};
+
+  auto [eps, rho] = dos_tetrahedron(tb, 8, 100);
+  double deps     = eps(1) - eps(0);
+  for (int o = 0; o < 3; ++o) EXPECT_NEAR(sum(rho(range::all, o)) * deps, 1.0, 1e-12);
+  EXPECT_NEAR(rho(0, 1) * deps, 1.0, 1e-12);
+  EXPECT_NEAR(rho(99, 2) * deps, 1.0, 1e-12);
+}
+
 MAKE_MAIN;
@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/arrays.hpp>
+#include <triqs/utility/callbacks.hpp>
+#include "./spin_fixture.hpp"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+//  ----------------- a slow measure of the spin correlations, from a snapshot of the configuration ------------
+struct correlation {
+  using snapshot_t = std::vector<int>;
+
+  config_t &config;
+  std::vector<double> &corr;
+  std::thread::id &accumulation_thread;
+  bool fail = false;
+
+  void accumulate_snapshot(snapshot_t const &s) {
+    if (fail) throw std::runtime_error("correlation: failure");
+    accumulation_thread = std::this_thread::get_id();
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    long n = s.size();
+    for (long d = 0; d < n; ++d)
+      for (long i = 0; i < n; ++i) corr[d] += s[i] * s[(i + d) % n];
+  }
+
+  void take_snapshot(snapshot_t &s, double) { s = config.spins; }
+
+  void accumulate(double sign) {
+    snapshot_t s;
+    take_snapshot(s, sign);
+    accumulate_snapshot(s);
+  }
+
+  void collect_results(mpi::communicator) {}
+};
+
+// A Monte-Carlo run on a chain of 8 spins, with the correlation and the record (without snapshot) measures
+struct spin_mc {
+  config_t config{0.3, 0.5, std::vector<int>(8, -1)};
+  std::vector<double> corr = std::vector<double>(8, 0);
+  std::vector<int> history;
+  std::thread::id corr_thread, record_thread;
+  triqs::mc_tools::mc_generic<double> mc{"mt19937", 2834, 0};
+
+  spin_mc(bool fail = false) {
+    mc.add_move(flip{config, mc.get_rng()}, "flip");
+    mc.add_measure(correlation{config, corr, corr_thread, fail}, "correlation");
+    mc.add_measure(record{config, history, &record_thread}, "record");
+  }
+};
+
+TEST(mc_generic, async_measure) {
+  auto sync = spin_mc{};
+  sync.mc.warmup_and_accumulate(10, 500, 5, triqs::utility::clock_callback(-1));
+
+  for (size_t buffer_size : {1, 4, 16}) {
+    auto async = spin_mc{};
+    async.mc.set_async_measures(true, buffer_size);
+    async.mc.warmup_and_accumulate(10, 500, 5, triqs::utility::clock_callback(-1));
+
+    // the results are complete when accumulate returns, and identical to the synchronous ones
+    EXPECT_EQ(async.corr, sync.corr);
+    EXPECT_EQ(async.history, sync.history);
+
+    // only the measure with a snapshot is accumulated on a worker thread
+    EXPECT_NE(async.corr_thread, std::this_thread::get_id());
+    EXPECT_EQ(async.record_thread, std::this_thread::get_id());
+  }
+}
+
+TEST(mc_generic, async_measure_switch_off) {
+  auto async = spin_mc{};
+  async.mc.set_async_measures(true);
+  async.mc.accumulate(100, 5, triqs::utility::clock_callback(-1));
+  async.mc.set_async_measures(false);
+  async.mc.accumulate(100, 5, triqs::utility::clock_callback(-1));
+  EXPECT_EQ(async.corr_thread, std::this_thread::get_id());
+
+  auto sync = spin_mc{};
+  sync.mc.accumulate(200, 5, triqs::utility::clock_callback(-1));
+  EXPECT_EQ(async.corr, sync.corr);
+}
+
+TEST(mc_generic, async_measure_exception) {
+  auto async = spin_mc{true};
+  async.mc.set_async_measures(true, 4);
+  EXPECT_ANY_THROW(async.mc.accumulate(100, 5, triqs::utility::clock_callback(-1)));
+}
+
+MAKE_MAIN;
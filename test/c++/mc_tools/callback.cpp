@@ -21,6 +21,8 @@
 #include <triqs/test_tools/gfs.hpp>
 
 #include <iostream>
+#include <chrono>
+#include <thread>
 #include <triqs/utility/callbacks.hpp>
 #include <triqs/mc_tools/mc_generic.hpp>
 
@@ -98,4 +100,34 @@ TEST(mc_generic, callback) {
   EXPECT_EQ(Z, double(n_cycles));
 }
 
+TEST(mc_generic, accumulate_for) {
+
+  mpi::communicator world;
+  triqs::mc_tools::mc_generic<double> SpinMC("", 374982 + world.rank() * 273894, 0);
+
+  config_t config{0.3, 0.5};
+  SpinMC.add_move(flip{config}, "flip move");
+  double Z = 0.0;
+  SpinMC.add_measure(compute_m{config, Z}, "magnetization measure");
+
+  // Make the odd ranks slower
+  if (world.rank() % 2 == 1) SpinMC.set_after_cycle_duty([] { std::this_thread::sleep_for(std::chrono::microseconds(200)); });
+
+  // All ranks stop at the common deadline, with the same status
+  int status = SpinMC.accumulate_for(0.2, 10, world);
+  EXPECT_EQ(status, 0);
+  for (auto s : mpi::all_gather(std::vector<int>{status}, world)) EXPECT_EQ(s, status);
+  SpinMC.collect_results(world);
+
+  // Every measure is accounted for, the number of measures differs between the ranks
+  auto n      = SpinMC.get_nmeasures();
+  auto n_min  = mpi::all_reduce(n, world, MPI_MIN);
+  auto n_max  = mpi::all_reduce(n, world, MPI_MAX);
+  auto n_mean = double(mpi::all_reduce(n, world)) / world.size();
+  EXPECT_EQ(Z, double(n));
+  EXPECT_GT(n_min, 0);
+  EXPECT_LE(n_min, n_mean);
+  EXPECT_LE(n_mean, n_max);
+}
+
 MAKE_MAIN;
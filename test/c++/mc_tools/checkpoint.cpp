@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/arrays.hpp>
+#include <triqs/utility/callbacks.hpp>
+#include "./spin_fixture.hpp"
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+// The flip of the spin model, raising SIGUSR1 at a given attempt
+struct flip_and_signal {
+  flip f;
+  long signal_at  = -1;
+  long n_attempts = 0;
+  double attempt() {
+    if (++n_attempts == signal_at) std::raise(SIGUSR1);
+    return f.attempt();
+  }
+  double accept() { return f.accept(); }
+  void reject() { f.reject(); }
+};
+
+// A Monte-Carlo run with the spin history recorded
+struct spin_mc {
+  config_t config{0.3, 0.5};
+  std::vector<int> history;
+  triqs::mc_tools::mc_generic<double> mc;
+
+  spin_mc(std::string const &random_name, long signal_at = -1) : mc(random_name, 2834, 0) {
+    mc.add_move(flip_and_signal{flip{config, mc.get_rng()}, signal_at}, "flip");
+    mc.add_measure(record{config, history}, "record");
+  }
+};
+
+TEST(mc_generic, checkpoint) {
+  for (std::string random_name : {"", "mt19937", "lagged_fibonacci607"}) {
+    int length_cycle = 7;
+
+    // Uninterrupted run
+    auto ref = spin_mc{random_name};
+    ref.mc.warmup_and_accumulate(50, 400, length_cycle, triqs::utility::clock_callback(-1));
+
+    // Run stopped after 150 cycles, with a checkpoint
+    auto first = spin_mc{random_name};
+    first.mc.warmup(50, length_cycle, triqs::utility::clock_callback(-1));
+    first.mc.accumulate(150, length_cycle, triqs::utility::clock_callback(-1));
+    {
+      h5::file file("mc_checkpoint.h5", 'w');
+      h5_write(file, "mc", first.mc);
+      h5_write(file, "spins", first.config.spins);
+    }
+
+    // Restart in a new mc_generic
+    auto second = spin_mc{random_name};
+    {
+      h5::file file("mc_checkpoint.h5", 'r');
+      h5_read(file, "mc", second.mc);
+      h5_read(file, "spins", second.config.spins);
+    }
+    EXPECT_EQ(second.mc.get_current_cycle_number(), 200);
+    EXPECT_EQ(second.mc.get_config_id(), 200 * length_cycle);
+    second.mc.accumulate(250, length_cycle, triqs::utility::clock_callback(-1));
+
+    // The restarted chain is the continuation of the first one
+    auto history = first.history;
+    history.insert(history.end(), second.history.begin(), second.history.end());
+    EXPECT_EQ(history, ref.history);
+    EXPECT_EQ(second.config.spins, ref.config.spins);
+  }
+}
+
+TEST(mc_generic, checkpoint_on_signal) {
+  int length_cycle = 7;
+
+  // Uninterrupted run
+  auto ref = spin_mc{"mt19937"};
+  ref.mc.warmup_and_accumulate(50, 400, length_cycle, triqs::utility::clock_callback(-1));
+
+  // A signal in the middle of the accumulation cycle 150: the cycle is completed, then checkpointed
+  auto first = spin_mc{"mt19937", (50 + 150) * length_cycle + 3};
+  first.mc.set_checkpoint([&] {
+    h5::file file("mc_checkpoint_signal.h5", 'w');
+    h5_write(file, "mc", first.mc);
+    h5_write(file, "spins", first.config.spins);
+  });
+  first.mc.warmup(50, length_cycle, triqs::utility::clock_callback(-1));
+  EXPECT_EQ(first.mc.accumulate(400, length_cycle, triqs::utility::clock_callback(-1)), 2);
+  EXPECT_EQ(first.history.size(), 151u);
+
+  // The restart continues the chain exactly
+  auto second = spin_mc{"mt19937"};
+  {
+    h5::file file("mc_checkpoint_signal.h5", 'r');
+    h5_read(file, "mc", second.mc);
+    h5_read(file, "spins", second.config.spins);
+  }
+  EXPECT_EQ(second.mc.get_current_cycle_number(), 201);
+  EXPECT_EQ(second.mc.get_config_id(), 201 * length_cycle);
+  second.mc.accumulate(249, length_cycle, triqs::utility::clock_callback(-1));
+
+  auto history = first.history;
+  history.insert(history.end(), second.history.begin(), second.history.end());
+  EXPECT_EQ(history, ref.history);
+  EXPECT_EQ(second.config.spins, ref.config.spins);
+}
+
+TEST(mc_generic, checkpoint_interval) {
+  auto smc          = spin_mc{"mt19937"};
+  int n_checkpoints = 0;
+  smc.mc.set_checkpoint([&] { ++n_checkpoints; }, 1e-4);
+  smc.mc.set_after_cycle_duty([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+  smc.mc.accumulate(100, 10, triqs::utility::clock_callback(-1));
+
+  // the interval is shorter than a cycle: one checkpoint after each cycle, except the last one
+  EXPECT_EQ(n_checkpoints, 99);
+}
+
+MAKE_MAIN;
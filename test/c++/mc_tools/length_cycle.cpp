@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/arrays.hpp>
+#include <triqs/utility/callbacks.hpp>
+#include "./spin_fixture.hpp"
+
+TEST(mc_generic, length_cycle_tuning) {
+  double q     = 0.01;
+  double tau   = (1 - 2 * q) / (2 * q); // 49
+  auto config  = config_t{0., 0., {1}};
+  auto history = std::vector<int>{};
+
+  triqs::mc_tools::mc_generic<double> mc("mt19937", 4321, 0);
+  mc.add_move(sticky_flip{config, q}, "flip");
+  mc.add_measure(record{config, history}, "record");
+  mc.set_length_cycle_tuning([&] { return double(config.spins[0]); }, 0.5);
+
+  mc.warmup_and_accumulate(40000, 100, 10, triqs::utility::clock_callback(-1));
+
+  auto const &e = mc.get_length_cycle_estimate();
+  EXPECT_EQ(e.n_samples, 200000);
+  EXPECT_TRUE(e.converged);
+  EXPECT_NEAR(e.tau, tau, 0.4 * tau);
+  EXPECT_EQ(e.length_cycle, std::llround(0.5 * e.tau));
+  EXPECT_EQ(e.log_bin_errors.size(), e.log_bin_counts.size());
+  EXPECT_GE(e.log_bin_counts[e.binning_level], triqs::mc_tools::length_cycle_tuner::min_bins);
+
+  // The accumulation uses the chosen length of the cycle
+  EXPECT_EQ(history.size(), 100u);
+  EXPECT_EQ(mc.get_config_id(), 40000 * 10 + 100 * e.length_cycle);
+
+  // The estimate is in the performance report
+  EXPECT_NE(mc.get_performance_report().find("length_cycle_estimate"), std::string::npos);
+}
+
+TEST(mc_generic, length_cycle_tuning_bounds) {
+  auto config = config_t{0., 0., {1}};
+  triqs::mc_tools::mc_generic<double> mc("mt19937", 4321, 0);
+  mc.add_move(sticky_flip{config, 0.01}, "flip");
+
+  // the bounds are enforced
+  mc.set_length_cycle_tuning([&] { return double(config.spins[0]); }, 1.0, 1, 10);
+  mc.warmup(10000, 10, triqs::utility::clock_callback(-1));
+  EXPECT_EQ(mc.get_length_cycle_estimate().length_cycle, 10);
+
+  // an observable without fluctuation keeps the length of the cycle
+  mc.set_length_cycle_tuning([] { return 1.0; });
+  mc.warmup(1000, 7, triqs::utility::clock_callback(-1));
+  EXPECT_EQ(mc.get_length_cycle_estimate().length_cycle, 7);
+  EXPECT_EQ(mc.get_length_cycle_estimate().binning_level, -1);
+  EXPECT_FALSE(mc.get_length_cycle_estimate().converged);
+
+  EXPECT_THROW(mc.set_length_cycle_tuning([] { return 1.0; }, -1.0), triqs::runtime_error);
+}
+
+MAKE_MAIN;
@@ -0,0 +1,45 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/arrays.hpp>
+#include <triqs/utility/callbacks.hpp>
+#include "./spin_fixture.hpp"
+
+TEST(mc_generic, length_cycle_tuning_mpi) {
+  mpi::communicator world;
+
+  // The ranks differ in their autocorrelation time and in their number of samples
+  auto config = config_t{0., 0., {1}};
+  triqs::mc_tools::mc_generic<double> mc("mt19937", 4321 + world.rank(), 0);
+  mc.add_move(sticky_flip{config, 0.01 * (1 + world.rank())}, "flip");
+  mc.set_length_cycle_tuning([&] { return double(config.spins[0]); }, 0.5);
+  mc.warmup(20000 * (1 + world.rank()), 10, triqs::utility::clock_callback(-1), world);
+
+  // All ranks get the same estimate
+  auto const &e = mc.get_length_cycle_estimate();
+  EXPECT_GT(e.length_cycle, 0);
+  auto length_cycles = mpi::all_gather(std::vector<long>{long(e.length_cycle)}, world);
+  auto n_samples     = mpi::all_gather(std::vector<long>{long(e.n_samples)}, world);
+  auto levels        = mpi::all_gather(std::vector<long>{long(e.binning_level)}, world);
+  for (int r = 0; r < world.size(); ++r) {
+    EXPECT_EQ(length_cycles[r], e.length_cycle);
+    EXPECT_EQ(n_samples[r], e.n_samples);
+    EXPECT_EQ(levels[r], e.binning_level);
+  }
+}
+
+MAKE_MAIN;
@@ -21,6 +21,7 @@
 #include <random>
 #include <vector>
 #include <triqs/mc_tools/MersenneRNG.hpp>
+#include <triqs/mc_tools/random_generator.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/lagged_fibonacci.hpp>
@@ -59,6 +60,20 @@ TEST(Random, Mersenne) {
   for (int i = 0; i < 100; ++i) EXPECT_EQ(result[i], gb());
 }
 
+// A generator read from HDF5 continues the sequence of the generator written, for all engines
+TEST(Random, Checkpoint) {
+  auto names = triqs::mc_tools::random_generator_names_list();
+  names.push_back("");
+  for (auto const &name : names) {
+    auto rng = triqs::mc_tools::random_generator{name, 2341};
+    for (int i = 0; i < 1500; ++i) rng(); // refill the buffer once
+
+    auto rng_r = rw_h5(rng, "rng_checkpoint", name.empty() ? "RandMT" : name);
+    EXPECT_EQ(rng_r.name(), name);
+    for (int i = 0; i < 5000; ++i) EXPECT_EQ(rng(), rng_r());
+  }
+}
+
 #ifdef RANDOM_TEST_UNIFORM
 TEST(Random, MersenneUniform) {
 
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+// The model of the mc_generic tests: uncoupled spins in an external field
+
+#pragma once
+#include <triqs/mc_tools/mc_generic.hpp>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// --------------- the configuration: spins in an external field ---
+struct config_t {
+  double beta, h;
+  std::vector<int> spins = std::vector<int>(1, -1);
+};
+
+// --------------- a move: flip one spin, chosen at random ---------------
+struct flip {
+  config_t &config;
+  triqs::mc_tools::random_generator &rng;
+  int i = 0;
+  double attempt() {
+    i = rng(int(config.spins.size()));
+    return std::exp(-2 * config.spins[i] * config.h * config.beta);
+  }
+  double accept() {
+    config.spins[i] *= -1;
+    return 1.0;
+  }
+  void reject() {}
+};
+
+// --------------- a move: flip the first spin with probability q, independently of the field ---------------
+// The spin is a two-state Markov chain with correlation (1 - 2q)^t after t moves,
+// hence an integrated autocorrelation time tau = (1 - 2q) / (2q).
+struct sticky_flip {
+  config_t &config;
+  double q;
+  double attempt() { return q; }
+  double accept() {
+    config.spins[0] *= -1;
+    return 1.0;
+  }
+  void reject() {}
+};
+
+//  ----------------- a measurement: the history of the first spin, and the thread which accumulates it ------------
+struct record {
+  config_t &config;
+  std::vector<int> &history;
+  std::thread::id *accumulation_thread = nullptr;
+  void accumulate(double) {
+    if (accumulation_thread) *accumulation_thread = std::this_thread::get_id();
+    history.push_back(config.spins[0]);
+  }
+  void collect_results(mpi::communicator) {}
+};
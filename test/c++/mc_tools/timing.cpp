@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#define TRIQS_MCTOOLS_TIMING
+
+#include <triqs/test_tools/arrays.hpp>
+#include <triqs/utility/callbacks.hpp>
+#include "./spin_fixture.hpp"
+#include <numeric>
+
+using triqs::mc_tools::call_timing;
+
+// --------------- a move doing nothing ---------------
+struct stay {
+  double attempt() { return 1.0; }
+  double accept() { return 1.0; }
+  void reject() {}
+};
+
+//  ----------------- a measurement: the magnetization ------------
+struct compute_m {
+  config_t &config;
+  double M = 0;
+  void accumulate(double sign) { M += sign * config.spins[0]; }
+  void collect_results(mpi::communicator) {}
+};
+
+TEST(mc_generic, call_timing) {
+  auto t     = call_timing{};
+  uint64_t n = 1000;
+  for (uint64_t i = 0; i < n; ++i) EXPECT_EQ(t([i] { return 2 * i; }), 2 * i);
+
+  EXPECT_EQ(t.n_calls(), n);
+  EXPECT_EQ(t.n_sampled(), (n + call_timing::sample_period - 1) / call_timing::sample_period);
+  auto const &hist = t.latency_histogram();
+  EXPECT_EQ(std::accumulate(hist.begin(), hist.end(), uint64_t{0}), t.n_sampled());
+  EXPECT_NEAR(t.estimated_time(), t.sampled_time() * n / t.n_sampled(), 1e-15);
+
+  t.clear();
+  EXPECT_EQ(t.n_calls(), 0u);
+  EXPECT_EQ(t.estimated_time(), 0.0);
+}
+
+TEST(mc_generic, move_timing) {
+  mpi::communicator world;
+  config_t config{0.3, 0.5};
+  triqs::mc_tools::mc_generic<double> mc("mt19937", 2834, 0);
+  mc.add_move(flip{config, mc.get_rng()}, "flip");
+  mc.add_move(stay{}, "stay", 0.5);
+  mc.add_measure(compute_m{config}, "magnetization");
+  mc.warmup_and_accumulate(10, 1000, 20, triqs::utility::clock_callback(-1));
+  mc.collect_results(world);
+
+  // the performance report has an entry per move and measure, with the sampled timing of the calls
+  auto report = mc.get_performance_report();
+  for (auto key : {R"("timing_enabled": true)", R"("flip": {"n_proposed": )", R"("stay": )", R"("magnetization": {"count": 1000)", R"("attempt": {)",
+                   R"("stop_callback": {"n_calls": 1000)", R"("signal_check": {"n_calls": 20000)"})
+    EXPECT_NE(report.find(key), std::string::npos) << key;
+
+  // write the report to HDF5
+  h5::file file("mc_timing.h5", 'w');
+  mc.write_performance_report(file, "performance");
+  auto gr = h5::group(file).open_group("performance");
+  EXPECT_EQ(h5::read<long>(gr.open_group("moves").open_group("flip").open_group("attempt"), "n_calls")
+               + h5::read<long>(gr.open_group("moves").open_group("stay").open_group("attempt"), "n_calls"),
+            20000);
+}
+
+MAKE_MAIN;
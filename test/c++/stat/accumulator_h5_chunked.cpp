@@ -0,0 +1,52 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/stat/accumulator.hpp>
+#include <triqs/test_tools/arrays.hpp>
+
+using namespace triqs::stat;
+using dcomplex = std::complex<double>;
+using namespace std::complex_literals;
+
+TEST(accumulator, h5_chunked) {
+  auto acc_a = accumulator<nda::array<dcomplex, 2>>{nda::zeros<dcomplex>(3, 2), 2, 100, 1};
+  auto acc_d = accumulator<double>{0.0, 2, 100, 1};
+  for (int i = 0; i < 20; ++i) {
+    acc_a << nda::array<dcomplex, 2>{{{1.0 * i, 2.0}, {1i * i, 0}, {-1.0, 0.5 * i}}};
+    acc_d << 0.25 * i;
+  }
+  {
+    h5::file file("accumulator_h5_chunked.h5", 'w');
+    h5_write_chunked(file, "acc_a", acc_a, {.chunk_shape = {8}});
+    h5_write_chunked(file, "acc_d", acc_d);
+  }
+
+  // Read back by the standard h5_read
+  h5::file file("accumulator_h5_chunked.h5", 'r');
+  auto acc_a2 = accumulator<nda::array<dcomplex, 2>>{};
+  auto acc_d2 = accumulator<double>{};
+  h5_read(file, "acc_a", acc_a2);
+  h5_read(file, "acc_d", acc_d2);
+
+  EXPECT_EQ(acc_a2.n_lin_bins(), 20);
+  for (long i = 0; i < 20; ++i) EXPECT_ARRAY_NEAR(acc_a2.linear_bins()[i], acc_a.linear_bins()[i], 1e-15);
+  EXPECT_EQ(acc_a2.n_log_bins(), acc_a.n_log_bins());
+  EXPECT_EQ(acc_a2.log_bin_errors().second, acc_a.log_bin_errors().second);
+  EXPECT_EQ(acc_d2.linear_bins(), acc_d.linear_bins());
+}
+
+MAKE_MAIN;
@@ -158,6 +158,49 @@ TEST(histogram, cdf) {
   EXPECT_ARRAY_NEAR(true_cdf_hi1, cdf_hi1.data());
 }
 
+TEST(histogram, insert) {
+
+  // batched insertion gives the same histograms as operator<<
+  std::vector<double> data{-10, -0.05, 1.1, 2.0, 2.2, 2.9, 3.4, 5, 9, 10.0, 10.5, 12.1, 32.2};
+  histogram hd1{0, 10, 21};
+  hd1.insert(data);
+  EXPECT_EQ(make_hd1(), hd1);
+
+  std::vector<long> orders{-1, 0, 0, 0, 1, 2, 2, 2, 3, 5, 9, 32};
+  histogram hi1{0, 10};
+  hi1.insert(orders);
+  EXPECT_EQ(make_hi1(), hi1);
+
+  // integer values into non-unit bins
+  histogram hd2{0, 10, 21}, hd2_ref{0, 10, 21};
+  hd2.insert(orders);
+  for (auto n : orders) hd2_ref << n;
+  EXPECT_EQ(hd2_ref, hd2);
+}
+
+TEST(histogram, insert_parallel) {
+
+  // more values than one chunk per thread
+  long N = 1000000;
+  std::vector<double> xs(N);
+  std::vector<long> ns(N);
+  for (long i = 0; i < N; ++i) {
+    xs[i] = -1.0 + 0.125 * ((i * 7919) % 97); // exact in binary, on and between the bin edges
+    ns[i] = (i * 7919) % 13 - 1;
+  }
+
+  histogram hd{0, 10, 41}, hd_ref{0, 10, 41};
+  hd.insert(xs, true);
+  for (auto x : xs) hd_ref << x;
+  EXPECT_EQ(hd_ref, hd);
+
+  histogram hi{0, 10}, hi_ref{0, 10};
+  hi.insert(ns, true);
+  hi_ref.insert(ns);
+  EXPECT_EQ(hi_ref, hi);
+  EXPECT_EQ(N, hi.n_data_pts() + hi.n_lost_pts());
+}
+
 // ------------------------
 
 MAKE_MAIN;
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Simons Foundation
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You may obtain a copy of the License at
+//     https://www.gnu.org/licenses/gpl-3.0.txt
+//
+// Authors: Shasta Ramachandran
+
+#include <triqs/test_tools/arrays.hpp>
+#include <triqs/utility/bounded_cache.hpp>
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using triqs::utility::bounded_cache;
+
+TEST(bounded_cache, get_and_evict) {
+  auto cache  = bounded_cache<int, std::string>{2};
+  int n_built = 0;
+  auto make   = [&](int i) {
+    return [&n_built, i] {
+      ++n_built;
+      return std::to_string(i);
+    };
+  };
+
+  auto a = cache.get(1, make(1));
+  EXPECT_EQ(*a, "1");
+  EXPECT_EQ(cache.get(1, make(1)), a);
+  EXPECT_EQ(n_built, 1);
+  cache.get(2, make(2));
+  EXPECT_EQ(cache.info().size, 2);
+
+  // Full: the cache is emptied before the new value is added, the values handed out stay alive
+  cache.get(3, make(3));
+  EXPECT_EQ(cache.info().size, 1);
+  EXPECT_EQ(cache.find(1), nullptr);
+  EXPECT_EQ(*a, "1");
+
+  auto info = cache.info();
+  EXPECT_EQ(info.hits, 1);
+  EXPECT_EQ(info.misses, 4);
+
+  cache.clear();
+  EXPECT_EQ(cache.info().size, 0);
+  EXPECT_EQ(cache.info().misses, 0);
+}
+
+TEST(bounded_cache, failed_make) {
+  auto cache = bounded_cache<int, double>{4};
+  EXPECT_THROW(cache.get(0, []() -> double { throw std::runtime_error("failed"); }), std::runtime_error);
+  EXPECT_EQ(cache.find(0), nullptr);
+
+  // A shared value can be handed in directly
+  auto v = std::make_shared<double const>(2.5);
+  EXPECT_EQ(cache.get(0, [&] { return v; }), v);
+}
+
+TEST(bounded_cache, concurrent_keys) {
+  auto cache = bounded_cache<int, int>{4};
+
+  // The build of the key 1 waits for the build of the key 2, which requires them to run concurrently
+  auto built_2 = std::promise<void>{};
+  auto make_1  = [&] {
+    built_2.get_future().wait();
+    return 1;
+  };
+  auto make_2 = [&] {
+    built_2.set_value();
+    return 2;
+  };
+  auto t = std::thread{[&] { EXPECT_EQ(*cache.get(1, make_1), 1); }};
+  EXPECT_EQ(*cache.get(2, make_2), 2);
+  t.join();
+  EXPECT_EQ(*cache.find(1), 1);
+  EXPECT_EQ(cache.info().misses, 2);
+}
+
+MAKE_MAIN;
@@ -90,3 +90,16 @@ for i, (block, delta_disc) in zip(range(len(list(delta_disc_tau.indices))), delt
     assert np.max(np.abs(hoppings[i]) - np.abs(V_opt[i])) < 1e-8, 'did not achieved requiered accuracy for bath fit \n'+str(V_opt)+' vs \n'+str(hoppings)
     assert np.max(np.abs(energies[i] - e_opt[i])) < 1e-8, 'did not achieved requiered accuracy for bath fit \n'+str(e_opt)+' vs \n'+str(energies)
     assert_gfs_are_close(delta_disc, delta_tau[block])
+
+#################################################
+# test bounds on the bath energies and multiple starts
+mesh = MeshImFreq(beta=40, S='Fermion', n_iw=200)
+delta_iw = make_delta(V=np.array([[0.2, 0.6]]), eps=np.array([0.0, 0.5]), mesh=mesh)
+
+V_opt, e_opt, delta_disc_iw = discretize_bath(delta_in=delta_iw, Nb=2, eps0=2.5, tol=1e-10, eps_bounds=(-0.2, 0.3))
+assert np.all(e_opt >= -0.2) and np.all(e_opt <= 0.3), 'bath energies out of bounds: '+str(e_opt)
+assert np.isclose(e_opt[-1], 0.3), 'the upper bound should be active: '+str(e_opt)
+
+V_opt, e_opt, delta_disc_iw = discretize_bath(delta_in=delta_iw, Nb=2, eps0=2.5, tol=1e-10, n_starts=8, seed=3)
+assert np.max(np.abs(np.array([0.0, 0.5]) - e_opt)) < 1e-6, 'multi-start fit failed: '+str(e_opt)
+assert_gfs_are_close(delta_disc_iw, delta_iw)
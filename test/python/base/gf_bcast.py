@@ -65,3 +65,21 @@ gw2 = GfImFreq(indices = [1], beta = 50)
 gw2 << Fourier(gt2)
 
 
+
+# Reductions of Green functions and arrays
+import numpy as np
+G2 = mpi.all_reduce(G)
+for (n, g), (n2, g2) in zip(G, G2): assert np.allclose(g2.data, mpi.size * g.data)
+a = mpi.reduce(np.arange(4.))
+if mpi.is_master_node(): assert np.allclose(a, mpi.size * np.arange(4.))
+
+# Arrays which are not numeric are pickled
+o = np.array([{'a': 1}, 'b', 2], dtype=object)
+o2 = mpi.bcast(o)
+assert o2.dtype == object and list(o2) == list(o)
+o = np.array([1, 2, 3], dtype=object)
+assert list(mpi.all_reduce(o)) == [mpi.size * x for x in (1, 2, 3)]
+o3 = mpi.reduce(o)
+if mpi.is_master_node(): assert list(o3) == [mpi.size * x for x in (1, 2, 3)]
+s = mpi.bcast(np.array(['x', 'yz']))
+assert list(s) == ['x', 'yz']
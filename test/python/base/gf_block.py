@@ -128,5 +128,32 @@ class test_Gf_Block(unittest.TestCase):
 
         assert_block2_gfs_are_close(B3, B4)
 
+    def test_block_parallel(self):
+
+        blocks = []
+        for b in range(6):
+            g = Gf(mesh=MeshImFreq(beta=10.0, S="Fermion", n_iw=100), target_shape=(2,2))
+            g << inverse(iOmega_n - 0.2 * b)
+            blocks.append(g)
+        B = BlockGf(name_list=[str(b) for b in range(6)], block_list=blocks)
+
+        def run(parallel):
+            old = set_block_parallel(parallel)
+            res = make_gf_from_fourier(B), B.total_density()
+            set_block_parallel(old)
+            return res
+
+        B_tau, n = run(False)
+        B_tau_p, n_p = run(True)
+        assert_block_gfs_are_close(B_tau, B_tau_p, 1e-15)
+        assert n == n_p
+
+        # The inversion of the blocks
+        old = set_block_parallel(True)
+        B_inv = B.inverse()
+        set_block_parallel(old)
+        for (n, g), (n_inv, g_inv) in zip(B, B_inv):
+            assert_gfs_are_close(g_inv, g.inverse(), 1e-15)
+
 if __name__ == '__main__':
     unittest.main()
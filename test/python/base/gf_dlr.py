@@ -250,6 +250,32 @@ class test_dlr_mesh(unittest.TestCase):
         ref_mat = np.eye(2) * ref
         assert( np.allclose(g_dlr_iw.tau_L2_norm(), ref_mat) )
 
+    def test_dlr_product_mesh(self):
+
+        from triqs.gf import MeshProduct
+        from triqs.gf.meshes import MeshBrZone
+        from triqs.lattice import BravaisLattice, BrillouinZone
+
+        beta, eps, w_max = 2.0, 1e-10, 10.0
+        k_mesh = MeshBrZone(BrillouinZone(BravaisLattice(np.eye(2))), 4)
+        mesh = MeshProduct(MeshDLRImTime(beta, 'Fermion', w_max, eps), k_mesh)
+
+        g_tau = Gf(mesh=mesh, target_shape=[])
+        for t, k in mesh:
+            e_k = -2 * (np.cos(k.value[0]) + np.cos(k.value[1]))
+            g_tau[t, k] = onefermion(t.value, e_k, beta)
+
+        # Repeated conversions of the product mesh
+        g_dlr = make_gf_dlr(g_tau)
+        for i in range(3):
+            assert_gfs_are_close(make_gf_dlr_imtime(g_dlr), g_tau)
+            assert_gfs_are_close(make_gf_dlr(g_tau), g_dlr)
+
+        # A product mesh of other component meshes
+        g_tau2 = Gf(mesh=MeshProduct(MeshDLRImTime(beta, 'Fermion', w_max, eps), MeshBrZone(k_mesh.bz, 2)), target_shape=[])
+        g_dlr2 = make_gf_dlr(g_tau2)
+        assert g_dlr2.mesh[1] == g_tau2.mesh[1] and g_dlr2.mesh[1] != k_mesh
+
 
 if __name__ == '__main__':
     unittest.main()
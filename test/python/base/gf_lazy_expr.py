@@ -0,0 +1,69 @@
+# Copyright (c) 2026 Simons Foundation
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You may obtain a copy of the License at
+#     https:#www.gnu.org/licenses/gpl-3.0.txt
+#
+# Authors: Shasta Ramachandran
+
+from triqs.gf import *
+from triqs.gf.descriptors import *
+from triqs.gf.tools import inverse, conjugate, transpose
+
+import numpy as np
+import unittest
+
+class test_lazy_expr(unittest.TestCase):
+
+    def setUp(self):
+        self.mesh = MeshImFreq(beta=10, S='Fermion', n_iw=100)
+        self.iw = np.array([complex(w) for w in self.mesh])
+        rng = np.random.default_rng(1)
+        self.eps = np.array([[0.5, 0.2], [0.2, -0.3]])
+        self.S = Gf(mesh=self.mesh, target_shape=[2, 2])
+        self.S.data[:] = rng.random((len(self.mesh), 2, 2)) + 1j * rng.random((len(self.mesh), 2, 2))
+
+    def test_dyson(self):
+        mu, Id = 0.3, np.identity(2)
+        G = Gf(mesh=self.mesh, target_shape=[2, 2])
+        G << inverse(iOmega_n + mu - self.eps - self.S)
+        ref = np.linalg.inv(self.iw[:, None, None] * Id + mu * Id - self.eps - self.S.data)
+        np.testing.assert_allclose(G.data, ref, atol=1e-12)
+
+    def test_products(self):
+        G = Gf(mesh=self.mesh, target_shape=[2, 2])
+        G << 2 * inverse(iOmega_n - self.S) * self.S - transpose(iOmega_n * self.S) / 4 + conjugate(iOmega_n + self.S) * self.eps
+        W, S = self.iw[:, None, None] * np.identity(2), self.S.data
+        ref = 2 * np.linalg.inv(W - S) @ S - np.transpose(W @ S, (0, 2, 1)) / 4 + np.conj(W + S) @ self.eps
+        np.testing.assert_allclose(G.data, ref, atol=1e-12)
+
+    def test_aliasing(self):
+        W, S = self.iw[:, None, None] * np.identity(2), self.S.data.copy()
+        self.S << inverse(iOmega_n - self.S) * self.S
+        np.testing.assert_allclose(self.S.data, np.linalg.inv(W - S) @ S, atol=1e-12)
+
+    def test_scalar(self):
+        g = Gf(mesh=self.mesh, target_shape=[])
+        g << 1 / (iOmega_n - 0.5) + SemiCircular(1.0) / 2
+        s = Gf(mesh=self.mesh, target_shape=[])
+        s << SemiCircular(1.0)
+        np.testing.assert_allclose(g.data, 1 / (self.iw - 0.5) + s.data / 2, atol=1e-12)
+
+    def test_fallback(self):
+        # Elementwise division by a matrix is not fused
+        G = Gf(mesh=self.mesh, target_shape=[2, 2])
+        M = np.array([[1., 2.], [4., 8.]])
+        G << (iOmega_n + self.S) / M
+        np.testing.assert_allclose(G.data, (self.iw[:, None, None] * np.identity(2) + self.S.data) / M, atol=1e-12)
+
+if __name__ == '__main__':
+    unittest.main()
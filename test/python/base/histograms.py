@@ -91,6 +91,15 @@ with HDFArchive("histograms.h5",'r') as arch:
     assert(arch["hi1"] == hi1)
     assert(arch["hd1"] == hd1)
 
+# Test batched insertion
+hd1_batch = Histogram(0, 10, 21)
+hd1_batch.insert(np.array([-10, -0.05, 1.1, 2.0, 2.2, 2.9, 3.4, 5, 9, 10.0, 10.5, 12.1, 32.2]))
+assert hd1_batch == hd1
+
+hi1_batch = Histogram(0, 10)
+hi1_batch.insert(np.array([-1, 0, 0, 0, 1, 2, 2, 2, 3, 5, 9, 32]), parallel = True)
+assert hi1_batch == hi1
+
 # Test PDF
 pdf_hi1 = pdf(hi1)
 assert_arrays_are_close(pdf_hi1.data, np.array([.3, .1, .3, .1, .0, .1, .0, .0, .0, .1, .0]))
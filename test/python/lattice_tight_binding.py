@@ -71,6 +71,45 @@ class test_lattice_tight_binding(unittest.TestCase):
 
         self.assertEqual(tbl, tbl_read)
     
+    def test_lattice_gf(self):
+        from triqs.gf import Gf, MeshImFreq, iOmega_n, inverse
+        from triqs.lattice.lattice_tools import make_lattice_gf, make_lattice_gf_local, lattice_density
+
+        tbl = TBLattice(units=self.units, hoppings=self.hoppings,
+                        orbital_positions=self.orbital_positions,
+                        orbital_names=self.orbital_names
+                        )
+        k_mesh = tbl.get_kmesh(6)
+        mu = 0.5
+        sigma = Gf(mesh=MeshImFreq(beta=10, S='Fermion', n_iw=64), target_shape=[2, 2])
+        sigma << 0.3 * inverse(iOmega_n - 0.2)
+
+        # G(k, iw) against numpy, and its reductions
+        g = make_lattice_gf(tbl.tb, k_mesh, mu, sigma)
+        iw = np.array([complex(w) for w in sigma.mesh])
+        h_k = tbl.fourier(k_mesh).data
+        g_ref = np.linalg.inv((iw[None, :, None, None] + mu) * np.eye(2) - h_k[:, None] - sigma.data[None])
+        self.assertTrue(np.allclose(g.data, g_ref))
+        self.assertTrue(np.allclose(make_lattice_gf_local(tbl.tb, k_mesh, mu, sigma).data, g_ref.mean(axis=0)))
+        self.assertEqual(lattice_density(tbl.tb, k_mesh, mu, sigma).data.shape, h_k.shape)
+
+    def test_irreducible_kgrid(self):
+        from triqs.gf import MeshBrZone
+        from triqs.lattice.lattice_tools import IrreducibleKGrid
+
+        # Nearest-neighbour hopping on the square lattice, with the 8 operations of its point group
+        bl = BravaisLattice(units=[(1, 0), (0, 1)])
+        tb = TightBinding(bl, {(1, 0): [[-1.]], (-1, 0): [[-1.]], (0, 1): [[-1.]], (0, -1): [[-1.]]})
+        k_mesh = MeshBrZone(BrillouinZone(bl), n_k=8)
+        grid = IrreducibleKGrid(k_mesh, tb)
+        self.assertEqual(grid.size, 15)
+        self.assertAlmostEqual(np.sum(grid.weights), 1.0)
+
+        eps = tb.dispersion(grid)
+        self.assertTrue(np.allclose(eps.data, tb.dispersion(k_mesh).data))
+        eps_irr, U_irr = tb.eigenelements(grid.kvecs)
+        self.assertTrue(np.allclose(eps_irr[grid.irr_index], eps.data))
+
     def test_TB_to_sympy_2D(self):
         try:
             import sympy as sp
@@ -92,6 +92,35 @@ class test_utils(unittest.TestCase):
         H_k = tbl_w90.fourier(tbl_w90.get_kmesh(11))
         self.assertTrue(H_k.data.shape == (1331, 3, 3))
 
+    def test_TB_from_w90_cache(self):
+
+        import os, shutil
+        from triqs.lattice.utils import parse_hopping_from_wannier90_hr_dat
+
+        # Same hoppings as the reshaped np.loadtxt of the data lines
+        hopp_dict, num_wann = parse_hopping_from_wannier90_hr_dat('wannier_TB_test_hr.dat')
+        dat = np.loadtxt('wannier_TB_test_hr.dat', skiprows=3 + int(np.ceil(125 / 15.))).reshape(125, 3, 3, 7)
+        self.assertEqual(num_wann, 3)
+        self.assertEqual(list(hopp_dict.keys()), [tuple(R) for R in dat[:, 0, 0, 0:3].astype(int)])
+        self.assertTrue(np.array_equal(np.array(list(hopp_dict.values())), dat[..., 5] + 1.j * dat[..., 6]))
+
+        # The cache is written, then read, and rewritten when the hr file changes
+        shutil.copy('wannier_TB_test_hr.dat', 'cache_TB_test_hr.dat')
+        shutil.copy('wannier_TB_test.wout', 'cache_TB_test.wout')
+        if os.path.exists('cache_TB_test.h5'): os.remove('cache_TB_test.h5')
+        tbl_w90 = TB_from_wannier90(seed='wannier_TB_test', path='./')
+        tbl_1 = TB_from_wannier90(seed='cache_TB_test', path='./', cache='cache_TB_test.h5')
+        self.assertTrue(os.path.exists('cache_TB_test.h5'))
+        tbl_2 = TB_from_wannier90(seed='cache_TB_test', path='./', cache='cache_TB_test.h5')
+        self.assertEqual(tbl_1, tbl_w90)
+        self.assertEqual(tbl_2, tbl_w90)
+
+        with open('cache_TB_test_hr.dat', 'r') as fd: hr = fd.read()
+        with open('cache_TB_test_hr.dat', 'w') as fd: fd.write(hr.replace('-0.256015', '-0.5120300'))
+        tbl_3 = TB_from_wannier90(seed='cache_TB_test', path='./', cache='cache_TB_test.h5', extend_to_spin=True)
+        self.assertEqual(tbl_3.hoppings[(1, 0, 0)][3, 3], -0.51203)
+        self.assertEqual(tbl_3.n_orbitals, 6)
+
     def test_TB_from_pythTB(self):
 
         try: